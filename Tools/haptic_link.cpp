@@ -0,0 +1,769 @@
+/******************************************************************************
+ * 文件名   : haptic_link.cpp
+ * 描述     : 主机端链路工具：按 User/haptic_host.h 的协议打包批量命令，
+ *            COBS + CRC16 成帧发送，停等应答；统计往返时间与吞吐。
+ *            帧之外的字节是设备 trace 记录，这里丢弃，需要日志时改用 trace_decode。
+ * 编译     : g++ -std=c++17 -O2 -o haptic_link Tools/haptic_link.cpp
+ * 用法     : haptic_link [--port /dev/ttyUSB0] [--baud 460800] cmd [args...]
+ *            fire <effect>          播放一个 LRA 库效果
+ *            seq <lib> <e1> [...]   预写序列后 GO
+ *            profile <id>           切换配置档
+ *            rtp <file.csv>         每行一个 RTP 值，按块发送
+ *            stats                  读取设备统计
+ *            bench <frames>         批量 STATS 帧，测往返与吞吐
+ *            stream <file.csv> [hz] [prebuffer]
+ *                                   信用流控连续流式播放（默认 1000Hz、32 样本），
+ *                                   报告端到端延迟与欠载/迟到/拒收计数
+ *            shell                  交互调校：寄存器读写、调校参数读写与保存、
+ *                                   触发效果、切换配置档、读取统计（输入 help 查看）
+ *            bank <image.bin>       上传 pattern_pack --bank 生成的图案库（写入非活动槽，
+ *                                   校验通过后切换；无需重新烧录固件）
+ *            bank-info              活动槽、图案数、映像大小、提交序号
+ *            bank-play <n>          播放图案库中第 n 个图案
+ ******************************************************************************/
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+const uint8_t kOpFire = 0x01;
+const uint8_t kOpSequence = 0x02;
+const uint8_t kOpGo = 0x03;
+const uint8_t kOpRtp = 0x04;
+const uint8_t kOpProfile = 0x05;
+const uint8_t kOpStats = 0x06;
+const uint8_t kOpStream = 0x07;
+const uint8_t kOpStreamStop = 0x08;
+const uint8_t kOpRegRead = 0x09;
+const uint8_t kOpRegWrite = 0x0A;
+const uint8_t kOpTuneSet = 0x0B;
+const uint8_t kOpTuneGet = 0x0C;
+const uint8_t kOpTuneSave = 0x0D;
+const uint8_t kOpBankBegin = 0x0E;
+const uint8_t kOpBankData = 0x0F;
+const uint8_t kOpBankCommit = 0x10;
+const uint8_t kOpBankPlay = 0x11;
+const uint8_t kOpBankInfo = 0x12;
+const uint8_t kReply = 0x80;
+const uint8_t kCredit = 0x81;
+const uint16_t kDeviceFifo = 128;   // HAPTIC_HOST_RTP_FIFO
+const size_t kMaxPayload = 60;      // HAPTIC_LINK_MAX_PAYLOAD
+const size_t kRtpChunk = 48;        // 单帧 RTP 样本数（seq + op + len + 48 <= 60）
+const size_t kReplyData = 24;       // HAPTIC_HOST_REPLY_DATA
+const size_t kRegBurst = 16;        // HAPTIC_HOST_REG_BURST
+const size_t kBankChunk = 48;       // 单帧图案库数据（seq + op + len + offset + 48 <= 60）
+const size_t kBankImageMax = 448;   // HAPTIC_BANK_IMAGE_MAX
+const int kReplyTimeoutMs = 500;
+
+using Clock = std::chrono::steady_clock;
+
+// HapticTune_Field 顺序
+const char *const kTuneNames[] = {
+    "drive", "strength", "overdrive", "sustainp", "sustainn", "brake", "burst", "pause"
+};
+const size_t kTuneCount = sizeof(kTuneNames) / sizeof(kTuneNames[0]);
+
+struct Options {
+    std::string port = "/dev/ttyUSB0";
+    int baud = 460800;
+    std::vector<std::string> args;
+};
+
+struct Credit {
+    bool valid = false;
+    uint16_t edge = 0;       // 已消费样本 + 设备缓冲容量（模 65536）
+    uint16_t underruns = 0;
+    uint16_t late = 0;
+};
+
+struct Reply {
+    uint8_t seq = 0;
+    uint8_t ok = 0;
+    uint8_t failedOp = 0;
+    std::vector<uint8_t> data;
+};
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: haptic_link [--port dev] [--baud n] "
+                 "fire|seq|profile|rtp|stats|bench|stream|shell|bank|bank-info|bank-play [args]\n");
+    std::exit(2);
+}
+
+uint16_t crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+std::vector<uint8_t> cobsEncode(const std::vector<uint8_t> &in) {
+    std::vector<uint8_t> out;
+    size_t codePos = out.size();
+    out.push_back(0);
+    uint8_t code = 1;
+    for (uint8_t b : in) {
+        if (b == 0) {
+            out[codePos] = code;
+            codePos = out.size();
+            out.push_back(0);
+            code = 1;
+            continue;
+        }
+        out.push_back(b);
+        if (++code == 0xFF) {
+            out[codePos] = code;
+            codePos = out.size();
+            out.push_back(0);
+            code = 1;
+        }
+    }
+    out[codePos] = code;
+    return out;
+}
+
+bool cobsDecode(const std::vector<uint8_t> &in, std::vector<uint8_t> *out) {
+    out->clear();
+    size_t i = 0;
+    while (i < in.size()) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > in.size()) {
+            return false;
+        }
+        out->insert(out->end(), in.begin() + i, in.begin() + i + code - 1);
+        i += code - 1;
+        if (code != 0xFF && i < in.size()) {
+            out->push_back(0);
+        }
+    }
+    return true;
+}
+
+speed_t baudConstant(int baud) {
+    switch (baud) {
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return 0;
+    }
+}
+
+class Link {
+public:
+    Link(const std::string &port, int baud) {
+        fd_ = ::open(port.c_str(), O_RDWR | O_NOCTTY);
+        if (fd_ < 0) {
+            std::fprintf(stderr, "cannot open %s: %s\n", port.c_str(), std::strerror(errno));
+            std::exit(1);
+        }
+        termios tio{};
+        tcgetattr(fd_, &tio);
+        cfmakeraw(&tio);
+        speed_t speed = baudConstant(baud);
+        if (speed == 0) {
+            std::fprintf(stderr, "unsupported baud %d\n", baud);
+            std::exit(1);
+        }
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd_, TCSANOW, &tio);
+        tcflush(fd_, TCIOFLUSH);
+    }
+
+    ~Link() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    // 发送一帧但不等待应答，返回其 seq；超长返回 -1
+    int post(const std::vector<uint8_t> &commands) {
+        std::vector<uint8_t> payload;
+        uint8_t seq = seq_++;
+        payload.push_back(seq);
+        payload.insert(payload.end(), commands.begin(), commands.end());
+        if (payload.size() > kMaxPayload) {
+            std::fprintf(stderr, "payload too long (%zu)\n", payload.size());
+            return -1;
+        }
+        send(payload);
+        return seq;
+    }
+
+    // 取下一个设备帧；信用帧顺带更新 credit()
+    bool next(std::vector<uint8_t> *frame, Clock::time_point deadline) {
+        if (!receive(frame, deadline)) {
+            return false;
+        }
+        if (frame->size() >= 8 && (*frame)[1] == kCredit) {
+            credit_.valid = true;
+            credit_.edge = static_cast<uint16_t>((*frame)[2] | ((*frame)[3] << 8));
+            credit_.underruns = static_cast<uint16_t>((*frame)[4] | ((*frame)[5] << 8));
+            credit_.late = static_cast<uint16_t>((*frame)[6] | ((*frame)[7] << 8));
+        }
+        return true;
+    }
+
+    // 发送一帧并等待同 seq 的应答；超时返回 false
+    bool transact(const std::vector<uint8_t> &commands, Reply *reply) {
+        int seq = post(commands);
+        if (seq < 0) {
+            return false;
+        }
+        auto deadline = Clock::now() + std::chrono::milliseconds(kReplyTimeoutMs);
+        std::vector<uint8_t> frame;
+        while (next(&frame, deadline)) {
+            if (frame.size() >= 4 && frame[0] == seq && frame[1] == kReply) {
+                parseReply(frame, reply);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void parseReply(const std::vector<uint8_t> &frame, Reply *reply) {
+        reply->seq = frame[0];
+        reply->ok = frame[2];
+        reply->failedOp = frame[3];
+        reply->data.assign(frame.begin() + 4, frame.end());
+    }
+
+    const Credit &credit() const { return credit_; }
+
+    uint64_t txBytes() const { return txBytes_; }
+    uint64_t rxBytes() const { return rxBytes_; }
+
+private:
+    void send(const std::vector<uint8_t> &payload) {
+        std::vector<uint8_t> raw = payload;
+        uint16_t crc = crc16(payload.data(), payload.size());
+        raw.push_back(static_cast<uint8_t>(crc >> 8));
+        raw.push_back(static_cast<uint8_t>(crc));
+        std::vector<uint8_t> wire;
+        wire.push_back(0);
+        std::vector<uint8_t> enc = cobsEncode(raw);
+        wire.insert(wire.end(), enc.begin(), enc.end());
+        wire.push_back(0);
+        size_t done = 0;
+        while (done < wire.size()) {
+            ssize_t n = ::write(fd_, wire.data() + done, wire.size() - done);
+            if (n < 0) {
+                std::fprintf(stderr, "write failed: %s\n", std::strerror(errno));
+                std::exit(1);
+            }
+            done += static_cast<size_t>(n);
+        }
+        txBytes_ += wire.size();
+    }
+
+    // 取下一个通过 CRC 的帧；其余内容为 trace 记录，直接丢弃
+    bool receive(std::vector<uint8_t> *frame, Clock::time_point deadline) {
+        while (true) {
+            size_t zero = 0;
+            while (zero < pending_.size() && pending_[zero] != 0) {
+                zero++;
+            }
+            if (zero < pending_.size()) {
+                std::vector<uint8_t> chunk(pending_.begin(), pending_.begin() + zero);
+                pending_.erase(pending_.begin(), pending_.begin() + zero + 1);
+                if (chunk.empty()) {
+                    continue;
+                }
+                if (cobsDecode(chunk, frame) && frame->size() >= 2 &&
+                    crc16(frame->data(), frame->size()) == 0) {
+                    frame->resize(frame->size() - 2);
+                    return true;
+                }
+                continue;
+            }
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - Clock::now()).count();
+            if (left <= 0) {
+                return false;
+            }
+            pollfd pfd{fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, static_cast<int>(left)) <= 0) {
+                return false;
+            }
+            uint8_t buf[256];
+            ssize_t n = ::read(fd_, buf, sizeof(buf));
+            if (n > 0) {
+                pending_.insert(pending_.end(), buf, buf + n);
+                rxBytes_ += static_cast<uint64_t>(n);
+            }
+        }
+    }
+
+    int fd_ = -1;
+    uint8_t seq_ = 0;
+    Credit credit_;
+    std::vector<uint8_t> pending_;
+    uint64_t txBytes_ = 0;
+    uint64_t rxBytes_ = 0;
+};
+
+void addCommand(std::vector<uint8_t> *out, uint8_t op, const std::vector<uint8_t> &data) {
+    out->push_back(op);
+    out->push_back(static_cast<uint8_t>(data.size()));
+    out->insert(out->end(), data.begin(), data.end());
+}
+
+uint32_t le32(const std::vector<uint8_t> &d, size_t at) {
+    return d[at] | (d[at + 1] << 8) | (d[at + 2] << 16) | (static_cast<uint32_t>(d[at + 3]) << 24);
+}
+
+uint16_t le16(const std::vector<uint8_t> &d, size_t at) {
+    return static_cast<uint16_t>(d[at] | (d[at + 1] << 8));
+}
+
+void printStats(const Reply &reply) {
+    if (reply.data.size() < 24) {
+        std::fprintf(stderr, "short stats reply\n");
+        return;
+    }
+    const std::vector<uint8_t> &d = reply.data;
+    std::printf("frames=%u bytes=%u crcErr=%u overrun=%u latency avg=%uus max=%uus "
+                "rtp samples=%u late=%u\n",
+                le32(d, 0), le32(d, 4), le16(d, 8), le16(d, 10), le16(d, 12), le16(d, 14),
+                le32(d, 16), le32(d, 20));
+}
+
+void printBankInfo(const Reply &reply) {
+    if (reply.data.size() < 8) {
+        std::fprintf(stderr, "short bank info reply\n");
+        return;
+    }
+    const std::vector<uint8_t> &d = reply.data;
+    if (d[0] == 0xFF) {
+        std::printf("bank empty\n");
+        return;
+    }
+    std::printf("bank slot %c, %u patterns, %u bytes, generation %u\n", 'A' + d[0], d[1],
+                le16(d, 2), le32(d, 4));
+}
+
+bool check(const Reply &reply, size_t expected) {
+    if (reply.ok != expected) {
+        std::fprintf(stderr, "device executed %u/%zu commands, first failure op 0x%02X\n",
+                     reply.ok, expected, reply.failedOp);
+        return false;
+    }
+    return true;
+}
+
+Options parseArgs(int argc, char **argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) {
+            opt.port = argv[++i];
+        } else if (arg == "--baud" && i + 1 < argc) {
+            opt.baud = std::atoi(argv[++i]);
+        } else {
+            opt.args.push_back(arg);
+        }
+    }
+    if (opt.args.empty()) {
+        usage();
+    }
+    return opt;
+}
+
+uint8_t number(const std::string &s) {
+    return static_cast<uint8_t>(std::strtoul(s.c_str(), nullptr, 0));
+}
+
+bool readSamples(const std::string &path, std::vector<uint8_t> *samples) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line[0] != '#') {
+            samples->push_back(static_cast<uint8_t>(std::atoi(line.c_str()) & 0x7F));
+        }
+    }
+    return true;
+}
+
+int runRtp(Link &link, const std::string &path) {
+    std::vector<uint8_t> samples;
+    if (!readSamples(path, &samples)) {
+        return 1;
+    }
+    size_t sent = 0;
+    size_t rejected = 0;
+    while (sent < samples.size()) {
+        size_t n = std::min(kRtpChunk, samples.size() - sent);
+        std::vector<uint8_t> cmd;
+        addCommand(&cmd, kOpRtp, std::vector<uint8_t>(samples.begin() + sent,
+                                                      samples.begin() + sent + n));
+        Reply reply;
+        if (!link.transact(cmd, &reply)) {
+            std::fprintf(stderr, "timeout at sample %zu\n", sent);
+            return 1;
+        }
+        if (reply.ok == 1) {
+            sent += n;
+        } else {
+            rejected++;   // 设备缓冲已满，稍后重发
+            usleep(5000);
+        }
+    }
+    std::printf("sent %zu samples, %zu busy retries\n", sent, rejected);
+    return 0;
+}
+
+int runBench(Link &link, int frames) {
+    std::vector<double> rtt;
+    std::vector<uint8_t> cmd;
+    addCommand(&cmd, kOpStats, {});
+    Reply reply;
+    auto start = Clock::now();
+    for (int i = 0; i < frames; i++) {
+        auto t0 = Clock::now();
+        if (!link.transact(cmd, &reply)) {
+            std::fprintf(stderr, "timeout at frame %d\n", i);
+            return 1;
+        }
+        rtt.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    double total = 0;
+    double worst = 0;
+    for (double v : rtt) {
+        total += v;
+        worst = std::max(worst, v);
+    }
+    std::printf("%d frames in %.3fs: %.0f frames/s, tx %.0f B/s, rx %.0f B/s\n", frames, seconds,
+                frames / seconds, link.txBytes() / seconds, link.rxBytes() / seconds);
+    std::printf("round trip avg %.0fus max %.0fus\n", total / rtt.size(), worst);
+    printStats(reply);
+    return 0;
+}
+
+// 信用流控：只发送累计序号 < edge 的样本，不等待逐帧应答
+int runStream(Link &link, const std::string &path, int rateHz, int prebuffer) {
+    std::vector<uint8_t> samples;
+    if (!readSamples(path, &samples) || samples.empty()) {
+        return 1;
+    }
+    std::vector<uint8_t> cmd;
+    addCommand(&cmd, kOpStream, {static_cast<uint8_t>(prebuffer), static_cast<uint8_t>(rateHz),
+                                 static_cast<uint8_t>(rateHz >> 8)});
+    Reply reply;
+    if (!link.transact(cmd, &reply) || !check(reply, 1) || !link.credit().valid) {
+        std::fprintf(stderr, "stream start rejected\n");
+        return 1;
+    }
+
+    const size_t total = samples.size();
+    std::vector<Clock::time_point> sentAt(total);
+    uint16_t baseEdge = static_cast<uint16_t>(link.credit().edge - kDeviceFifo);
+    uint16_t baseUnderruns = link.credit().underruns;
+    uint16_t baseLate = link.credit().late;
+    size_t sent = 0;
+    size_t played = 0;
+    size_t consumed = 0;
+    uint16_t lastConsumed16 = 0;
+    size_t rejected = 0;
+    bool stopSent = false;
+    double latencySum = 0;
+    double latencyMax = 0;
+    size_t latencyCount = 0;
+    auto start = Clock::now();
+    auto progress = start;
+
+    while (played < total) {
+        size_t window = played + kDeviceFifo;
+        while (sent < total && sent < window) {
+            size_t n = std::min({kRtpChunk, window - sent, total - sent});
+            std::vector<uint8_t> rtp;
+            addCommand(&rtp, kOpRtp, std::vector<uint8_t>(samples.begin() + sent,
+                                                          samples.begin() + sent + n));
+            link.post(rtp);
+            for (size_t i = 0; i < n; i++) {
+                sentAt[sent + i] = Clock::now();
+            }
+            sent += n;
+        }
+        if (sent == total && !stopSent) {
+            std::vector<uint8_t> stop;
+            addCommand(&stop, kOpStreamStop, {});
+            link.post(stop);
+            stopSent = true;
+        }
+
+        std::vector<uint8_t> frame;
+        auto deadline = Clock::now() + std::chrono::milliseconds(2);
+        while (link.next(&frame, deadline)) {
+            if (frame.size() >= 4 && frame[1] == kReply && frame[2] == 0) {
+                rejected++;   // 信用正确时不应出现
+            }
+        }
+        uint16_t consumed16 = static_cast<uint16_t>(link.credit().edge - kDeviceFifo - baseEdge);
+        consumed += static_cast<uint16_t>(consumed16 - lastConsumed16);   // 展开 16 位回绕
+        lastConsumed16 = consumed16;
+        while (played < consumed && played < total) {
+            double us = std::chrono::duration<double, std::micro>(Clock::now() - sentAt[played]).count();
+            latencySum += us;
+            latencyMax = std::max(latencyMax, us);
+            latencyCount++;
+            played++;
+            progress = Clock::now();
+        }
+        if (Clock::now() - progress > std::chrono::seconds(1)) {
+            std::fprintf(stderr, "stream stalled at %zu/%zu samples\n", played, total);
+            return 1;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    unsigned underruns = static_cast<uint16_t>(link.credit().underruns - baseUnderruns);
+    unsigned late = static_cast<uint16_t>(link.credit().late - baseLate);
+    std::printf("streamed %zu samples in %.3fs (%.0f Hz, prebuffer %d)\n", total, seconds,
+                total / seconds, prebuffer);
+    std::printf("latency avg %.1fms max %.1fms (host send -> device consume)\n",
+                latencySum / latencyCount / 1000.0, latencyMax / 1000.0);
+    std::printf("glitches: underruns=%u late=%u rejected=%zu\n", underruns, late, rejected);
+    return (underruns || late || rejected) ? 3 : 0;
+}
+
+// BEGIN 擦除非活动槽 → 顺序 DATA 块 → COMMIT 带整映像 CRC；任一步失败原活动槽不受影响
+int runBank(Link &link, const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    std::vector<uint8_t> image((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (image.empty() || image.size() > kBankImageMax) {
+        std::fprintf(stderr, "image must be 1..%zu bytes (got %zu)\n", kBankImageMax, image.size());
+        return 1;
+    }
+
+    auto start = Clock::now();
+    std::vector<uint8_t> cmd;
+    Reply reply;
+    addCommand(&cmd, kOpBankBegin, {static_cast<uint8_t>(image.size()),
+                                    static_cast<uint8_t>(image.size() >> 8)});
+    if (!link.transact(cmd, &reply) || !check(reply, 1)) {
+        std::fprintf(stderr, "bank begin failed\n");
+        return 1;
+    }
+    for (size_t offset = 0; offset < image.size(); offset += kBankChunk) {
+        size_t n = std::min(kBankChunk, image.size() - offset);
+        std::vector<uint8_t> data = {static_cast<uint8_t>(offset), static_cast<uint8_t>(offset >> 8)};
+        data.insert(data.end(), image.begin() + offset, image.begin() + offset + n);
+        cmd.clear();
+        addCommand(&cmd, kOpBankData, data);
+        if (!link.transact(cmd, &reply) || !check(reply, 1)) {
+            std::fprintf(stderr, "bank data failed at offset %zu\n", offset);
+            return 1;
+        }
+    }
+    uint16_t crc = crc16(image.data(), image.size());
+    cmd.clear();
+    addCommand(&cmd, kOpBankCommit, {static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8)});
+    addCommand(&cmd, kOpBankInfo, {});
+    if (!link.transact(cmd, &reply) || !check(reply, 2)) {
+        std::fprintf(stderr, "bank commit failed, previous bank still active\n");
+        return 1;
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::printf("uploaded %zu bytes (crc 0x%04X) in %.0fms\n", image.size(), crc, ms);
+    printBankInfo(reply);
+    return 0;
+}
+
+void shellHelp() {
+    std::printf("  r <reg> [n]           read n registers (shadow first)\n"
+                "  w <reg> <v> [v...]    write consecutive registers\n"
+                "  get                   show tuning parameters\n"
+                "  set <name> <value>    drive|strength|overdrive|sustainp|sustainn|brake|burst|pause\n"
+                "  save                  store tuning in flash\n"
+                "  fire <effect>         play an LRA library effect\n"
+                "  profile <id>          apply a built-in profile\n"
+                "  stats                 device statistics\n"
+                "  quit\n");
+}
+
+// 单条命令一帧，成功返回应答附加数据
+bool shellCommand(Link &link, uint8_t op, const std::vector<uint8_t> &data, Reply *reply) {
+    std::vector<uint8_t> cmd;
+    addCommand(&cmd, op, data);
+    if (!link.transact(cmd, reply)) {
+        std::printf("no reply\n");
+        return false;
+    }
+    if (reply->ok != 1) {
+        std::printf("rejected (op 0x%02X)\n", reply->failedOp);
+        return false;
+    }
+    return true;
+}
+
+// 文本命令在主机端解析，设备只执行二进制操作码
+int runShell(Link &link) {
+    std::string line;
+    shellHelp();
+    while (std::printf("> "), std::fflush(stdout), std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::vector<std::string> t;
+        for (std::string word; in >> word;) {
+            t.push_back(word);
+        }
+        if (t.empty()) {
+            continue;
+        }
+        const std::string &c = t[0];
+        Reply reply;
+        if (c == "quit" || c == "exit") {
+            break;
+        } else if (c == "help") {
+            shellHelp();
+        } else if (c == "r" && (t.size() == 2 || t.size() == 3)) {
+            uint8_t reg = number(t[1]);
+            uint8_t n = (t.size() == 3) ? number(t[2]) : 1;
+            if (n == 0 || n > kReplyData) {
+                std::printf("count must be 1..%zu\n", kReplyData);
+            } else if (shellCommand(link, kOpRegRead, {reg, n}, &reply)) {
+                for (size_t i = 0; i < reply.data.size(); i++) {
+                    std::printf("0x%02zX = 0x%02X\n", reg + i, reply.data[i]);
+                }
+            }
+        } else if (c == "w" && t.size() >= 3 && t.size() <= kRegBurst + 2) {
+            std::vector<uint8_t> data;
+            for (size_t i = 1; i < t.size(); i++) {
+                data.push_back(number(t[i]));
+            }
+            if (shellCommand(link, kOpRegWrite, data, &reply)) {
+                std::printf("ok\n");
+            }
+        } else if (c == "get" && t.size() == 1) {
+            if (shellCommand(link, kOpTuneGet, {}, &reply) && reply.data.size() >= 2 * kTuneCount) {
+                for (size_t i = 0; i < kTuneCount; i++) {
+                    unsigned v = le16(reply.data, 2 * i);
+                    std::printf("%-10s %u (0x%02X)\n", kTuneNames[i], v, v);
+                }
+            }
+        } else if (c == "set" && t.size() == 3) {
+            size_t field = std::find(kTuneNames, kTuneNames + kTuneCount, t[1]) - kTuneNames;
+            unsigned long v = std::strtoul(t[2].c_str(), nullptr, 0);
+            if (field == kTuneCount || v > 0xFFFF) {
+                std::printf("unknown parameter or value out of range\n");
+            } else if (shellCommand(link, kOpTuneSet, {static_cast<uint8_t>(field),
+                                                       static_cast<uint8_t>(v),
+                                                       static_cast<uint8_t>(v >> 8)}, &reply)) {
+                std::printf("ok\n");
+            }
+        } else if (c == "save" && t.size() == 1) {
+            if (shellCommand(link, kOpTuneSave, {}, &reply)) {
+                std::printf("saved\n");
+            }
+        } else if (c == "fire" && t.size() == 2) {
+            if (shellCommand(link, kOpFire, {number(t[1])}, &reply)) {
+                std::printf("ok\n");
+            }
+        } else if (c == "profile" && t.size() == 2) {
+            if (shellCommand(link, kOpProfile, {number(t[1])}, &reply)) {
+                std::printf("ok\n");
+            }
+        } else if (c == "stats" && t.size() == 1) {
+            if (shellCommand(link, kOpStats, {}, &reply)) {
+                printStats(reply);
+            }
+        } else {
+            std::printf("unknown command, type help\n");
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opt = parseArgs(argc, argv);
+    Link link(opt.port, opt.baud);
+    const std::vector<std::string> &a = opt.args;
+    const std::string &cmdName = a[0];
+    std::vector<uint8_t> cmd;
+    Reply reply;
+
+    if (cmdName == "fire" && a.size() == 2) {
+        addCommand(&cmd, kOpFire, {number(a[1])});
+    } else if (cmdName == "seq" && a.size() >= 3 && a.size() <= 10) {
+        std::vector<uint8_t> data;
+        for (size_t i = 1; i < a.size(); i++) {
+            data.push_back(number(a[i]));
+        }
+        addCommand(&cmd, kOpSequence, data);
+        addCommand(&cmd, kOpGo, {});
+    } else if (cmdName == "profile" && a.size() == 2) {
+        addCommand(&cmd, kOpProfile, {number(a[1])});
+    } else if (cmdName == "stats" && a.size() == 1) {
+        addCommand(&cmd, kOpStats, {});
+    } else if (cmdName == "rtp" && a.size() == 2) {
+        return runRtp(link, a[1]);
+    } else if (cmdName == "stream" && a.size() >= 2 && a.size() <= 4) {
+        int rate = (a.size() >= 3) ? std::atoi(a[2].c_str()) : 1000;
+        int prebuffer = (a.size() >= 4) ? std::atoi(a[3].c_str()) : 32;
+        return runStream(link, a[1], rate, prebuffer);
+    } else if (cmdName == "bench" && a.size() == 2) {
+        return runBench(link, std::atoi(a[1].c_str()));
+    } else if (cmdName == "shell" && a.size() == 1) {
+        return runShell(link);
+    } else if (cmdName == "bank" && a.size() == 2) {
+        return runBank(link, a[1]);
+    } else if (cmdName == "bank-info" && a.size() == 1) {
+        addCommand(&cmd, kOpBankInfo, {});
+        if (!link.transact(cmd, &reply)) {
+            std::fprintf(stderr, "no reply\n");
+            return 1;
+        }
+        printBankInfo(reply);
+        return check(reply, 1) ? 0 : 1;
+    } else if (cmdName == "bank-play" && a.size() == 2) {
+        addCommand(&cmd, kOpBankPlay, {number(a[1])});
+    } else {
+        usage();
+    }
+
+    // 单帧批量：命令后附 STATS，一次往返同时取回延迟统计
+    size_t expected = (cmdName == "seq") ? 3 : (cmdName == "stats") ? 1 : 2;
+    if (cmdName != "stats") {
+        addCommand(&cmd, kOpStats, {});
+    }
+    if (!link.transact(cmd, &reply)) {
+        std::fprintf(stderr, "no reply\n");
+        return 1;
+    }
+    printStats(reply);
+    return check(reply, expected) ? 0 : 1;
+}
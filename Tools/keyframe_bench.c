@@ -0,0 +1,205 @@
+/******************************************************************************
+ * 文件名   : keyframe_bench.c
+ * 描述     : 主机端关键帧插值精度测试与基准：随机关键帧集合上，比较 Q32.32
+ *            前向差分输出与双精度 Hermite/线性参考曲线，报告最大误差与
+ *            取整后 RTP 值的失配数。参考实现按与固件相同的规则取切线
+ *            （中心差分、极值置零、Fritsch-Carlson 限幅），只差在算术精度。
+ * 编译     : gcc -O2 -DHAPTIC_KEYFRAME_HOST -IUser -o keyframe_bench Tools/keyframe_bench.c User/haptic_keyframe.c -lm
+ ******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "haptic_keyframe.h"
+
+#define MAX_KEYS      16
+#define SETS          5000
+#define BENCH_ROUNDS  200
+
+typedef struct {
+    double maxError;    /* 16 位宽输出与参考的最大偏差（RTP LSB） */
+    long mismatches;    /* 7 位输出与参考取整不一致的样本数 */
+    long samples;
+} Stats;
+
+static u16 SegmentSamples(const HapticKeyframePattern *pattern, int index) {
+    if(index <= 0 || index >= pattern->count) {
+        return 0;
+    }
+    return (u16)(pattern->keys[index].dtUnits * pattern->unitMs);
+}
+
+static double Tangent(const HapticKeyframePattern *pattern, int index, u16 segment) {
+    const HapticKeyframe *keys = pattern->keys;
+    double before;
+    double after;
+    u16 spanBefore;
+    u16 spanAfter;
+
+    if(index == 0) {
+        return (double)keys[1].amplitude - keys[0].amplitude;
+    }
+    if(index >= pattern->count - 1) {
+        return (double)keys[index].amplitude - keys[index - 1].amplitude;
+    }
+    before = (double)keys[index].amplitude - keys[index - 1].amplitude;
+    after = (double)keys[index + 1].amplitude - keys[index].amplitude;
+    if(before == 0 || after == 0 || ((before < 0) != (after < 0))) {
+        return 0;
+    }
+    spanBefore = SegmentSamples(pattern, index);
+    spanAfter = SegmentSamples(pattern, index + 1);
+    if(spanBefore + spanAfter == 0) {
+        return 0;
+    }
+    return (before + after) * segment / ((double)spanBefore + spanAfter);
+}
+
+static double Limit(double m, double chord) {
+    double limit = 3 * fabs(chord);
+    return (m > limit) ? limit : ((m < -limit) ? -limit : m);
+}
+
+/* 参考曲线：与 HapticKeyframe_Render 相同的样本顺序，每段输出 [起点, 终点) */
+static long Reference(const HapticKeyframePattern *pattern, double *out, long capacity) {
+    long produced = 0;
+
+    for(int k = 0; k + 1 < pattern->count; k++) {
+        u16 n = SegmentSamples(pattern, k + 1);
+        double p1 = pattern->keys[k].amplitude;
+        double p2 = pattern->keys[k + 1].amplitude;
+        double m1 = 0;
+        double m2 = 0;
+
+        if(pattern->mode == HAPTIC_KEYFRAME_CUBIC) {
+            m1 = Limit(Tangent(pattern, k, n), p2 - p1);
+            m2 = Limit(Tangent(pattern, k + 1, n), p2 - p1);
+        }
+        for(u16 i = 0; i < n && produced < capacity; i++) {
+            double t = (double)i / n;
+            double t2 = t * t;
+            double t3 = t2 * t;
+            if(pattern->mode == HAPTIC_KEYFRAME_CUBIC) {
+                out[produced++] = (2 * t3 - 3 * t2 + 1) * p1 + (t3 - 2 * t2 + t) * m1 +
+                                  (-2 * t3 + 3 * t2) * p2 + (t3 - t2) * m2;
+            } else {
+                out[produced++] = p1 + (p2 - p1) * t;
+            }
+        }
+    }
+    return produced;
+}
+
+static void RandomPattern(HapticKeyframePattern *pattern, HapticKeyframe *keys, u8 maxUnitMs) {
+    int count = 2 + rand() % (MAX_KEYS - 1);
+
+    for(int i = 0; i < count; i++) {
+        keys[i].dtUnits = (u8)((rand() % 8 == 0) ? 0 : rand() % 256);
+        keys[i].amplitude = (u8)(rand() & 0x7F);
+    }
+    pattern->keys = keys;
+    pattern->count = (u8)count;
+    pattern->unitMs = (u8)(1 + rand() % maxUnitMs);
+    pattern->mode = (u8)(rand() & 1);
+}
+
+static void Compare(const HapticKeyframePattern *pattern, Stats *stats) {
+    static double ref[MAX_KEYS * 65025L];
+    static u16 wide[MAX_KEYS * 65025L];
+    static u8 narrow[MAX_KEYS * 65025L];
+    HapticKeyframePlayer player;
+    long total = Reference(pattern, ref, MAX_KEYS * 65025L);
+    long got = 0;
+    u16 n;
+
+    HapticKeyframe_Start(&player, pattern);
+    while((n = HapticKeyframe_RenderWide(&player, wide + got, 4096)) != 0) {
+        got += n;
+    }
+    HapticKeyframe_Start(&player, pattern);
+    got = 0;
+    while((n = HapticKeyframe_Render(&player, narrow + got, 4096)) != 0) {
+        got += n;
+    }
+    if(got != total) {
+        printf("length mismatch: %ld vs %ld\n", got, total);
+        stats->mismatches += labs(got - total);
+        return;
+    }
+
+    for(long i = 0; i < total; i++) {
+        double clamped = (ref[i] < 0) ? 0 : ((ref[i] > 127) ? 127 : ref[i]);
+        double error = fabs(wide[i] / 512.0 - clamped);
+        long rounded = lround(clamped);
+        /* 参考值距 .5 不足 1/1024 LSB 时两边取整都合理，不计为失配 */
+        if(narrow[i] != rounded && fabs(clamped - floor(clamped) - 0.5) > 1.0 / 1024) {
+            stats->mismatches++;
+        }
+        /* 宽输出截断到 1/512，本身带 1/512 的量化 */
+        if(error > stats->maxError) {
+            stats->maxError = error;
+        }
+    }
+    stats->samples += total;
+}
+
+static void Report(const char *label, u8 maxUnitMs) {
+    HapticKeyframe keys[MAX_KEYS];
+    HapticKeyframePattern pattern;
+    Stats stats = {0, 0, 0};
+
+    for(int set = 0; set < SETS; set++) {
+        RandomPattern(&pattern, keys, maxUnitMs);
+        Compare(&pattern, &stats);
+    }
+    printf("%-22s %9ld samples  max error %.6f LSB  rtp mismatches %ld\n",
+           label, stats.samples, stats.maxError, stats.mismatches);
+}
+
+static double Seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void Bench(u8 mode) {
+    static const HapticKeyframe keys[] = {
+        {0, 0x00}, {20, 0x7F}, {40, 0x30}, {60, 0x50}, {80, 0x00}
+    };
+    const HapticKeyframePattern pattern = {keys, 5, 4, mode};
+    static double ref[MAX_KEYS * 65025L];
+    u8 block[64];
+    HapticKeyframePlayer player;
+    volatile unsigned sink = 0;
+    long samples = 0;
+    clock_t t0 = clock();
+    u16 n;
+
+    for(int r = 0; r < BENCH_ROUNDS * 100; r++) {
+        HapticKeyframe_Start(&player, &pattern);
+        while((n = HapticKeyframe_Render(&player, block, sizeof(block))) != 0) {
+            sink += block[n - 1];
+            samples += n;
+        }
+    }
+    printf("%-22s %6.2f ns/sample\n", mode ? "cubic q32" : "linear q32",
+           Seconds(t0) * 1e9 / (double)samples);
+
+    samples = 0;
+    t0 = clock();
+    for(int r = 0; r < BENCH_ROUNDS * 100; r++) {
+        long count = Reference(&pattern, ref, MAX_KEYS * 65025L);
+        sink += (unsigned)ref[count - 1];
+        samples += count;
+    }
+    printf("%-22s %6.2f ns/sample\n", mode ? "cubic double" : "linear double",
+           Seconds(t0) * 1e9 / (double)samples);
+}
+
+int main(void) {
+    srand(1);
+    Report("unit 1..4 ms", 4);
+    Report("unit 1..32 ms", 32);
+    Report("unit 1..255 ms", 255);
+    Bench(HAPTIC_KEYFRAME_LINEAR);
+    Bench(HAPTIC_KEYFRAME_CUBIC);
+    return 0;
+}
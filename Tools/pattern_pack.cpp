@@ -0,0 +1,278 @@
+/******************************************************************************
+ * 文件名   : pattern_pack.cpp
+ * 描述     : 主机端图案打包工具：把 (幅值, 保持ms) 帧列表编码为 HapticPattern 字节流，
+ *            输出可直接编译进固件的 C 源码，或打包为图案库映像经主机链路写入
+ *            flash（格式见 User/haptic_pattern.h 与 User/haptic_bank.h）。
+ * 编译     : g++ -std=c++17 -O2 -o pattern_pack pattern_pack.cpp
+ * 用法     : pattern_pack [--unit ms] [--quant4] name input.csv > out.c
+ *            pattern_pack --bank out.bin [--unit ms] [--quant4] a.csv [--unit ms] b.csv ...
+ *            输入每行 "amplitude,holdMs"，# 开头为注释。图案库模式下每个输入
+ *            使用其前面最近一次给出的 --unit/--quant4。上传：haptic_link bank out.bin
+ ******************************************************************************/
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Frame {
+    int level;   // 编码域电平
+    int units;   // 保持单位数
+};
+
+struct Settings {
+    int unitMs = 1;
+    bool quant4 = false;
+};
+
+struct Input {
+    std::string path;
+    Settings settings;
+};
+
+struct Options {
+    Settings settings;
+    std::string name;
+    std::string input;
+    std::string bank;              // 非空为图案库模式
+    std::vector<Input> bankInputs;
+};
+
+const int kMaxShortUnits = 8;
+const int kMaxRunUnits = 64;
+const int kMaxAbsUnits = 32;
+const int kMaxLongUnits = 4096;
+const int kMaxNibbleBytes = 15;
+const int kMinNibbleRun = 4;
+const size_t kBankImageMax = 448;  // HAPTIC_BANK_IMAGE_MAX
+const size_t kBankEntryBytes = 6;  // HAPTIC_BANK_ENTRY_BYTES
+const size_t kBankMaxCount = 255;
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: pattern_pack [--unit ms] [--quant4] name input.csv\n"
+                 "       pattern_pack --bank out.bin [--unit ms] [--quant4] input.csv ...\n");
+    std::exit(2);
+}
+
+Options parseArgs(int argc, char **argv) {
+    Options opt;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--unit" && i + 1 < argc) {
+            opt.settings.unitMs = std::atoi(argv[++i]);
+            if (opt.settings.unitMs < 1 || opt.settings.unitMs > 255) {
+                usage();
+            }
+        } else if (arg == "--quant4") {
+            opt.settings.quant4 = true;
+        } else if (arg == "--bank" && i + 1 < argc) {
+            opt.bank = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage();
+        } else {
+            positional.push_back(arg);
+            opt.bankInputs.push_back({arg, opt.settings});
+        }
+    }
+    if (!opt.bank.empty()) {
+        if (opt.bankInputs.empty() || opt.bankInputs.size() > kBankMaxCount) {
+            usage();
+        }
+        return opt;
+    }
+    if (positional.size() != 2) {
+        usage();
+    }
+    opt.name = positional[0];
+    opt.input = positional[1];
+    return opt;
+}
+
+std::vector<Frame> readFrames(const std::string &path, const Settings &opt, size_t *rawFrames) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        std::exit(1);
+    }
+    std::vector<Frame> frames;
+    std::string line;
+    *rawFrames = 0;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream ss(line);
+        int amplitude = 0;
+        int holdMs = 0;
+        char comma = 0;
+        if (!(ss >> amplitude >> comma >> holdMs) || comma != ',') {
+            continue;
+        }
+        (*rawFrames)++;
+        if (amplitude < 0) amplitude = 0;
+        if (amplitude > 0x7F) amplitude = 0x7F;
+        int units = (holdMs + opt.unitMs / 2) / opt.unitMs;
+        if (holdMs > 0 && units == 0) units = 1;
+        if (units == 0) {
+            continue;
+        }
+        int level = opt.quant4 ? (amplitude + 4) >> 3 : amplitude;
+        if (level > (opt.quant4 ? 15 : 0x7F)) level = opt.quant4 ? 15 : 0x7F;
+        if (!frames.empty() && frames.back().level == level) {
+            frames.back().units += units;   // 相同电平直接合并为游程
+        } else {
+            frames.push_back({level, units});
+        }
+    }
+    return frames;
+}
+
+void emitRuns(std::vector<uint8_t> &out, int units) {
+    while (units > 0) {
+        if (units <= kMaxRunUnits) {
+            out.push_back(static_cast<uint8_t>(0x80 | (units - 1)));
+            return;
+        }
+        int chunk = units > kMaxLongUnits ? kMaxLongUnits : units;
+        out.push_back(static_cast<uint8_t>(0xE0 | ((chunk - 1) >> 8)));
+        out.push_back(static_cast<uint8_t>((chunk - 1) & 0xFF));
+        units -= chunk;
+    }
+}
+
+void emitFrame(std::vector<uint8_t> &out, int &current, const Frame &frame) {
+    int delta = frame.level - current;
+    int units = frame.units;
+    if (delta >= -8 && delta <= 7) {
+        int first = units > kMaxShortUnits ? kMaxShortUnits : units;
+        out.push_back(static_cast<uint8_t>(((delta & 0x0F) << 3) | (first - 1)));
+        units -= first;
+    } else {
+        int first = units > kMaxAbsUnits ? kMaxAbsUnits : units;
+        out.push_back(static_cast<uint8_t>(0xC0 | (first - 1)));
+        out.push_back(static_cast<uint8_t>(frame.level));
+        units -= first;
+    }
+    current = frame.level;
+    emitRuns(out, units);
+}
+
+// 量化模式下连续的单单位帧打包为半字节块，每字节两个样本
+size_t emitNibbles(std::vector<uint8_t> &out, int &current,
+                   const std::vector<Frame> &frames, size_t start) {
+    size_t end = start;
+    while (end < frames.size() && frames[end].units == 1) {
+        end++;
+    }
+    size_t count = (end - start) & ~static_cast<size_t>(1);
+    if (count < kMinNibbleRun) {
+        return 0;
+    }
+    size_t done = 0;
+    while (done < count) {
+        size_t bytes = (count - done) / 2;
+        if (bytes > kMaxNibbleBytes) bytes = kMaxNibbleBytes;
+        out.push_back(static_cast<uint8_t>(0xF0 | bytes));
+        for (size_t b = 0; b < bytes; b++) {
+            const Frame &hi = frames[start + done + 2 * b];
+            const Frame &lo = frames[start + done + 2 * b + 1];
+            out.push_back(static_cast<uint8_t>((hi.level << 4) | lo.level));
+        }
+        done += bytes * 2;
+    }
+    current = frames[start + count - 1].level;
+    return count;
+}
+
+std::vector<uint8_t> encode(const Settings &opt, const std::vector<Frame> &frames) {
+    std::vector<uint8_t> out;
+    int current = 0;
+    size_t i = 0;
+    while (i < frames.size()) {
+        if (opt.quant4) {
+            size_t used = emitNibbles(out, current, frames, i);
+            if (used) {
+                i += used;
+                continue;
+            }
+        }
+        emitFrame(out, current, frames[i]);
+        i++;
+    }
+    out.push_back(0xF0);
+    return out;
+}
+
+void put16(std::vector<uint8_t> &out, size_t pos, size_t value) {
+    out[pos] = static_cast<uint8_t>(value & 0xFF);
+    out[pos + 1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+}
+
+// 映像 = 索引项数组 + 各图案字节流，偏移相对映像起点
+int packBank(const Options &opt) {
+    std::vector<uint8_t> image(opt.bankInputs.size() * kBankEntryBytes);
+    for (size_t i = 0; i < opt.bankInputs.size(); i++) {
+        const Input &input = opt.bankInputs[i];
+        size_t rawFrames = 0;
+        std::vector<uint8_t> bytes = encode(input.settings, readFrames(input.path, input.settings, &rawFrames));
+        size_t entry = i * kBankEntryBytes;
+        put16(image, entry, image.size());
+        put16(image, entry + 2, bytes.size());
+        image[entry + 4] = static_cast<uint8_t>(input.settings.unitMs);
+        image[entry + 5] = input.settings.quant4 ? 0x01 : 0x00;   // HAPTIC_PATTERN_QUANT4
+        image.insert(image.end(), bytes.begin(), bytes.end());
+        std::fprintf(stderr, "%2zu %s: %zu frames -> %zu B (unit %d ms%s)\n", i, input.path.c_str(),
+                     rawFrames, bytes.size(), input.settings.unitMs, input.settings.quant4 ? ", quant4" : "");
+    }
+    std::fprintf(stderr, "bank image %zu / %zu B\n", image.size(), kBankImageMax);
+    if (image.size() > kBankImageMax) {
+        std::fprintf(stderr, "bank image too large\n");
+        return 1;
+    }
+
+    std::ofstream out(opt.bank, std::ios::binary);
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", opt.bank.c_str());
+        return 1;
+    }
+    out.write(reinterpret_cast<const char *>(image.data()), static_cast<std::streamsize>(image.size()));
+    return out ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opt = parseArgs(argc, argv);
+    if (!opt.bank.empty()) {
+        return packBank(opt);
+    }
+    size_t rawFrames = 0;
+    std::vector<Frame> frames = readFrames(opt.input, opt.settings, &rawFrames);
+    std::vector<uint8_t> bytes = encode(opt.settings, frames);
+
+    std::string base = opt.input.substr(opt.input.find_last_of("/\\") + 1);
+    std::printf("/* 由 Tools/pattern_pack.cpp 生成：%s，%zu 帧 -> %zu 字节 */\n",
+                base.c_str(), rawFrames, bytes.size());
+    std::printf("static const u8 %s_data[] = {", opt.name.c_str());
+    for (size_t i = 0; i < bytes.size(); i++) {
+        std::printf("%s0x%02X%s", (i % 12) ? " " : "\n    ", bytes[i],
+                    (i + 1 < bytes.size()) ? "," : "");
+    }
+    std::printf("\n};\n");
+    std::printf("const HapticPattern %s = { %s_data, sizeof(%s_data), %d, %s };\n",
+                opt.name.c_str(), opt.name.c_str(), opt.name.c_str(), opt.settings.unitMs,
+                opt.settings.quant4 ? "HAPTIC_PATTERN_QUANT4" : "0");
+
+    // DRV2605_RtpAction 对齐后每帧 4 字节
+    size_t actionBytes = rawFrames * 4;
+    std::fprintf(stderr, "%s: %zu frames, RtpAction %zu B -> packed %zu B (%.1fx)\n",
+                 opt.name.c_str(), rawFrames, actionBytes, bytes.size(),
+                 bytes.empty() ? 0.0 : static_cast<double>(actionBytes) / bytes.size());
+    return 0;
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * 文件名   : core_riscv.h（主机仿真替身）
+ * 描述     : 仅供 Tools 下把固件源码编译到 PC 上的测试使用：提供 ch32v00x.h
+ *            依赖的整数类型、状态枚举与空的中断/NVIC 操作，不访问任何寄存器。
+ ******************************************************************************/
+#ifndef __CORE_RISCV_H__
+#define __CORE_RISCV_H__
+
+#include <stdint.h>
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+typedef enum {NoREADY = 0, READY = !NoREADY} ErrorStatus;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+
+typedef __I uint64_t vuc64;
+typedef __I uint32_t vuc32;
+typedef __I uint16_t vuc16;
+typedef __I uint8_t vuc8;
+typedef const uint64_t uc64;
+typedef const uint32_t uc32;
+typedef const uint16_t uc16;
+typedef const uint8_t uc8;
+typedef __I int64_t vsc64;
+typedef __I int32_t vsc32;
+typedef __I int16_t vsc16;
+typedef __I int8_t vsc8;
+typedef const int64_t sc64;
+typedef const int32_t sc32;
+typedef const int16_t sc16;
+typedef const int8_t sc8;
+typedef __IO uint64_t vu64;
+typedef __IO uint32_t vu32;
+typedef __IO uint16_t vu16;
+typedef __IO uint8_t vu8;
+typedef uint64_t u64;
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t u8;
+typedef __IO int64_t vs64;
+typedef __IO int32_t vs32;
+typedef __IO int16_t vs16;
+typedef __IO int8_t vs8;
+typedef int64_t s64;
+typedef int32_t s32;
+typedef int16_t s16;
+typedef int8_t s8;
+
+static inline void __enable_irq(void) {}
+static inline void __disable_irq(void) {}
+static inline void __WFI(void) {}
+static inline void __NOP(void) {}
+static inline uint32_t __get_MSTATUS(void) { return 0; }
+static inline void __set_MSTATUS(uint32_t value) { (void)value; }
+static inline void NVIC_EnableIRQ(int irq) { (void)irq; }
+static inline void NVIC_DisableIRQ(int irq) { (void)irq; }
+
+#endif /* __CORE_RISCV_H__ */
@@ -0,0 +1,15 @@
+/******************************************************************************
+ * 文件名   : debug.h（主机仿真替身）
+ * 描述     : 仅供 Tools 下的主机测试使用，延时由测试程序按虚拟时间实现。
+ ******************************************************************************/
+#ifndef __DEBUG_H
+#define __DEBUG_H
+
+#include <stdio.h>
+#include "ch32v00x.h"
+
+void Delay_Init(void);
+void Delay_Us(uint32_t n);
+void Delay_Ms(uint32_t n);
+
+#endif /* __DEBUG_H */
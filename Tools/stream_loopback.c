@@ -0,0 +1,650 @@
+/******************************************************************************
+ * 文件名   : stream_loopback.c
+ * 描述     : 主机端流式播放回环测试。固件的 haptic_host / haptic_rtp /
+ *            haptic_kick / haptic_thermal 原样编译到 PC 上，接到仿真 UART 链路
+ *            （460800 波特，每帧附加可配置的 USB/系统调度抖动，DMA 环形缓冲
+ *            溢出按覆盖处理）与仿真 DRV2605（寄存器文件，按 100kHz I2C 计入
+ *            总线耗时，记录每次 RTPIN 写入的时间与值）。主机侧按
+ *            haptic_link stream 的信用流控策略每 2ms 收发一次。
+ *            报告：端到端延迟（主机发出 → RTPIN 写入）、欠载/迟到/插零/
+ *            错序/丢失/链路溢出计数、输出节拍抖动；并在 1kHz 与 2kHz 下
+ *            比较过驱/刹车时长与热预算计入量，二者应与采样率无关。
+ *            全部在虚拟时间上运行，结果可复现。
+ * 编译     : gcc -O2 -DHAPTIC_USE_PROBE=1 -DHAPTIC_USE_KICK=1 -DHAPTIC_USE_SUPPLY=1
+ *            -DHAPTIC_USE_BANK=1 -DHAPTIC_USE_TUNE=1 -ITools/sim -IUser -IPeripheral/inc
+ *            -o stream_loopback Tools/stream_loopback.c
+ *            User/haptic_host.c User/haptic_rtp.c User/haptic_kick.c User/haptic_thermal.c
+ *            User/haptic_pattern.c User/haptic_swar.c
+ *            （开关见 haptic_config.h：主机协议的全部分支与过驱路径都要编入）
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "haptic_host.h"
+#include "haptic_bank.h"
+#include "haptic_tune.h"
+#include "haptic_resonance.h"
+#include "haptic_vbat.h"
+#include "drv2605_profile.h"
+
+#define SIM_CPU_HZ          48000000ULL
+#define SIM_CYCLES_PER_US   48U
+#define SIM_CPU_STEP        SIM_CYCLES_PER_US   /* 每读一次时间戳前进 1us，近似忙等一圈 */
+#define SIM_BAUD            460800ULL
+#define SIM_I2C_HZ          100000ULL
+#define SIM_LRA_HZ          170
+#define SIM_HOST_PERIOD_US  2000U               /* haptic_link stream 的读超时 */
+#define SIM_QUEUE           64
+#define SIM_RTP_CHUNK       48                  /* 与 haptic_link.cpp 的 kRtpChunk 相同 */
+#define SIM_MAX_SAMPLES     4000
+#define SIM_LOG_MAX         (SIM_MAX_SAMPLES * 2)
+
+#define US(x)               ((u64)(x) * SIM_CYCLES_PER_US)
+
+/* ========================= 虚拟时间 ========================= */
+
+static u64 s_now;
+static void Sim_Host(void);
+
+static void Sim_Advance(u64 cycles) {
+    s_now += cycles;
+    Sim_Host();
+}
+
+u32 HapticInstr_Cycles(void) {
+    Sim_Advance(SIM_CPU_STEP);
+    return (u32)s_now;
+}
+
+u32 HapticInstr_CyclesPerUs(void) {
+    return SIM_CYCLES_PER_US;
+}
+
+u32 HapticInstr_CyclesToUs(u32 cycles) {
+    return cycles / SIM_CYCLES_PER_US;
+}
+
+void HapticInstr_ProbeReset(HapticInstr_Probe *probe) {
+    memset(probe, 0, sizeof(*probe));
+    probe->min = 0xFFFFFFFFUL;
+}
+
+void HapticInstr_ProbeAdd(HapticInstr_Probe *probe, u32 cycles) {
+    probe->count++;
+    probe->total += cycles;
+    probe->min = (cycles < probe->min) ? cycles : probe->min;
+    probe->max = (cycles > probe->max) ? cycles : probe->max;
+}
+
+/* ========================= 仿真 DRV2605 ========================= */
+
+typedef struct {
+    u64 at;
+    u8 value;
+} Sim_Write;
+
+static u8 s_regs[DRV2605_REG_COUNT];
+static u8 s_known[DRV2605_REG_COUNT];
+static Sim_Write s_log[SIM_LOG_MAX];
+static u32 s_logCount;
+
+/* 起始 + 地址字节 + 数据字节（各 9 位）+ 停止 */
+static void Sim_I2c(u8 bytes) {
+    Sim_Advance(((u64)bytes * 9U + 2U) * SIM_CPU_HZ / SIM_I2C_HZ);
+}
+
+ErrorStatus DRV2605_WriteRegisters(DRV2605_Register startReg, const u8 *values, u8 count) {
+    Sim_I2c((u8)(count + 2));
+    for(u8 i = 0; i < count && startReg + i < DRV2605_REG_COUNT; i++) {
+        s_regs[startReg + i] = values[i];
+        s_known[startReg + i] = 1;
+    }
+    if(startReg == DRV2605_REG_RTPIN && count == 1 && s_logCount < SIM_LOG_MAX) {
+        s_log[s_logCount].at = s_now;
+        s_log[s_logCount].value = values[0];
+        s_logCount++;
+    }
+    return READY;
+}
+
+ErrorStatus DRV2605_ReadRegister(DRV2605_Register reg, u8 *value) {
+    Sim_I2c(4);
+    *value = s_regs[reg];
+    return READY;
+}
+
+ErrorStatus DRV2605_GetShadowRegister(DRV2605_Register reg, u8 *value) {
+    if(reg >= DRV2605_REG_COUNT || !s_known[reg]) {
+        return NoREADY;
+    }
+    *value = s_regs[reg];
+    return READY;
+}
+
+ErrorStatus DRV2605_SetRealtimeValue(u8 value) {
+    return DRV2605_WriteRegisters(DRV2605_REG_RTPIN, &value, 1);
+}
+
+ErrorStatus DRV2605_PrepareFreqAmpRealtime(void) {
+    u8 mode = DRV2605_MODE_REALTIME;
+    return DRV2605_WriteRegisters(DRV2605_REG_MODE, &mode, 1);
+}
+
+ErrorStatus DRV2605_Start(void) {
+    u8 go = 1;
+    return DRV2605_WriteRegisters(DRV2605_REG_GO, &go, 1);
+}
+
+u16 DRV2605_GetResonanceHz(void) {
+    return SIM_LRA_HZ;
+}
+
+u8 DRV2605_GetSupplyGain(void) {
+    return 128;
+}
+
+/* 以下命令不在本测试范围内 */
+ErrorStatus DRV2605_ApplyProfile(DRV2605_ProfileId id) {
+    return NoREADY;
+}
+
+ErrorStatus DRV2605_StageRomSequence(DRV2605_Library libraryId, const DRV2605_Effect *effects, u8 count) {
+    return NoREADY;
+}
+
+ErrorStatus DRV2605_CommitRomTransition(void) {
+    return NoREADY;
+}
+
+void HapticResonance_Poll(void) {
+}
+
+u8 HapticResonance_Version(void) {
+    return 0;
+}
+
+void HapticVbat_Poll(void) {
+}
+
+static const HapticBank_Info s_bankInfo = { HAPTIC_BANK_NONE, 0, 0, 0 };
+
+const HapticBank_Info *HapticBank_GetInfo(void) {
+    return &s_bankInfo;
+}
+
+ErrorStatus HapticBank_Get(u8 index, HapticPattern *pattern) {
+    return NoREADY;
+}
+
+ErrorStatus HapticBank_Begin(u16 size) {
+    return NoREADY;
+}
+
+u16 HapticBank_Written(void) {
+    return 0;
+}
+
+ErrorStatus HapticBank_Put(u8 value) {
+    return NoREADY;
+}
+
+ErrorStatus HapticBank_Commit(u16 crc) {
+    return NoREADY;
+}
+
+ErrorStatus HapticTune_GetField(u8 field, u16 *value) {
+    return NoREADY;
+}
+
+ErrorStatus HapticTune_SetField(u8 field, u16 value) {
+    return NoREADY;
+}
+
+ErrorStatus HapticTune_Save(void) {
+    return NoREADY;
+}
+
+/* ========================= 仿真链路 ========================= */
+
+typedef struct {
+    u64 at;       /* 最后一个字节到达对端的时间 */
+    u8 len;
+    u8 data[HAPTIC_LINK_MAX_PAYLOAD];
+} Sim_Frame;
+
+typedef struct {
+    Sim_Frame q[SIM_QUEUE];
+    u16 head;
+    u16 tail;
+    u64 wireFree;  /* 线路空闲时刻 */
+} Sim_Channel;
+
+static Sim_Channel s_toDevice;
+static Sim_Channel s_toHost;
+static u32 s_jitterUs;
+static u8 s_rxFrame[HAPTIC_LINK_MAX_PAYLOAD];
+static u64 s_rxFrameAt;
+static HapticLink_Stats s_linkStats;
+
+/* 线上字节：负载 + CRC16 + COBS 开销 1 + 两个帧界，每字节 10 位 */
+static u64 Sim_WireCycles(u8 len) {
+    return ((u64)len + 5U) * 10U * SIM_CPU_HZ / SIM_BAUD;
+}
+
+/* 每帧先经过 0~jitter 的 USB/调度延迟再上线，线路上保持先后顺序 */
+static void Sim_Post(Sim_Channel *ch, const u8 *data, u8 len) {
+    Sim_Frame *frame = &ch->q[ch->tail % SIM_QUEUE];
+    u64 start = s_now + (s_jitterUs ? US(rand() % (s_jitterUs + 1)) : 0);
+
+    if((u16)(ch->tail - ch->head) >= SIM_QUEUE) {
+        fprintf(stderr, "sim queue full\n");
+        exit(2);
+    }
+    if(start < ch->wireFree) {
+        start = ch->wireFree;
+    }
+    frame->at = start + Sim_WireCycles(len);
+    frame->len = len;
+    memcpy(frame->data, data, len);
+    ch->wireFree = frame->at;
+    ch->tail++;
+}
+
+static Sim_Frame *Sim_Arrived(Sim_Channel *ch) {
+    if(ch->head == ch->tail || ch->q[ch->head % SIM_QUEUE].at > s_now) {
+        return NULL;
+    }
+    return &ch->q[ch->head % SIM_QUEUE];
+}
+
+void HapticLink_Init(void) {
+    memset(&s_toDevice, 0, sizeof(s_toDevice));
+    memset(&s_toHost, 0, sizeof(s_toHost));
+    memset(&s_linkStats, 0, sizeof(s_linkStats));
+}
+
+/* 已到达未处理的字节超过 DMA 环形缓冲时整段丢弃，与固件的溢出恢复一致 */
+u8 HapticLink_Poll(HapticLink_Handler handler, void *ctx) {
+    u32 pending = 0;
+    u8 dispatched = 0;
+    Sim_Frame *frame;
+
+    Sim_Advance(SIM_CPU_STEP);
+    for(u16 i = s_toDevice.head; i != s_toDevice.tail && s_toDevice.q[i % SIM_QUEUE].at <= s_now; i++) {
+        pending += s_toDevice.q[i % SIM_QUEUE].len + 5U;
+    }
+    if(pending > HAPTIC_LINK_RX_SIZE) {
+        s_linkStats.overruns++;
+        while(Sim_Arrived(&s_toDevice) != NULL) {
+            s_toDevice.head++;
+        }
+        return 0;
+    }
+
+    while((frame = Sim_Arrived(&s_toDevice)) != NULL) {
+        HapticLink_Reader reader;
+        memcpy(s_rxFrame, frame->data, frame->len);
+        s_rxFrameAt = frame->at;
+        reader.pos = 0;
+        reader.end = frame->len;
+        reader.remain = frame->len;
+        reader.blockLeft = 0;
+        reader.zeroAfter = 0;
+        s_toDevice.head++;
+        s_linkStats.frames++;
+        s_linkStats.bytes += frame->len + 5U;
+        dispatched++;
+        if(handler != NULL) {
+            handler(ctx, &reader);
+        }
+    }
+    return dispatched;
+}
+
+u8 HapticLink_ReadByte(HapticLink_Reader *reader, u8 *value) {
+    if(reader->remain == 0 || reader->pos >= reader->end) {
+        return 0;
+    }
+    *value = s_rxFrame[reader->pos++];
+    reader->remain--;
+    return 1;
+}
+
+u16 HapticLink_Read(HapticLink_Reader *reader, u8 *dst, u16 count) {
+    u16 done = 0;
+    u8 value;
+
+    while(done < count && HapticLink_ReadByte(reader, &value)) {
+        if(dst != NULL) {
+            dst[done] = value;
+        }
+        done++;
+    }
+    return done;
+}
+
+u16 HapticLink_Remaining(const HapticLink_Reader *reader) {
+    return reader->remain;
+}
+
+u32 HapticLink_FrameCycles(void) {
+    return (u32)s_rxFrameAt;
+}
+
+ErrorStatus HapticLink_Send(const u8 *payload, u16 length) {
+    if(length > HAPTIC_LINK_MAX_PAYLOAD) {
+        return NoREADY;
+    }
+    Sim_Post(&s_toHost, payload, (u8)length);
+    return READY;
+}
+
+const HapticLink_Stats *HapticLink_GetStats(void) {
+    return &s_linkStats;
+}
+
+/* ========================= 主机流控 ========================= */
+
+/* 与 Tools/haptic_link.cpp 的 runStream 相同：只发送序号 < 信用边界的样本 */
+typedef struct {
+    u8 active;
+    u8 seq;
+    u8 creditValid;
+    u8 stopSent;
+    u16 prebuffer;
+    u16 rateHz;
+    u16 baseEdge;
+    u16 lastConsumed16;
+    u32 total;
+    u32 sent;
+    u32 consumed;
+    u32 rejected;
+    u64 nextWake;
+    const u8 *samples;
+    u64 sentAt[SIM_MAX_SAMPLES];
+} Sim_Streamer;
+
+static Sim_Streamer s_host;
+
+static void Sim_HostSend(const u8 *payload, u8 len) {
+    Sim_Post(&s_toDevice, payload, len);
+}
+
+static void Sim_HostReceive(void) {
+    Sim_Frame *frame;
+
+    while((frame = Sim_Arrived(&s_toHost)) != NULL) {
+        const u8 *d = frame->data;
+        if(frame->len >= 8 && d[1] == HAPTIC_HOST_CREDIT) {
+            u16 edge = (u16)(d[2] | (d[3] << 8));
+            if(!s_host.creditValid) {
+                s_host.baseEdge = (u16)(edge - HAPTIC_HOST_RTP_FIFO);
+                s_host.creditValid = 1;
+            }
+            u16 consumed16 = (u16)(edge - HAPTIC_HOST_RTP_FIFO - s_host.baseEdge);
+            s_host.consumed += (u16)(consumed16 - s_host.lastConsumed16);
+            s_host.lastConsumed16 = consumed16;
+        } else if(frame->len >= 4 && d[1] == HAPTIC_HOST_REPLY && d[2] == 0) {
+            s_host.rejected++;
+        }
+        s_toHost.head++;
+    }
+}
+
+static void Sim_Host(void) {
+    static u8 busy;
+    u8 frame[HAPTIC_LINK_MAX_PAYLOAD];
+
+    if(!s_host.active || busy || s_now < s_host.nextWake) {
+        return;
+    }
+    busy = 1;
+    s_host.nextWake = s_now + US(SIM_HOST_PERIOD_US);
+    Sim_HostReceive();
+
+    if(s_host.seq == 0) {
+        frame[0] = ++s_host.seq;
+        frame[1] = HAPTIC_HOST_OP_STREAM;
+        frame[2] = 3;
+        frame[3] = (u8)s_host.prebuffer;
+        frame[4] = (u8)s_host.rateHz;
+        frame[5] = (u8)(s_host.rateHz >> 8);
+        Sim_HostSend(frame, 6);
+    } else if(s_host.creditValid) {
+        u32 window = s_host.consumed + HAPTIC_HOST_RTP_FIFO;
+        while(s_host.sent < s_host.total && s_host.sent < window) {
+            u32 n = window - s_host.sent;
+            if(n > s_host.total - s_host.sent) {
+                n = s_host.total - s_host.sent;
+            }
+            if(n > SIM_RTP_CHUNK) {
+                n = SIM_RTP_CHUNK;
+            }
+            frame[0] = ++s_host.seq;
+            frame[1] = HAPTIC_HOST_OP_RTP;
+            frame[2] = (u8)n;
+            memcpy(&frame[3], s_host.samples + s_host.sent, n);
+            Sim_HostSend(frame, (u8)(n + 3));
+            for(u32 i = 0; i < n; i++) {
+                s_host.sentAt[s_host.sent + i] = s_now;
+            }
+            s_host.sent += n;
+        }
+        if(s_host.sent == s_host.total && !s_host.stopSent) {
+            frame[0] = ++s_host.seq;
+            frame[1] = HAPTIC_HOST_OP_STREAM_STOP;
+            frame[2] = 0;
+            Sim_HostSend(frame, 3);
+            s_host.stopSent = 1;
+        }
+    }
+    busy = 0;
+}
+
+/* ========================= 场景 ========================= */
+
+typedef struct {
+    u16 rateHz;
+    u16 prebuffer;
+    u32 jitterUs;
+    u8 mustBeClean;  /* 预缓冲覆盖抖动的名义场景：任何毛刺都算失败 */
+} Sim_Scenario;
+
+static const Sim_Scenario s_scenarios[] = {
+    { 1000, 32,     0, 1 },
+    { 1000, 32,  8000, 1 },
+    { 1000, 16, 60000, 0 },
+    { 2000, 32,     0, 1 },
+    { 2000, 64, 12000, 1 },
+    { 2000, 16, 40000, 0 },
+};
+
+static u8 s_stream[SIM_MAX_SAMPLES];
+
+static void Sim_ResetDevice(void) {
+    static const HapticRtp_Suppress writeAll = { DISABLE, 0, 0 };
+
+    memset(s_regs, 0, sizeof(s_regs));
+    memset(s_known, 0, sizeof(s_known));
+    s_logCount = 0;
+    HapticRtp_SetSuppress(&writeAll);   /* 每个样本都落到 RTPIN，便于逐个比对 */
+    HapticRtp_ResetStats();
+}
+
+static int Sim_RunScenario(const Sim_Scenario *sc) {
+    u32 total = (u32)sc->rateHz * 2U;   /* 2 秒 */
+    u64 period = SIM_CPU_HZ / sc->rateHz;
+    u64 deadline;
+    u32 k = 0;
+    u32 gaps = 0;
+    u32 mismatch = 0;
+    u64 latencySum = 0;
+    u64 latencyMax = 0;
+    u64 beatMax = 0;
+    int clean;
+
+    Sim_ResetDevice();
+    s_jitterUs = sc->jitterUs;
+    HapticHost_Init();
+    memset(&s_host, 0, sizeof(s_host));
+    for(u32 i = 0; i < total; i++) {
+        s_stream[i] = (u8)(1 + (i * 7U) % 0x7F);   /* 1~0x7F，不含 0，便于区分插零 */
+    }
+    s_host.samples = s_stream;
+    s_host.total = total;
+    s_host.rateHz = sc->rateHz;
+    s_host.prebuffer = sc->prebuffer;
+    s_host.nextWake = s_now;
+    s_host.active = 1;
+
+    deadline = s_now + US(1000000UL) * 4U;
+    while(s_now < deadline && !(s_host.stopSent && s_host.consumed >= total)) {
+        HapticHost_Poll();
+    }
+    s_host.active = 0;
+
+    /* 按值顺序把 RTPIN 写入与流样本对齐；开播后、放完前的 0 是欠载插入的静音 */
+    for(u32 i = 0; i < s_logCount; i++) {
+        const Sim_Write *w = &s_log[i];
+        if(i > 0 && k > 0 && k < total) {
+            u64 interval = w->at - s_log[i - 1].at;
+            u64 dev = (interval > period) ? interval - period : period - interval;
+            beatMax = (dev > beatMax) ? dev : beatMax;
+        }
+        if(w->value == 0) {
+            if(k > 0 && k < total) {
+                gaps++;
+            }
+            continue;
+        }
+        if(k >= total) {
+            mismatch++;
+            continue;
+        }
+        if(w->value != s_stream[k]) {
+            mismatch++;
+        }
+        u64 latency = w->at - s_host.sentAt[k];
+        latencySum += latency;
+        latencyMax = (latency > latencyMax) ? latency : latencyMax;
+        k++;
+    }
+
+    u32 underruns = HapticHost_GetUnderruns();
+    u32 late = HapticRtp_GetStats()->late;
+    u32 missing = total - k;
+    clean = !(underruns || late || gaps || mismatch || missing ||
+              s_linkStats.overruns || s_host.rejected);
+
+    printf("%5u Hz  pre %3u  jitter %5.1f ms | latency avg %6.2f max %6.2f ms | "
+           "underrun %3u late %3u gap %4u order %u miss %u ovr %u rej %u | beat %4.0f us  %s\n",
+           sc->rateHz, sc->prebuffer, sc->jitterUs / 1000.0,
+           k ? (double)latencySum / k / (SIM_CPU_HZ / 1000.0) : 0.0,
+           (double)latencyMax / (SIM_CPU_HZ / 1000.0),
+           underruns, late, gaps, mismatch, missing, s_linkStats.overruns, s_host.rejected,
+           (double)beatMax / SIM_CYCLES_PER_US,
+           clean ? "clean" : (sc->mustBeClean ? "FAIL" : "glitches counted"));
+    return (sc->mustBeClean && !clean) ? 1 : 0;
+}
+
+/* ========================= 与采样率无关的级 ========================= */
+
+typedef struct {
+    u32 pos;
+    u32 total;
+    u32 riseAt;
+    u32 fallAt;
+    u8 level;
+} Sim_Step;
+
+/* 0 → level（riseAt）→ 0（fallAt），样本位置由毫秒换算 */
+static u16 Sim_StepSource(void *ctx, u8 *samples, u16 count) {
+    Sim_Step *step = (Sim_Step *)ctx;
+    u16 n = 0;
+
+    while(n < count && step->pos < step->total) {
+        samples[n++] = (step->pos >= step->riseAt && step->pos < step->fallAt) ? step->level : 0;
+        step->pos++;
+    }
+    return n;
+}
+
+static const HapticKick_Config s_kickCfg = {
+    .kickLevel = 128,
+    .kickHalfCycles = 2,
+    .brakeLevel = 128,
+    .brakeHalfCycles = 2,
+    .edgeThreshold = 0x10,
+    .brakeMode = HAPTIC_KICK_BRAKE_REVERSE
+};
+
+static const HapticThermal_Config s_thermalCfg = { 0x40, 2000 };
+
+/* 在 sampleHz 下播放阶跃，返回过驱/刹车时长（us）与热预算计入量 */
+static void Sim_RateStages(u16 sampleHz, double *kickUs, double *brakeUs, u32 *energy) {
+    static HapticKick kick;
+    static HapticThermal thermal;
+    Sim_Step step = { 0, sampleHz * 3U / 5U, sampleHz / 50U, sampleHz * 13U / 25U, 0x60 };   /* 600ms，20ms 起，520ms 止 */
+    u64 period = SIM_CPU_HZ / sampleHz;
+    u32 kickSamples = 0;
+    u32 brakeSamples = 0;
+
+    Sim_ResetDevice();
+    HapticKick_Init(&kick, &s_kickCfg);
+    HapticThermal_Init(&thermal, &s_thermalCfg);
+    HapticRtp_SetKick(&kick);
+    HapticRtp_SetThermal(&thermal);
+    HapticRtp_PlayRate(Sim_StepSource, &step, sampleHz);
+    HapticRtp_SetKick(NULL);
+    HapticRtp_SetThermal(NULL);
+
+    for(u32 i = 0; i < s_logCount; i++) {
+        u8 v = s_log[i].value;
+        if(v >= 0x80) {
+            brakeSamples++;
+        } else if(v > step.level) {
+            kickSamples++;
+        }
+    }
+    *kickUs = (double)kickSamples * period / SIM_CYCLES_PER_US;
+    *brakeUs = (double)brakeSamples * period / SIM_CYCLES_PER_US;
+    /* 泄放按真实流逝时间进行，两种采样率播放时长相同，直接比较桶内能量 */
+    *energy = thermal.energy;
+}
+
+static int Sim_CheckRates(void) {
+    double kick1;
+    double brake1;
+    double kick2;
+    double brake2;
+    u32 energy1;
+    u32 energy2;
+    double halfCycleUs = 1e6 / (2.0 * SIM_LRA_HZ);
+    int fail;
+
+    Sim_RateStages(1000, &kick1, &brake1, &energy1);
+    Sim_RateStages(2000, &kick2, &brake2, &energy2);
+
+    printf("kick  1kHz %6.0f us  2kHz %6.0f us  (2 half cycles @%u Hz = %.0f us)\n",
+           kick1, kick2, SIM_LRA_HZ, 2 * halfCycleUs);
+    printf("brake 1kHz %6.0f us  2kHz %6.0f us\n", brake1, brake2);
+    printf("thermal energy 1kHz %lu  2kHz %lu\n", (unsigned long)energy1, (unsigned long)energy2);
+
+    /* 时长允许差一个 1kHz 样本的取整，能量允许 1% */
+    fail = (kick2 < kick1 - 1000 || kick2 > kick1 + 1000) ||
+           (brake2 < brake1 - 1000 || brake2 > brake1 + 1000) ||
+           (energy2 < energy1 - energy1 / 100 || energy2 > energy1 + energy1 / 100);
+    printf("rate-independent stages: %s\n", fail ? "FAIL" : "ok");
+    return fail;
+}
+
+int main(void) {
+    int failures = 0;
+
+    srand(1);
+    for(size_t i = 0; i < sizeof(s_scenarios) / sizeof(s_scenarios[0]); i++) {
+        failures += Sim_RunScenario(&s_scenarios[i]);
+    }
+    failures += Sim_CheckRates();
+    return failures ? 1 : 0;
+}
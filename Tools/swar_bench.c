@@ -0,0 +1,143 @@
+/******************************************************************************
+ * 文件名   : swar_bench.c
+ * 描述     : 主机端 SWAR 核基准：与逐样本标量循环比较结果与耗时。
+ *            主机有硬件乘法，结果只反映访存/分支的差别；目标板数据见
+ *            main.c 中 Demo_Swar 的 TIM2 探针输出。关闭自动向量化，
+ *            避免主机 SIMD 掩盖标量循环的真实开销。
+ * 编译     : gcc -O2 -fno-tree-vectorize -DHAPTIC_SWAR_HOST -IUser -o swar_bench Tools/swar_bench.c User/haptic_swar.c
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "haptic_swar.h"
+
+#define BLOCK        16
+#define ROUNDS       2000000L
+
+static void Scalar_Gain(u8 *samples, u16 count, u8 gain) {
+    for(u16 i = 0; i < count; i++) {
+        u16 v = (u16)((samples[i] * gain) >> 7);
+        samples[i] = (u8)((v > 0x7F) ? 0x7F : v);
+    }
+}
+
+static u16 Scalar_SatAdd(u8 *dst, const u8 *src, u16 count) {
+    u16 clipped = 0;
+    for(u16 i = 0; i < count; i++) {
+        u16 v = (u16)(dst[i] + src[i]);
+        if(v > 0x7F) {
+            v = 0x7F;
+            clipped++;
+        }
+        dst[i] = (u8)v;
+    }
+    return clipped;
+}
+
+static void Scalar_Clamp7(u8 *samples, u16 count) {
+    for(u16 i = 0; i < count; i++) {
+        if(samples[i] > 0x7F) {
+            samples[i] = 0x7F;
+        }
+    }
+}
+
+static u32 Scalar_ChangedMask(const u8 *samples, u16 count, u8 previous, u8 threshold) {
+    u32 mask = 0;
+    for(u16 i = 0; i < count; i++) {
+        u8 d = (u8)((samples[i] > previous) ? samples[i] - previous : previous - samples[i]);
+        if(d > threshold) {
+            mask |= 1UL << i;
+        }
+        previous = samples[i];
+    }
+    return mask;
+}
+
+static void Fill7(u8 *buf, u16 count) {
+    for(u16 i = 0; i < count; i++) {
+        buf[i] = (u8)(rand() & 0x7F);
+    }
+}
+
+/* 随机数据 + 各种对齐/长度下与标量结果逐字节比较 */
+static unsigned Verify(void) {
+    u32 storeA[12];
+    u32 storeB[12];
+    u8 ref[48];
+    u8 *a = (u8 *)storeA;
+    u8 *b = (u8 *)storeB;
+    unsigned errors = 0;
+
+    for(int iter = 0; iter < 200000; iter++) {
+        u16 off = (u16)(rand() & 3);
+        u16 offB = (iter & 1) ? off : (u16)(rand() & 3);
+        u16 count = (u16)(rand() % 33);
+        u8 gain = (u8)rand();
+        u8 threshold = (u8)(rand() & 0x7F);
+        u8 previous = (u8)(rand() & 0x7F);
+
+        Fill7(a + off, count);
+        Fill7(b + offB, count);
+
+        memcpy(ref, a + off, count);
+        Scalar_Gain(ref, count, gain);
+        HapticSwar_Gain(a + off, count, gain);
+        errors += memcmp(ref, a + off, count) != 0;
+
+        memcpy(ref, a + off, count);
+        u16 c1 = Scalar_SatAdd(ref, b + offB, count);
+        u16 c2 = HapticSwar_SatAdd(a + off, b + offB, count);
+        errors += (c1 != c2) || memcmp(ref, a + off, count) != 0;
+
+        errors += Scalar_ChangedMask(b + offB, count, previous, threshold) !=
+                  HapticSwar_ChangedMask(b + offB, count, previous, threshold);
+
+        for(u16 i = 0; i < count; i++) {
+            a[off + i] = (u8)rand();
+        }
+        memcpy(ref, a + off, count);
+        Scalar_Clamp7(ref, count);
+        HapticSwar_Clamp7(a + off, count);
+        errors += memcmp(ref, a + off, count) != 0;
+    }
+    return errors;
+}
+
+static double Seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+#define BENCH(label, expr) do {                                              \
+        clock_t t0 = clock();                                                \
+        for(long r = 0; r < ROUNDS; r++) {                                   \
+            expr;                                                            \
+            __asm__ volatile("" ::: "memory");                               \
+        }                                                                    \
+        printf("%-20s %6.2f ns/sample\n", label,                             \
+               Seconds(t0) * 1e9 / ((double)ROUNDS * BLOCK));                \
+    } while(0)
+
+int main(void) {
+    u32 storeA[BLOCK / 4];
+    u32 storeB[BLOCK / 4];
+    u8 *a = (u8 *)storeA;
+    u8 *b = (u8 *)storeB;
+    volatile u32 sink = 0;
+
+    srand(1);
+    printf("verify: %u mismatches\n", Verify());
+
+    Fill7(a, BLOCK);
+    Fill7(b, BLOCK);
+    BENCH("gain scalar", Scalar_Gain(a, BLOCK, 200));
+    BENCH("gain swar", HapticSwar_Gain(a, BLOCK, 200));
+    BENCH("satadd scalar", sink += Scalar_SatAdd(a, b, BLOCK));
+    BENCH("satadd swar", sink += HapticSwar_SatAdd(a, b, BLOCK));
+    BENCH("clamp scalar", Scalar_Clamp7(a, BLOCK));
+    BENCH("clamp swar", HapticSwar_Clamp7(a, BLOCK));
+    BENCH("delta scalar", sink += Scalar_ChangedMask(b, BLOCK, 0x20, 2));
+    BENCH("delta swar", sink += HapticSwar_ChangedMask(b, BLOCK, 0x20, 2));
+    return 0;
+}
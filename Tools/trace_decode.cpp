@@ -0,0 +1,361 @@
+/******************************************************************************
+ * 文件名   : trace_decode.cpp
+ * 描述     : 主机端 trace 解码：读取设备串口（或抓包文件）中的二进制记录，
+ *            按 User/haptic_trace_ids.h 的字典还原为带时间戳的文本。
+ *            字典在编译本工具时从固件头文件生成，两边改动须同时重新编译。
+ *            记录格式见 User/haptic_trace.h；0x00 定界的链路帧默认跳过。
+ * 编译     : g++ -std=c++17 -O2 -o trace_decode Tools/trace_decode.cpp
+ * 用法     : trace_decode [--port /dev/ttyUSB0] [--baud 460800] [--frames]
+ *            trace_decode --file capture.bin [--frames]
+ *            trace_decode --dict             打印字典（编号、参数个数、格式串）
+ ******************************************************************************/
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "../User/haptic_trace_ids.h"
+
+namespace {
+
+struct Event {
+    const char *name;
+    const char *format;
+};
+
+const Event kEvents[] = {
+#define TRACE_DICT_ENTRY(id, fmt) {#id, fmt},
+    HAPTIC_TRACE_EVENTS(TRACE_DICT_ENTRY)
+#undef TRACE_DICT_ENTRY
+};
+
+const size_t kEventCount = sizeof(kEvents) / sizeof(kEvents[0]);
+const uint8_t kMarker = 0xA0;       // HAPTIC_TRACE_MARKER
+const uint8_t kMaxArgs = 4;         // HAPTIC_TRACE_MAX_ARGS
+const size_t kBootEvent = 0;        // HAPTIC_EV_BOOT：clk, chip, cyc/us, count
+const uint32_t kDefaultCyclesPerUs = 48;
+
+struct Options {
+    std::string port = "/dev/ttyUSB0";
+    std::string file;
+    int baud = 460800;
+    bool frames = false;
+    bool dict = false;
+};
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: trace_decode [--port dev] [--baud n] [--file capture] [--frames] [--dict]\n");
+    std::exit(2);
+}
+
+// 统计格式串中的转换个数（%% 不计）
+size_t countArgs(const char *fmt) {
+    size_t n = 0;
+    for (const char *p = fmt; *p; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        if (p[1] == '%') {
+            p++;
+            continue;
+        }
+        n++;
+    }
+    return n;
+}
+
+// 逐个转换交给 snprintf；参数按 32 位原始值解释，%d 视为有符号
+std::string render(const char *fmt, const uint32_t *args, size_t argc) {
+    std::string out;
+    size_t next = 0;
+    for (const char *p = fmt; *p; p++) {
+        if (*p != '%') {
+            out += *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out += '%';
+            p++;
+            continue;
+        }
+        std::string spec = "%";
+        p++;
+        while (*p && std::strchr("-+ #0123456789.", *p)) {
+            spec += *p++;
+        }
+        while (*p == 'l' || *p == 'h') {
+            p++;   // 设备端一律 32 位
+        }
+        if (!*p) {
+            break;
+        }
+        char conv = *p;
+        uint32_t v = (next < argc) ? args[next] : 0;
+        next++;
+        char buf[32];
+        spec += conv;
+        if (conv == 'd' || conv == 'i') {
+            std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<int>(static_cast<int32_t>(v)));
+        } else if (conv == 'c') {
+            std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<int>(v & 0xFF));
+        } else if (conv == 'u' || conv == 'x' || conv == 'X') {
+            std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<unsigned>(v));
+        } else {
+            std::snprintf(buf, sizeof(buf), "<%%%c?>", conv);
+        }
+        out += buf;
+    }
+    return out;
+}
+
+uint32_t le32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+class Decoder {
+public:
+    explicit Decoder(bool showFrames) : showFrames_(showFrames) {}
+
+    void feed(const uint8_t *data, size_t length) {
+        pending_.insert(pending_.end(), data, data + length);
+        size_t pos = 0;
+        while (pos < pending_.size()) {
+            size_t used = step(pos);
+            if (used == 0) {
+                break;   // 记录不完整，等待更多数据
+            }
+            pos += used;
+        }
+        pending_.erase(pending_.begin(), pending_.begin() + pos);
+    }
+
+    void finish() {
+        if (!pending_.empty()) {
+            skipped_ += pending_.size();
+            pending_.clear();
+        }
+        flushSkipped();
+        std::fprintf(stderr, "%zu records, %zu link frames, %zu bytes skipped\n",
+                     records_, frames_, skippedTotal_);
+    }
+
+private:
+    // 从 pos 解析一个单元，返回消耗的字节数；0 表示需要更多数据
+    size_t step(size_t pos) {
+        const uint8_t head = pending_[pos];
+        if (head == 0x00) {
+            return frame(pos);
+        }
+        if ((head & 0xF8) != kMarker || (head & 0x07) > kMaxArgs) {
+            skipped_++;
+            skippedTotal_++;
+            return 1;
+        }
+        size_t argc = head & 0x07;
+        size_t length = 6 + 4 * argc;
+        if (pending_.size() - pos < length) {
+            return 0;
+        }
+        flushSkipped();
+        const uint8_t *p = &pending_[pos];
+        uint32_t args[kMaxArgs] = {};
+        for (size_t i = 0; i < argc; i++) {
+            args[i] = le32(p + 6 + 4 * i);
+        }
+        record(p[1], le32(p + 2), args, argc);
+        return length;
+    }
+
+    // 0x00 <COBS> 0x00：链路应答帧，整体跳过
+    size_t frame(size_t pos) {
+        size_t end = pos + 1;
+        while (end < pending_.size() && pending_[end] != 0x00) {
+            end++;
+        }
+        if (end >= pending_.size()) {
+            return 0;
+        }
+        if (end == pos + 1) {
+            return 1;   // 连续 0x00，视为空帧
+        }
+        flushSkipped();
+        frames_++;
+        if (showFrames_) {
+            std::printf("%s<link frame, %zu bytes>\n", stamp().c_str(), end - pos - 1);
+        }
+        return end - pos + 1;
+    }
+
+    void record(uint8_t id, uint32_t cycles, const uint32_t *args, size_t argc) {
+        if (id == kBootEvent && argc == 4) {
+            // 设备复位：重新建立时间基准
+            started_ = false;
+            cyclesPerUs_ = args[2] ? args[2] : kDefaultCyclesPerUs;
+        }
+        if (!started_) {
+            started_ = true;
+            elapsed_ = 0;
+        } else {
+            elapsed_ += static_cast<uint32_t>(cycles - lastCycles_);   // 32 位差值展开回绕
+        }
+        lastCycles_ = cycles;
+        records_++;
+
+        if (id >= kEventCount) {
+            std::printf("%s<unknown event %u, %zu args>\n", stamp().c_str(), id, argc);
+            return;
+        }
+        const Event &ev = kEvents[id];
+        const char *fmt = ev.format;
+        while (*fmt == '\n') {
+            std::printf("\n");
+            fmt++;
+        }
+        if (countArgs(fmt) != argc) {
+            std::printf("%s<%s: expected %zu args, got %zu>\n", stamp().c_str(), ev.name,
+                        countArgs(fmt), argc);
+            return;
+        }
+        std::printf("%s%s\n", stamp().c_str(), render(fmt, args, argc).c_str());
+        if (id == kBootEvent && args[3] != kEventCount) {
+            std::printf("warning: device dictionary has %u events, decoder has %zu; rebuild trace_decode\n",
+                        args[3], kEventCount);
+        }
+    }
+
+    std::string stamp() const {
+        uint64_t us = elapsed_ / cyclesPerUs_;
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "[%llu.%03llu] ",
+                      static_cast<unsigned long long>(us / 1000),
+                      static_cast<unsigned long long>(us % 1000));
+        return buf;
+    }
+
+    void flushSkipped() {
+        if (skipped_ != 0) {
+            std::printf("<skipped %zu bytes>\n", skipped_);
+            skipped_ = 0;
+        }
+    }
+
+    bool showFrames_;
+    std::vector<uint8_t> pending_;
+    bool started_ = false;
+    uint32_t lastCycles_ = 0;
+    uint64_t elapsed_ = 0;
+    uint32_t cyclesPerUs_ = kDefaultCyclesPerUs;
+    size_t skipped_ = 0;
+    size_t skippedTotal_ = 0;
+    size_t records_ = 0;
+    size_t frames_ = 0;
+};
+
+speed_t baudConstant(int baud) {
+    switch (baud) {
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return 0;
+    }
+}
+
+int openPort(const std::string &port, int baud) {
+    int fd = ::open(port.c_str(), O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+        std::fprintf(stderr, "cannot open %s: %s\n", port.c_str(), std::strerror(errno));
+        std::exit(1);
+    }
+    termios tio{};
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    speed_t speed = baudConstant(baud);
+    if (speed == 0) {
+        std::fprintf(stderr, "unsupported baud %d\n", baud);
+        std::exit(1);
+    }
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+    return fd;
+}
+
+Options parseArgs(int argc, char **argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) {
+            opt.port = argv[++i];
+        } else if (arg == "--baud" && i + 1 < argc) {
+            opt.baud = std::atoi(argv[++i]);
+        } else if (arg == "--file" && i + 1 < argc) {
+            opt.file = argv[++i];
+        } else if (arg == "--frames") {
+            opt.frames = true;
+        } else if (arg == "--dict") {
+            opt.dict = true;
+        } else {
+            usage();
+        }
+    }
+    return opt;
+}
+
+void printDict() {
+    for (size_t i = 0; i < kEventCount; i++) {
+        std::string fmt;
+        for (const char *p = kEvents[i].format; *p; p++) {
+            fmt += (*p == '\n') ? std::string("\\n") : std::string(1, *p);
+        }
+        std::printf("%3zu %-28s %zu \"%s\"\n", i, kEvents[i].name, countArgs(kEvents[i].format),
+                    fmt.c_str());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opt = parseArgs(argc, argv);
+    if (opt.dict) {
+        printDict();
+        return 0;
+    }
+
+    int fd;
+    if (!opt.file.empty()) {
+        fd = (opt.file == "-") ? STDIN_FILENO : ::open(opt.file.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::fprintf(stderr, "cannot open %s: %s\n", opt.file.c_str(), std::strerror(errno));
+            return 1;
+        }
+    } else {
+        fd = openPort(opt.port, opt.baud);
+    }
+
+    Decoder decoder(opt.frames);
+    uint8_t buf[256];
+    while (true) {
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
+        }
+        decoder.feed(buf, static_cast<size_t>(n));
+        std::fflush(stdout);
+    }
+    decoder.finish();
+    if (fd != STDIN_FILENO) {
+        ::close(fd);
+    }
+    return 0;
+}
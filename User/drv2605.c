@@ -3,24 +3,74 @@
  * 描述     : DRV2605 震动驱动器操作库（仅包含写入/配置功能）。
  ******************************************************************************/
 #include "drv2605.h"
+#include "drv2605_script.h"
 
 #define I2C_TIMEOUT_CYC      0x4FFF
 #define DRV2605_RATEDV_STEP_UV  21330UL
 #define DRV2605_CLAMPV_STEP_UV  5600UL
+#define DRV2605_BURST_MAX       16
 
 static ErrorStatus DRV2605_I2C_WriteBytes(const u8 *data, u8 length);
+static ErrorStatus DRV2605_I2C_Transmit(const u8 *data, u8 length);
 static ErrorStatus DRV2605_I2C_ReadRegisters(DRV2605_Register reg, u8 *buffer, u8 length);
 static ErrorStatus DRV2605_I2C_Start(u8 direction);
 static ErrorStatus DRV2605_I2C_WaitEvent(uint32_t event, uint32_t timeout);
 static ErrorStatus DRV2605_I2C_WaitIdle(void);
 static void DRV2605_I2C_ClearErrors(void);
+static void DRV2605_ShadowStore(DRV2605_Register reg, const u8 *values, u8 count);
+static u8 DRV2605_ShadowKept(u8 index);
+static u8 DRV2605_ShadowKnown(u8 index);
 static ErrorStatus DRV2605_WaitGoClear(uint32_t timeoutMs);
 static u8 s_continuousStrength = 0;
 static u8 s_continuousConfigured = 0;
-static FunctionalState s_freqAmpReady = DISABLE;
+static u8 s_continuousActive = 0;   /* 持续震动进行中，RTPIN 由 s_continuousDrive 持有 */
+static u8 s_continuousDrive = 0;    /* 最近写入的补偿后持续强度 */
 static u16 s_freqAmpBurstMs = 800;
 static u16 s_freqAmpPauseMs = 300;
 static u16 s_freqAmpVoltageMaxMv = 5000;
+static u8 s_romStaged = 0;
+static u16 s_resonanceHz = 0;
+static u8 s_supplyGain = 128;
+static u8 s_regShadow[DRV2605_REG_COUNT];
+static u8 s_shadowValid[(DRV2605_REG_COUNT + 7) / 8];
+static DRV2605_BusHook s_busHook;
+static volatile u8 s_busDepth;   /* 进行中的事务层数（唤醒钩子会嵌套事务） */
+
+/* ========================= 初始化脚本 ========================= */
+
+/* 默认初始化：退出待机后，0x01~0x10 合并为一次连续写 */
+static const DRV2605_ScriptEntry s_initDefaultsScript[] = {
+    DRV2605_SCRIPT_WAIT(DRV2605_REG_MODE, DRV2605_MODE_INT_TRIG, 5),
+    DRV2605_SCRIPT_SET(DRV2605_REG_MODE, DRV2605_MODE_REALTIME),
+    DRV2605_SCRIPT_SET(DRV2605_REG_RTPIN, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_LIBRARY, DRV2605_LIBRARY_LRA),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ1, DRV2605_EFFECT_STRONG_CLICK_100),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ2, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ3, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ4, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ5, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ6, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ7, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_WAVESEQ8, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_GO, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_OVERDRIVE, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_SUSTAINPOS, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_SUSTAINNEG, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_BREAK, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_AUDIOMAX, 0x64),
+    DRV2605_SCRIPT_SET(DRV2605_REG_FEEDBACK, 0xB6)
+};
+
+/* 频率直驱：LRA + RTP，MODE/RTPIN/LIBRARY 一次写完 */
+static const DRV2605_ScriptEntry s_freqAmpScript[] = {
+    DRV2605_SCRIPT_WAIT(DRV2605_REG_MODE, DRV2605_MODE_INT_TRIG, 5),
+    DRV2605_SCRIPT_SET(DRV2605_REG_MODE, DRV2605_MODE_REALTIME),
+    DRV2605_SCRIPT_SET(DRV2605_REG_RTPIN, 0x00),
+    DRV2605_SCRIPT_SET(DRV2605_REG_LIBRARY, DRV2605_LIBRARY_LRA),
+    DRV2605_SCRIPT_SET(DRV2605_REG_FEEDBACK, 0xB6)
+};
+
+#define SCRIPT_LEN(table)   ((u8)(sizeof(table) / sizeof((table)[0])))
 
 /* ========================= 公共 API 实现 ========================= */
 
@@ -28,17 +78,7 @@ static u16 s_freqAmpVoltageMaxMv = 5000;
  * @brief  按照推荐值完成一次基础初始化（供 LRA 器件使用）。
  ******************************************************************************/
 ErrorStatus DRV2605_InitDefaults(void) {
-    if(DRV2605_SetMode(DRV2605_MODE_INT_TRIG) == NoREADY) return NoREADY;
-    Delay_Ms(5);
-    if(DRV2605_SelectLRA() == NoREADY) return NoREADY;
-    if(DRV2605_SetLibrary(DRV2605_LIBRARY_LRA) == NoREADY) return NoREADY;
-    if(DRV2605_SetWaveform(0, DRV2605_EFFECT_STRONG_CLICK_100) == NoREADY) return NoREADY;
-    if(DRV2605_ClearWaveforms() == NoREADY) return NoREADY;
-    if(DRV2605_SetOverdriveClamp(0x00) == NoREADY) return NoREADY;
-    if(DRV2605_SetSustainLevel(0x00, 0x00) == NoREADY) return NoREADY;
-    if(DRV2605_SetBrakeLevel(0x00) == NoREADY) return NoREADY;
-    if(DRV2605_SetAudioMax(0x64) == NoREADY) return NoREADY;
-    return DRV2605_SetMode(DRV2605_MODE_REALTIME);
+    return DRV2605_ScriptRun(s_initDefaultsScript, SCRIPT_LEN(s_initDefaultsScript));
 }
 
 /******************************************************************************
@@ -46,7 +86,30 @@ ErrorStatus DRV2605_InitDefaults(void) {
  ******************************************************************************/
 ErrorStatus DRV2605_WriteRegister(DRV2605_Register reg, u8 value) {
     u8 payload[2] = { (u8)reg, value };
-    return DRV2605_I2C_WriteBytes(payload, sizeof(payload));
+    if(DRV2605_I2C_WriteBytes(payload, sizeof(payload)) == NoREADY) {
+        return NoREADY;
+    }
+    DRV2605_ShadowStore(reg, &value, 1);
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  连续写多个寄存器（利用器件地址自增，一次 I2C 事务完成）。
+ ******************************************************************************/
+ErrorStatus DRV2605_WriteRegisters(DRV2605_Register startReg, const u8 *values, u8 count) {
+    u8 payload[DRV2605_BURST_MAX + 1];
+    if(values == NULL || count == 0 || count > DRV2605_BURST_MAX) {
+        return NoREADY;
+    }
+    payload[0] = (u8)startReg;
+    for(u8 i = 0; i < count; i++) {
+        payload[i + 1] = values[i];
+    }
+    if(DRV2605_I2C_WriteBytes(payload, (u8)(count + 1)) == NoREADY) {
+        return NoREADY;
+    }
+    DRV2605_ShadowStore(startReg, values, count);
+    return READY;
 }
 
 /******************************************************************************
@@ -56,7 +119,94 @@ ErrorStatus DRV2605_ReadRegister(DRV2605_Register reg, u8 *value) {
     if(value == NULL) {
         return NoREADY;
     }
-    return DRV2605_I2C_ReadRegisters(reg, value, 1);
+    if(DRV2605_I2C_ReadRegisters(reg, value, 1) == NoREADY) {
+        return NoREADY;
+    }
+    DRV2605_ShadowStore(reg, value, 1);
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  读取影子寄存器（不访问总线）。
+ ******************************************************************************/
+ErrorStatus DRV2605_GetShadowRegister(DRV2605_Register reg, u8 *value) {
+    u8 index = (u8)reg;
+    if(value == NULL || index >= DRV2605_REG_COUNT) {
+        return NoREADY;
+    }
+    if(!DRV2605_ShadowKnown(index)) {
+        return NoREADY;
+    }
+    *value = s_regShadow[index];
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  作废全部影子寄存器（器件复位或自动校准后调用）。
+ ******************************************************************************/
+void DRV2605_InvalidateShadow(void) {
+    for(u8 i = 0; i < sizeof(s_shadowValid); i++) {
+        s_shadowValid[i] = 0;
+    }
+}
+
+ErrorStatus DRV2605_SyncShadow(void) {
+    u8 block[DRV2605_REG_COUNT - DRV2605_REG_MODE];
+
+    for(u8 reg = DRV2605_REG_MODE; reg < DRV2605_REG_COUNT; reg++) {
+        if(DRV2605_ShadowKept(reg) && !DRV2605_ShadowKnown(reg)) {
+            if(DRV2605_I2C_ReadRegisters(DRV2605_REG_MODE, block, sizeof(block)) == NoREADY) {
+                return NoREADY;
+            }
+            DRV2605_ShadowStore(DRV2605_REG_MODE, block, sizeof(block));
+            return READY;
+        }
+    }
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  影子完整时为一次 36 字节的突发写（地址 + 0x01~0x23）。
+ ******************************************************************************/
+ErrorStatus DRV2605_RestoreShadow(void) {
+    u8 payload[DRV2605_REG_COUNT];
+    u8 count = 0;
+
+    for(u8 reg = DRV2605_REG_MODE; reg <= DRV2605_REG_COUNT; reg++) {
+        u8 usable = (reg < DRV2605_REG_COUNT) &&
+                    (!DRV2605_ShadowKept(reg) || DRV2605_ShadowKnown(reg));
+        if(usable) {
+            if(count == 0) {
+                payload[0] = reg;
+            }
+            payload[++count] = DRV2605_ShadowKept(reg) ? s_regShadow[reg] : 0x00;
+        } else if(count != 0) {
+            if(DRV2605_I2C_WriteBytes(payload, (u8)(count + 1)) == NoREADY) {
+                return NoREADY;
+            }
+            count = 0;
+        }
+    }
+    return READY;
+}
+
+ErrorStatus DRV2605_SetStandby(FunctionalState state) {
+    u8 mode;
+    u8 value;
+
+    if(DRV2605_GetShadowRegister(DRV2605_REG_MODE, &mode) == NoREADY &&
+       DRV2605_ReadRegister(DRV2605_REG_MODE, &mode) == NoREADY) {
+        return NoREADY;
+    }
+    value = (state == ENABLE) ? (u8)(mode | DRV2605_MODE_STANDBY) : (u8)(mode & ~DRV2605_MODE_STANDBY);
+    if(value == mode) {
+        return READY;
+    }
+    return DRV2605_WriteRegister(DRV2605_REG_MODE, value);
+}
+
+void DRV2605_SetBusHook(DRV2605_BusHook hook) {
+    s_busHook = hook;
 }
 
 /******************************************************************************
@@ -70,6 +220,7 @@ ErrorStatus DRV2605_GetStatus(u8 *status) {
  * @brief  设置模式寄存器。
  ******************************************************************************/
 ErrorStatus DRV2605_SetMode(DRV2605_Mode mode) {
+    s_continuousActive = 0; /* 任何模式切换都让出 RTPIN */
     return DRV2605_WriteRegister(DRV2605_REG_MODE, (u8)mode);
 }
 
@@ -150,6 +301,42 @@ ErrorStatus DRV2605_ClearWaveforms(void) {
     return READY;
 }
 
+/******************************************************************************
+ * @brief  预写下一段 ROM 序列（LIBRARY + WAVESEQ1~8 一次连续写入）。
+ * @note   RTP 模式下写 LIBRARY/WAVESEQ 不影响当前输出，可提前完成。
+ ******************************************************************************/
+ErrorStatus DRV2605_StageRomSequence(DRV2605_Library libraryId,
+                                     const DRV2605_Effect *effects, u8 count) {
+    u8 block[9] = { 0 };
+    if(effects == NULL || count == 0 || count > 8) {
+        return NoREADY;
+    }
+    block[0] = ((u8)libraryId) & 0x07;
+    for(u8 i = 0; i < count; i++) {
+        block[i + 1] = (u8)effects[i];
+    }
+    s_romStaged = 0;
+    if(DRV2605_WriteRegisters(DRV2605_REG_LIBRARY, block, sizeof(block)) == NoREADY) {
+        return NoREADY;
+    }
+    s_romStaged = 1;
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  切换到内部触发并立即 GO（MODE/GO 背靠背写入，无额外延时）。
+ ******************************************************************************/
+ErrorStatus DRV2605_CommitRomTransition(void) {
+    if(!s_romStaged) {
+        return NoREADY;
+    }
+    if(DRV2605_SetMode(DRV2605_MODE_INT_TRIG) == NoREADY) {
+        return NoREADY;
+    }
+    s_romStaged = 0;
+    return DRV2605_Start();
+}
+
 /******************************************************************************
  * @brief  播放实时动作组（内部维持索引）。
  ******************************************************************************/
@@ -160,7 +347,11 @@ ErrorStatus DRV2605_RunActionGroup(DRV2605_ActionGroup *group) {
 
     if(group->currentIndex < group->frameCount) {
         const DRV2605_RtpAction *frame = &group->frames[group->currentIndex++];
-        if(DRV2605_SetRealtimeValue(frame->amplitude) == NoREADY) {
+        u8 drive = DRV2605_ScaleAmplitude(frame->amplitude);
+        u8 last;
+        /* 与上一帧幅值相同则 RTPIN 无需重写 */
+        if((DRV2605_GetShadowRegister(DRV2605_REG_RTPIN, &last) == NoREADY || last != drive) &&
+           DRV2605_SetRealtimeValue(drive) == NoREADY) {
             return NoREADY;
         }
         Delay_Ms(frame->holdMs);
@@ -204,19 +395,22 @@ ErrorStatus DRV2605_RunAutoCalibration(const DRV2605_AutoCalConfig *cfg,
     }
     Delay_Ms(5);
 
-    if(DRV2605_SelectLRA() == NoREADY) return NoREADY;
-    if(DRV2605_SetLibrary(DRV2605_LIBRARY_LRA) == NoREADY) return NoREADY;
-    if(DRV2605_SetRatedVoltage(cfg->ratedVoltage) == NoREADY) return NoREADY;
-    if(DRV2605_SetClampVoltage(cfg->clampVoltage) == NoREADY) return NoREADY;
-    if(DRV2605_SetControl1(cfg->control1) == NoREADY) return NoREADY;
-    if(DRV2605_SetControl2(cfg->control2) == NoREADY) return NoREADY;
-    if(DRV2605_SetControl3(cfg->control3) == NoREADY) return NoREADY;
-    if(DRV2605_SetControl4(cfg->control4) == NoREADY) return NoREADY;
-    if(DRV2605_SetControl5(cfg->control5) == NoREADY) return NoREADY;
-
-    if(DRV2605_SetMode(DRV2605_MODE_AUTOCAL) == NoREADY) return NoREADY;
-
-    if(DRV2605_Start() == NoREADY) return NoREADY;
+    /* RATEDV~CONTROL4 之间的补偿寄存器若影子已知会被补齐为一次连续写 */
+    DRV2605_ScriptPut(DRV2605_REG_LIBRARY, DRV2605_LIBRARY_LRA, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_RATEDV, cfg->ratedVoltage, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_CLAMPV, cfg->clampVoltage, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_FEEDBACK, 0xB6, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_CONTROL1, cfg->control1, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_CONTROL2, cfg->control2, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_CONTROL3, cfg->control3, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_CONTROL4, cfg->control4, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_CONTROL5, cfg->control5, 0xFF);
+    if(DRV2605_ScriptFlush() == NoREADY) return NoREADY;
+
+    /* 升序提交保证 MODE 先于 GO */
+    DRV2605_ScriptPut(DRV2605_REG_MODE, DRV2605_MODE_AUTOCAL, 0xFF);
+    DRV2605_ScriptPut(DRV2605_REG_GO, 0x01, 0xFF);
+    if(DRV2605_ScriptFlush() == NoREADY) return NoREADY;
 
     if(DRV2605_WaitGoClear(cfg->timeoutMs ? cfg->timeoutMs : 2000) == NoREADY) {
         DRV2605_Stop();
@@ -224,6 +418,7 @@ ErrorStatus DRV2605_RunAutoCalibration(const DRV2605_AutoCalConfig *cfg,
     }
 
     DRV2605_Stop();
+    DRV2605_InvalidateShadow(); /* 校准会改写 RATEDV/CLAMPV/补偿等寄存器 */
 
     if(result) {
         if(DRV2605_GetStatus(&result->status) == NoREADY) return NoREADY;
@@ -302,11 +497,49 @@ ErrorStatus DRV2605_ConfigureContinuous(const DRV2605_ContinuousConfig *cfg) {
         return NoREADY;
     }
 
-    s_continuousStrength = (cfg->strength > 0x7F) ? 0x7F : cfg->strength;
-    s_continuousConfigured = 1;
+    DRV2605_SetContinuousStrength(cfg->strength);
     return READY;
 }
 
+/******************************************************************************
+ * @brief  更新电源补偿增益；持续震动不经过 RTP 流水线，进行中时按新增益
+ *         重写 RTPIN（影子中的 RTPIN 或模式已被他人改写则不动）。
+ ******************************************************************************/
+void DRV2605_SetSupplyGain(u8 gain) {
+    u8 mode;
+    u8 last;
+    u8 drive;
+
+    s_supplyGain = gain;
+    if(!s_continuousActive ||
+       DRV2605_GetShadowRegister(DRV2605_REG_MODE, &mode) == NoREADY || mode != DRV2605_MODE_REALTIME ||
+       DRV2605_GetShadowRegister(DRV2605_REG_RTPIN, &last) == NoREADY || last != s_continuousDrive) {
+        return;
+    }
+    drive = DRV2605_ScaleAmplitude(s_continuousStrength);
+    if(drive != last && DRV2605_SetRealtimeValue(drive) == READY) {
+        s_continuousDrive = drive;
+    }
+}
+
+u8 DRV2605_GetSupplyGain(void) {
+    return s_supplyGain;
+}
+
+u8 DRV2605_ScaleAmplitude(u8 value) {
+    u16 scaled;
+    if(s_supplyGain == 128) {
+        return (value > 0x7F) ? 0x7F : value;
+    }
+    scaled = (u16)((value * (u16)s_supplyGain) >> 7);
+    return (u8)((scaled > 0x7F) ? 0x7F : scaled);
+}
+
+void DRV2605_SetContinuousStrength(u8 strength) {
+    s_continuousStrength = (strength > 0x7F) ? 0x7F : strength;
+    s_continuousConfigured = 1;
+}
+
 ErrorStatus DRV2605_StartContinuous(void) {
     if(!s_continuousConfigured) {
         return NoREADY;
@@ -314,13 +547,19 @@ ErrorStatus DRV2605_StartContinuous(void) {
     if(DRV2605_SetMode(DRV2605_MODE_REALTIME) == NoREADY) {
         return NoREADY;
     }
-    if(DRV2605_SetRealtimeValue(s_continuousStrength) == NoREADY) {
+    s_continuousDrive = DRV2605_ScaleAmplitude(s_continuousStrength);
+    if(DRV2605_SetRealtimeValue(s_continuousDrive) == NoREADY) {
         return NoREADY;
     }
-    return DRV2605_Start();
+    if(DRV2605_Start() == NoREADY) {
+        return NoREADY;
+    }
+    s_continuousActive = 1;
+    return READY;
 }
 
 ErrorStatus DRV2605_StopContinuous(void) {
+    s_continuousActive = 0;
     if(DRV2605_SetRealtimeValue(0x00) == NoREADY) {
         return NoREADY;
     }
@@ -345,35 +584,45 @@ void DRV2605_SetFreqAmpVoltageRange(u16 maxMillivolts) {
 }
 
 ErrorStatus DRV2605_PrepareFreqAmpRealtime(void) {
-    if(s_freqAmpReady == ENABLE) {
+    u8 mode = 0;
+    u8 feedback = 0;
+    /* 影子显示已处于 LRA + RTP 时无需重新配置 */
+    if(DRV2605_GetShadowRegister(DRV2605_REG_MODE, &mode) == READY &&
+       DRV2605_GetShadowRegister(DRV2605_REG_FEEDBACK, &feedback) == READY &&
+       mode == DRV2605_MODE_REALTIME && (feedback & 0x80) != 0) {
         return READY;
     }
-    if(DRV2605_SetMode(DRV2605_MODE_INT_TRIG) == NoREADY) {
-        return NoREADY;
-    }
-    Delay_Ms(5);
-    if(DRV2605_SelectLRA() == NoREADY) {
-        return NoREADY;
-    }
-    if(DRV2605_SetLibrary(DRV2605_LIBRARY_LRA) == NoREADY) {
+    return DRV2605_ScriptRun(s_freqAmpScript, SCRIPT_LEN(s_freqAmpScript));
+}
+
+ErrorStatus DRV2605_SetResonance(u8 period, u16 frequencyHz) {
+    u8 current;
+
+    period &= 0x7F;
+    if(period == 0) {
         return NoREADY;
     }
-    if(DRV2605_SetMode(DRV2605_MODE_REALTIME) == NoREADY) {
-        return NoREADY;
+    s_resonanceHz = frequencyHz;
+    if(DRV2605_GetShadowRegister(DRV2605_REG_OLLRAPERIOD, &current) == READY && current == period) {
+        return READY;
     }
-    s_freqAmpReady = ENABLE;
-    return READY;
+    return DRV2605_WriteRegister(DRV2605_REG_OLLRAPERIOD, period);
+}
+
+u16 DRV2605_GetResonanceHz(void) {
+    return s_resonanceHz;
 }
 
 ErrorStatus DRV2605_PlayFreqAmp(u16 frequencyHz, u8 amplitude) {
+    if(frequencyHz == DRV2605_FREQ_RESONANCE) {
+        frequencyHz = s_resonanceHz;
+    }
     if(frequencyHz == 0 || amplitude == 0) {
         return NoREADY;
     }
 
-    if(s_freqAmpReady != ENABLE) {
-        if(DRV2605_PrepareFreqAmpRealtime() == NoREADY) {
-            return NoREADY;
-        }
+    if(DRV2605_PrepareFreqAmpRealtime() == NoREADY) {
+        return NoREADY;
     }
 
     u32 periodUs = 1000000UL / frequencyHz;
@@ -391,7 +640,7 @@ ErrorStatus DRV2605_PlayFreqAmp(u16 frequencyHz, u8 amplitude) {
         cycles = 1;
     }
 
-    u8 driveValue = (amplitude > 0x7F) ? 0x7F : amplitude;
+    u8 driveValue = DRV2605_ScaleAmplitude(amplitude);
 
     for(u32 cycle = 0; cycle < cycles; cycle++) {
         if(DRV2605_SetRealtimeValue(driveValue) == NoREADY) {
@@ -433,6 +682,41 @@ ErrorStatus DRV2605_Start(void) {
     return DRV2605_WriteRegister(DRV2605_REG_GO, 0x01);
 }
 
+/******************************************************************************
+ * @brief  WAVESEQ1~GO 地址连续，换效果时 10 字节一次写完（其余槽补 0）；
+ *         效果已在 WAVESEQ1 且 WAVESEQ2 为结束符时只写 GO。
+ ******************************************************************************/
+ErrorStatus DRV2605_FireFromIsr(DRV2605_Effect effect) {
+    u8 payload[DRV2605_REG_GO - DRV2605_REG_WAVESEQ1 + 2] = { 0 };
+    u8 length = sizeof(payload);
+
+    if(s_busDepth != 0 || I2C_GetFlagStatus(I2C1, I2C_FLAG_BUSY) != RESET) {
+        return NoREADY;
+    }
+    if(!DRV2605_ShadowKnown(DRV2605_REG_MODE) || s_regShadow[DRV2605_REG_MODE] != DRV2605_MODE_INT_TRIG) {
+        return NoREADY;
+    }
+
+    if(DRV2605_ShadowKnown(DRV2605_REG_WAVESEQ1) && DRV2605_ShadowKnown(DRV2605_REG_WAVESEQ2) &&
+       s_regShadow[DRV2605_REG_WAVESEQ1] == (u8)effect && s_regShadow[DRV2605_REG_WAVESEQ2] == 0x00) {
+        payload[0] = DRV2605_REG_GO;
+        payload[1] = 0x01;
+        length = 2;
+    } else {
+        payload[0] = DRV2605_REG_WAVESEQ1;
+        payload[1] = (u8)effect;
+        payload[sizeof(payload) - 1] = 0x01;
+    }
+    if(DRV2605_I2C_WriteBytes(payload, length) == NoREADY) {
+        return NoREADY;
+    }
+    if(length != 2) {
+        DRV2605_ShadowStore(DRV2605_REG_WAVESEQ1, &payload[1], (u8)(length - 2));
+        s_romStaged = 0;
+    }
+    return READY;
+}
+
 /******************************************************************************
  * @brief  停止波形序列（GO = 0）。
  ******************************************************************************/
@@ -580,7 +864,40 @@ ErrorStatus DRV2605_SelectERM(void) {
 
 /* -------------------- 以下为 I2C 私有工具函数 -------------------- */
 
+/* STATUS/GO/VBAT/LRARESON 由器件自行改变，不进入影子 */
+static u8 DRV2605_ShadowKept(u8 index) {
+    return index != DRV2605_REG_STATUS && index != DRV2605_REG_GO &&
+           index != DRV2605_REG_VBAT && index != DRV2605_REG_LRARESON;
+}
+
+static u8 DRV2605_ShadowKnown(u8 index) {
+    return (s_shadowValid[index >> 3] & (1U << (index & 0x07))) != 0;
+}
+
+static void DRV2605_ShadowStore(DRV2605_Register reg, const u8 *values, u8 count) {
+    for(u8 i = 0; i < count; i++) {
+        u8 index = (u8)(reg + i);
+        if(index >= DRV2605_REG_COUNT) {
+            return;
+        }
+        if(!DRV2605_ShadowKept(index)) {
+            continue;
+        }
+        s_regShadow[index] = values[i];
+        s_shadowValid[index >> 3] |= (u8)(1U << (index & 0x07));
+    }
+}
+
 static ErrorStatus DRV2605_I2C_WriteBytes(const u8 *data, u8 length) {
+    ErrorStatus status;
+
+    s_busDepth++;
+    status = DRV2605_I2C_Transmit(data, length);
+    s_busDepth--;
+    return status;
+}
+
+static ErrorStatus DRV2605_I2C_Transmit(const u8 *data, u8 length) {
     u8 sent = 0;
     if(length == 0) {
         return READY;
@@ -623,7 +940,9 @@ static ErrorStatus DRV2605_I2C_ReadRegisters(DRV2605_Register reg, u8 *buffer, u
         return NoREADY;
     }
 
+    s_busDepth++;
     if(DRV2605_I2C_Start(I2C_Direction_Transmitter) == NoREADY) {
+        s_busDepth--;
         return NoREADY;
     }
 
@@ -682,6 +1001,7 @@ cleanup:
         DRV2605_I2C_ClearErrors();
     }
 
+    s_busDepth--;
     return result;
 }
 
@@ -690,6 +1010,9 @@ static ErrorStatus DRV2605_I2C_Start(u8 direction) {
             I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED :
             I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED;
 
+    if(s_busHook != NULL) {
+        s_busHook();
+    }
     if(DRV2605_I2C_WaitIdle() == NoREADY) {
         return NoREADY;
     }
@@ -43,11 +43,18 @@ typedef enum {
 	DRV2605_REG_CONTROL2    = 0x1C,  /* 控制寄存器 2 */
 	DRV2605_REG_CONTROL3    = 0x1D,  /* 控制寄存器 3 */
 	DRV2605_REG_CONTROL4    = 0x1E,  /* 控制寄存器 4 */
+	DRV2605_REG_OLLRAPERIOD = 0x20,  /* 开环 LRA 驱动周期 */
 	DRV2605_REG_VBAT        = 0x21,  /* VBAT 实测值 */
 	DRV2605_REG_LRARESON    = 0x22,  /* LRA 共振频率 */
 	DRV2605_REG_CONTROL5    = 0x23   /* 控制寄存器 5 */
 } DRV2605_Register;
 
+#define DRV2605_REG_COUNT          0x24  /* 影子寄存器覆盖的地址范围 */
+
+/* LRARESON / OLLRAPERIOD 的周期单位 98.46us，f(Hz) = 10156 / 周期值 */
+#define DRV2605_LRA_PERIOD_HZ_NUM  10156UL
+#define DRV2605_FREQ_RESONANCE     0     /* PlayFreqAmp 频率参数：使用跟踪到的共振频率 */
+
 /* 官方内置波形库编号（库寄存器 0x03 对应的值） */
 typedef enum {
 	DRV2605_LIBRARY_EMPTY = 0x00,  /* 不加载波形库，通常用于自定义 RTP */
@@ -249,6 +256,11 @@ typedef enum {
 	DRV2605_MODE_AUTOCAL    = 0x07   /* 自动校准模式 */
 } DRV2605_Mode;
 
+#define DRV2605_MODE_STANDBY       0x40  /* MODE bit6：软件待机，寄存器保持可读写 */
+
+/* 每次总线事务开始前调用（电源管理用于惰性唤醒） */
+typedef void (*DRV2605_BusHook)(void);
+
 /* ========================= API 入口 ========================= */
 
 /* ----------- 基础寄存器访问 ----------- */
@@ -267,6 +279,15 @@ ErrorStatus DRV2605_InitDefaults(void);
  */
 ErrorStatus DRV2605_WriteRegister(DRV2605_Register reg, u8 value);
 
+/**
+ * @brief  从起始寄存器开始连续写入多个字节（器件地址自增）。
+ * @param  startReg 起始寄存器。
+ * @param  values   待写入数据。
+ * @param  count    字节数 1~16。
+ * @return READY 成功，NoREADY 失败或参数非法。
+ */
+ErrorStatus DRV2605_WriteRegisters(DRV2605_Register startReg, const u8 *values, u8 count);
+
 /**
  * @brief  读取指定寄存器的 8 位数据。
  * @param  reg   寄存器枚举值。
@@ -275,6 +296,45 @@ ErrorStatus DRV2605_WriteRegister(DRV2605_Register reg, u8 value);
  */
 ErrorStatus DRV2605_ReadRegister(DRV2605_Register reg, u8 *value);
 
+/**
+ * @brief  读取驱动层缓存的寄存器影子值（最近一次成功读写的结果）。
+ * @param  reg   寄存器枚举值。
+ * @param  value 输出指针。
+ * @return READY 影子有效，NoREADY 未知或该寄存器不缓存（STATUS/GO/VBAT/LRARESON）。
+ */
+ErrorStatus DRV2605_GetShadowRegister(DRV2605_Register reg, u8 *value);
+
+/**
+ * @brief  作废全部影子寄存器，下次访问将回读器件。
+ */
+void DRV2605_InvalidateShadow(void);
+
+/**
+ * @brief  一次突发读回 MODE~CONTROL5，补全影子中的未知项（影子已完整时不访问总线）。
+ * @note   断电前调用，之后 DRV2605_RestoreShadow 只需一次突发写。
+ * @return READY 成功，NoREADY 总线失败。
+ */
+ErrorStatus DRV2605_SyncShadow(void);
+
+/**
+ * @brief  按影子重写 MODE~CONTROL5；GO/VBAT/LRARESON 位置写 0（GO=0 无副作用，
+ *         后两者只读），仅在影子未知处断开为多段突发写。
+ * @note   用于 EN 断电后器件寄存器可能已复位的场合。
+ * @return READY 成功，NoREADY 总线失败。
+ */
+ErrorStatus DRV2605_RestoreShadow(void);
+
+/**
+ * @brief  置位/清除 MODE 的待机位，模式位保持不变（取自影子，未知时回读）。
+ * @return READY 成功，NoREADY 失败。
+ */
+ErrorStatus DRV2605_SetStandby(FunctionalState state);
+
+/**
+ * @brief  注册总线事务钩子，NULL 取消。
+ */
+void DRV2605_SetBusHook(DRV2605_BusHook hook);
+
 /**
  * @brief  读取 STATUS 寄存器。
  * @param  status 输出状态字节（bit0/1 表示 DIAG/OC 等）。
@@ -332,6 +392,31 @@ ErrorStatus DRV2605_GetWaveform(u8 slot, DRV2605_Effect *effectId);
  */
 ErrorStatus DRV2605_ClearWaveforms(void);
 
+/**
+ * @brief  在 RTP 播放期间预写下一段 ROM 序列（LIBRARY + WAVESEQ1~8 一次写完）。
+ * @param  libraryId 目标触感库。
+ * @param  effects   效果数组，不足 8 个时其余槽位补 0 作为结束符。
+ * @param  count     效果数量 1~8。
+ * @return READY 成功，NoREADY 失败或参数非法。
+ */
+ErrorStatus DRV2605_StageRomSequence(DRV2605_Library libraryId,
+                                     const DRV2605_Effect *effects, u8 count);
+
+/**
+ * @brief  从 RTP 切换到已预写的 ROM 序列：MODE = 内部触发后立即 GO。
+ * @note   器件已处于工作态，无需 InitDefaults 中的 5ms 待机退出延时。
+ * @return READY 成功，NoREADY 未预写或写入失败。
+ */
+ErrorStatus DRV2605_CommitRomTransition(void);
+
+/**
+ * @brief  中断上下文的快速触发：一次突发写 WAVESEQ1~GO 播放单个 ROM 效果。
+ * @note   仅依据影子判断，不做读改写；主循环事务进行中或 MODE 不是内部触发
+ *         （含待机位）时立即返回 NoREADY，由调用方转到主循环处理。
+ * @return READY 已 GO，NoREADY 条件不满足或总线失败。
+ */
+ErrorStatus DRV2605_FireFromIsr(DRV2605_Effect effect);
+
 /**
  * @brief  播放实时动作组（函数内部推进索引）。
  * @param  group 动作用组指针，frames/frameCount 等需提前配置。
@@ -379,6 +464,28 @@ u16 DRV2605_DecodeClampVoltageMv(u8 regValue);
  */
 ErrorStatus DRV2605_ConfigureContinuous(const DRV2605_ContinuousConfig *cfg);
 
+/**
+ * @brief  仅更新持续震动强度（寄存器配置已由配置档等方式完成时使用）。
+ * @param  strength 实时播放值 0~0x7F，超出部分被钳位。
+ */
+void DRV2605_SetContinuousStrength(u8 strength);
+
+/**
+ * @brief  设置电源补偿增益（Q7，128 为 1.0），作用于持续震动、动作组与频率直驱的幅值。
+ * @note   RTP 流由 haptic_rtp 按块读取同一增益；持续震动进行中会立即按新增益重写 RTPIN。
+ */
+void DRV2605_SetSupplyGain(u8 gain);
+
+/**
+ * @brief  获取电源补偿增益。
+ */
+u8 DRV2605_GetSupplyGain(void);
+
+/**
+ * @brief  按电源补偿增益缩放一个 RTP 幅值，结果钳位到 0x7F。
+ */
+u8 DRV2605_ScaleAmplitude(u8 value);
+
 /**
  * @brief  启动持续震动（Real-Time Playback）。
  */
@@ -409,16 +516,29 @@ void DRV2605_SetFreqAmpVoltageRange(u16 maxMillivolts);
  */
 ErrorStatus DRV2605_PrepareFreqAmpRealtime(void);
 
+/**
+ * @brief  记录跟踪到的 LRA 共振，并同步开环驱动周期（仅在变化时写 0x20）。
+ * @param  period      共振周期，单位 98.46us（bit6:0 有效）。
+ * @param  frequencyHz 对应的频率，供 DRV2605_FREQ_RESONANCE 使用。
+ * @return READY 成功，NoREADY 写入失败。
+ */
+ErrorStatus DRV2605_SetResonance(u8 period, u16 frequencyHz);
+
+/**
+ * @brief  获取最近记录的共振频率，未知时为 0。
+ */
+u16 DRV2605_GetResonanceHz(void);
+
 /**
  * @brief  按指定频率与幅值执行一次 burst 震动。
- * @param  frequencyHz 目标频率，单位 Hz。
+ * @param  frequencyHz 目标频率，单位 Hz；DRV2605_FREQ_RESONANCE 表示跟随共振。
  * @param  amplitude   实时寄存器值 0x01~0x7F。
  */
 ErrorStatus DRV2605_PlayFreqAmp(u16 frequencyHz, u8 amplitude);
 
 /**
  * @brief  按指定频率与电压执行一次震动，内部自动映射幅值。
- * @param  frequencyHz 目标频率，单位 Hz。
+ * @param  frequencyHz 目标频率，单位 Hz；DRV2605_FREQ_RESONANCE 表示跟随共振。
  * @param  voltageMv   目标电压，单位 mV。
  */
 ErrorStatus DRV2605_PlayFreqVoltage(u16 frequencyHz, u16 voltageMv);
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * 文件名   : drv2605_profile.c
+ * 描述     : DRV2605 配置档：flash 常量表 + 影子差异比较 + 连续写提交。
+ ******************************************************************************/
+#include "drv2605_profile.h"
+#include "drv2605_script.h"
+
+/* 配置档涉及的寄存器，按地址升序排列 */
+static const u8 s_profileRegs[] = {
+    DRV2605_REG_LIBRARY,
+    DRV2605_REG_OVERDRIVE,
+    DRV2605_REG_SUSTAINPOS,
+    DRV2605_REG_SUSTAINNEG,
+    DRV2605_REG_BREAK,
+    DRV2605_REG_RATEDV,
+    DRV2605_REG_CLAMPV,
+    DRV2605_REG_FEEDBACK,
+    DRV2605_REG_CONTROL1,
+    DRV2605_REG_CONTROL2,
+    DRV2605_REG_CONTROL3,
+    DRV2605_REG_CONTROL4,
+    DRV2605_REG_CONTROL5
+};
+
+#define PROFILE_REG_COUNT   (sizeof(s_profileRegs) / sizeof(s_profileRegs[0]))
+
+static const DRV2605_Profile s_profileBank[DRV2605_PROFILE_COUNT] = {
+    [DRV2605_PROFILE_LRA_CLOSED_LOOP] = {
+        .name = "lra-closed",
+        .continuous = { .useLRA = ENABLE, .driveTime = 0x20, .strength = 0x50,
+                        .libraryId = DRV2605_LIBRARY_LRA },
+        .autoCal = { .ratedVoltage = 0x50, .clampVoltage = 0x90, .control1 = 0x20,
+                     .control2 = 0xF5, .control3 = 0x80, .control4 = 0x20,
+                     .control5 = 0x80, .timeoutMs = 2000 },
+        .overdrive = 0x00, .sustainPos = 0x00, .sustainNeg = 0x00, .brake = 0x00
+    },
+    [DRV2605_PROFILE_ERM_OPEN_LOOP] = {
+        .name = "erm-open",
+        .continuous = { .useLRA = DISABLE, .driveTime = 0x35, .strength = 0x60,
+                        .libraryId = DRV2605_LIBRARY_A },
+        .autoCal = { .ratedVoltage = 0x3E, .clampVoltage = 0x8C, .control1 = 0x93,
+                     .control2 = 0xF5, .control3 = 0xA0, .control4 = 0x20,
+                     .control5 = 0x80, .timeoutMs = 2000 },
+        .overdrive = 0x00, .sustainPos = 0x00, .sustainNeg = 0x00, .brake = 0x00
+    },
+    [DRV2605_PROFILE_LRA_ALERT] = {
+        .name = "lra-alert",
+        .continuous = { .useLRA = ENABLE, .driveTime = 0x20, .strength = 0x7F,
+                        .libraryId = DRV2605_LIBRARY_LRA },
+        .autoCal = { .ratedVoltage = 0x50, .clampVoltage = 0xD0, .control1 = 0xA0,
+                     .control2 = 0xF5, .control3 = 0x80, .control4 = 0x20,
+                     .control5 = 0x80, .timeoutMs = 2000 },
+        .overdrive = 0x10, .sustainPos = 0x00, .sustainNeg = 0x00, .brake = 0x08
+    }
+};
+
+static DRV2605_ProfileId s_activeProfile = DRV2605_PROFILE_COUNT;
+
+/* 把配置档展开为与 s_profileRegs 一一对应的寄存器映像 */
+static void Profile_BuildImage(const DRV2605_Profile *profile, u8 *image) {
+    const DRV2605_AutoCalConfig *cal = &profile->autoCal;
+    const DRV2605_ContinuousConfig *cont = &profile->continuous;
+
+    image[0]  = ((u8)cont->libraryId) & 0x07;
+    image[1]  = profile->overdrive;
+    image[2]  = profile->sustainPos;
+    image[3]  = profile->sustainNeg;
+    image[4]  = profile->brake;
+    image[5]  = cal->ratedVoltage;
+    image[6]  = cal->clampVoltage;
+    image[7]  = (cont->useLRA == ENABLE) ? 0xB6 : 0x36;
+    image[8]  = cal->control1;
+    image[9]  = (u8)((cal->control2 & 0xC0) | (cont->driveTime & 0x3F));
+    image[10] = cal->control3;
+    image[11] = cal->control4;
+    image[12] = cal->control5;
+}
+
+static u8 Profile_RegDiffers(u8 reg, u8 target) {
+    u8 current = 0;
+    if(DRV2605_GetShadowRegister((DRV2605_Register)reg, &current) == NoREADY) {
+        return 1;
+    }
+    return current != target;
+}
+
+/******************************************************************************
+ * @brief  获取配置档定义。
+ ******************************************************************************/
+const DRV2605_Profile *DRV2605_GetProfile(DRV2605_ProfileId id) {
+    if(id >= DRV2605_PROFILE_COUNT) {
+        return NULL;
+    }
+    return &s_profileBank[id];
+}
+
+/******************************************************************************
+ * @brief  统计切换到目标配置档需要写的寄存器数。
+ ******************************************************************************/
+u8 DRV2605_ProfileDiffCount(DRV2605_ProfileId id) {
+    u8 image[PROFILE_REG_COUNT];
+    u8 count = 0;
+
+    if(id >= DRV2605_PROFILE_COUNT) {
+        return 0;
+    }
+    Profile_BuildImage(&s_profileBank[id], image);
+    for(u8 i = 0; i < PROFILE_REG_COUNT; i++) {
+        count += Profile_RegDiffers(s_profileRegs[i], image[i]);
+    }
+    return count;
+}
+
+/******************************************************************************
+ * @brief  应用配置档：仅差异寄存器进入脚本段，由解释器合并为连续写。
+ ******************************************************************************/
+ErrorStatus DRV2605_ApplyProfile(DRV2605_ProfileId id) {
+    u8 image[PROFILE_REG_COUNT];
+
+    if(id >= DRV2605_PROFILE_COUNT) {
+        return NoREADY;
+    }
+
+    Profile_BuildImage(&s_profileBank[id], image);
+    for(u8 i = 0; i < PROFILE_REG_COUNT; i++) {
+        if(Profile_RegDiffers(s_profileRegs[i], image[i])) {
+            DRV2605_ScriptPut((DRV2605_Register)s_profileRegs[i], image[i], 0xFF);
+        }
+    }
+    if(DRV2605_ScriptFlush() == NoREADY) {
+        s_activeProfile = DRV2605_PROFILE_COUNT;
+        return NoREADY;
+    }
+
+    DRV2605_SetContinuousStrength(s_profileBank[id].continuous.strength);
+    s_activeProfile = id;
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  当前生效的配置档。
+ ******************************************************************************/
+DRV2605_ProfileId DRV2605_GetActiveProfile(void) {
+    return s_activeProfile;
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * 文件名   : drv2605_profile.h
+ * 描述     : DRV2605 执行器配置档（flash 常量表，按差异连续写切换）。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __DRV2605_PROFILE_H
+#define __DRV2605_PROFILE_H
+
+#include "drv2605.h"
+
+/* 内置配置档编号 */
+typedef enum {
+	DRV2605_PROFILE_LRA_CLOSED_LOOP = 0,  /* LRA 闭环，日常触感 */
+	DRV2605_PROFILE_ERM_OPEN_LOOP   = 1,  /* ERM 开环 */
+	DRV2605_PROFILE_LRA_ALERT       = 2,  /* LRA 高过驱“提醒”调校 */
+	DRV2605_PROFILE_COUNT
+} DRV2605_ProfileId;
+
+/* 一个配置档 = 持续震动配置 + 自动校准寄存器组 + 过驱/维持/制动时间 */
+typedef struct {
+	const char *name;                    /* 档名，供调试输出 */
+	DRV2605_ContinuousConfig continuous; /* LRA/ERM、驱动周期、强度、触感库 */
+	DRV2605_AutoCalConfig autoCal;       /* RATEDV/CLAMPV/CONTROL1~5 */
+	u8 overdrive;                        /* 寄存器 0x0D */
+	u8 sustainPos;                       /* 寄存器 0x0E */
+	u8 sustainNeg;                       /* 寄存器 0x0F */
+	u8 brake;                            /* 寄存器 0x10 */
+} DRV2605_Profile;
+
+/**
+ * @brief  获取 flash 中的配置档定义。
+ * @param  id 配置档编号。
+ * @return 配置档指针，编号非法时返回 NULL。
+ */
+const DRV2605_Profile *DRV2605_GetProfile(DRV2605_ProfileId id);
+
+/**
+ * @brief  切换到指定配置档，只写入与当前寄存器影子不同的寄存器。
+ * @note   差异寄存器按地址合并为连续写；影子未知的寄存器一律写入。
+ *         切换应在 GO = 0 时进行。
+ * @param  id 配置档编号。
+ * @return READY 成功，NoREADY 写入失败或编号非法。
+ */
+ErrorStatus DRV2605_ApplyProfile(DRV2605_ProfileId id);
+
+/**
+ * @brief  计算从当前状态切换到指定配置档需要写入的寄存器数量（不访问总线）。
+ * @param  id 配置档编号。
+ * @return 需要写入的寄存器个数。
+ */
+u8 DRV2605_ProfileDiffCount(DRV2605_ProfileId id);
+
+/**
+ * @brief  获取最近一次成功应用的配置档，未应用过时返回 DRV2605_PROFILE_COUNT。
+ */
+DRV2605_ProfileId DRV2605_GetActiveProfile(void);
+
+#endif /* __DRV2605_PROFILE_H */
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * 文件名   : drv2605_script.c
+ * 描述     : DRV2605 寄存器脚本解释器：段内按地址排序、合并连续写。
+ ******************************************************************************/
+#include "drv2605_script.h"
+
+#define SCRIPT_BURST_MAX     16
+#define SCRIPT_GAP_FILL_MAX  2   /* 不超过 2 字节的空洞用影子值补齐，比新开一次事务更省总线 */
+
+static u8 s_stage[DRV2605_REG_COUNT];
+static u8 s_pending[(DRV2605_REG_COUNT + 7) / 8];
+
+static u8 Script_IsPending(u8 index) {
+    return (s_pending[index >> 3] >> (index & 0x07)) & 0x01;
+}
+
+/* 从 index 起若 1~2 个寄存器影子已知且其后仍有待写项，则用影子值补齐 */
+static u8 Script_FillGap(u8 index, u8 room) {
+    u8 gap = 0;
+    while(gap < SCRIPT_GAP_FILL_MAX && gap < room && (u8)(index + gap) < DRV2605_REG_COUNT) {
+        u8 reg = (u8)(index + gap);
+        if(Script_IsPending(reg)) {
+            break;
+        }
+        if(DRV2605_GetShadowRegister((DRV2605_Register)reg, &s_stage[reg]) == NoREADY) {
+            return 0;
+        }
+        gap++;
+    }
+    if(gap == 0 || gap >= room || (u8)(index + gap) >= DRV2605_REG_COUNT ||
+       !Script_IsPending((u8)(index + gap))) {
+        return 0;
+    }
+    return gap;
+}
+
+static void Script_ClearPending(void) {
+    for(u8 i = 0; i < sizeof(s_pending); i++) {
+        s_pending[i] = 0;
+    }
+}
+
+/******************************************************************************
+ * @brief  追加一项到当前段，掩码字段在本地合成。
+ ******************************************************************************/
+ErrorStatus DRV2605_ScriptPut(DRV2605_Register reg, u8 value, u8 mask) {
+    u8 index = (u8)reg;
+    u8 base = 0;
+
+    if(index >= DRV2605_REG_COUNT) {
+        return NoREADY;
+    }
+
+    if(mask != 0xFF) {
+        if(Script_IsPending(index)) {
+            base = s_stage[index];
+        } else if(DRV2605_GetShadowRegister(reg, &base) == NoREADY) {
+            if(DRV2605_ReadRegister(reg, &base) == NoREADY) {
+                return NoREADY;
+            }
+        }
+        value = (u8)((base & (u8)~mask) | (value & mask));
+    }
+
+    s_stage[index] = value;
+    s_pending[index >> 3] |= (u8)(1U << (index & 0x07));
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  升序扫描待写寄存器，连续地址合并为一次写。
+ ******************************************************************************/
+ErrorStatus DRV2605_ScriptFlush(void) {
+    ErrorStatus status = READY;
+    u8 index = 0;
+
+    while(index < DRV2605_REG_COUNT) {
+        if(!Script_IsPending(index)) {
+            index++;
+            continue;
+        }
+        u8 start = index;
+        u8 length = 0;
+        while(index < DRV2605_REG_COUNT && length < SCRIPT_BURST_MAX) {
+            if(Script_IsPending(index)) {
+                index++;
+                length++;
+                continue;
+            }
+            u8 gap = Script_FillGap(index, (u8)(SCRIPT_BURST_MAX - length));
+            if(gap == 0) {
+                break;
+            }
+            index = (u8)(index + gap);
+            length = (u8)(length + gap);
+        }
+        if(DRV2605_WriteRegisters((DRV2605_Register)start, &s_stage[start], length) == NoREADY) {
+            status = NoREADY;
+            break;
+        }
+    }
+
+    Script_ClearPending();
+    return status;
+}
+
+/******************************************************************************
+ * @brief  执行脚本表，遇到延时/屏障项时先提交再等待。
+ ******************************************************************************/
+ErrorStatus DRV2605_ScriptRun(const DRV2605_ScriptEntry *entries, u8 count) {
+    if(entries == NULL) {
+        return NoREADY;
+    }
+
+    for(u8 i = 0; i < count; i++) {
+        const DRV2605_ScriptEntry *entry = &entries[i];
+        if(DRV2605_ScriptPut((DRV2605_Register)entry->reg, entry->value, entry->mask) == NoREADY) {
+            Script_ClearPending();
+            return NoREADY;
+        }
+        if(entry->delayMs != 0) {
+            if(DRV2605_ScriptFlush() == NoREADY) {
+                return NoREADY;
+            }
+            if(entry->delayMs != DRV2605_SCRIPT_SYNC) {
+                Delay_Ms(entry->delayMs);
+            }
+        }
+    }
+
+    return DRV2605_ScriptFlush();
+}
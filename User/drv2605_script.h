@@ -0,0 +1,52 @@
+/******************************************************************************
+ * 文件名   : drv2605_script.h
+ * 描述     : DRV2605 声明式寄存器初始化脚本（查表 + 连续写合并）。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __DRV2605_SCRIPT_H
+#define __DRV2605_SCRIPT_H
+
+#include "drv2605.h"
+
+/* delayMs 取该值时仅作为顺序屏障，不延时 */
+#define DRV2605_SCRIPT_SYNC        0xFF
+
+/* 单条脚本项：写入后若 delayMs 非 0，则先提交之前累积的全部写入再延时 */
+typedef struct {
+	u8 reg;      /* 寄存器地址 */
+	u8 value;    /* 目标值 */
+	u8 mask;     /* 需要修改的位，0xFF 表示整字节写入 */
+	u8 delayMs;  /* 写入后强制等待时间，DRV2605_SCRIPT_SYNC 表示仅排序屏障 */
+} DRV2605_ScriptEntry;
+
+#define DRV2605_SCRIPT_SET(reg, value)          { (u8)(reg), (u8)(value), 0xFF, 0 }
+#define DRV2605_SCRIPT_FIELD(reg, value, mask)  { (u8)(reg), (u8)(value), (u8)(mask), 0 }
+#define DRV2605_SCRIPT_WAIT(reg, value, ms)     { (u8)(reg), (u8)(value), 0xFF, (u8)(ms) }
+#define DRV2605_SCRIPT_BARRIER(reg, value)      { (u8)(reg), (u8)(value), 0xFF, DRV2605_SCRIPT_SYNC }
+
+/**
+ * @brief  执行一张脚本表。
+ * @note   两个屏障之间的写入按地址升序合并为若干次连续写（地址自增），
+ *         掩码字段基于影子寄存器在本地合成，影子未知时回读一次器件。
+ * @param  entries 脚本表（可放在 flash 中）。
+ * @param  count   表项数量。
+ * @return READY 成功，NoREADY 写入失败或参数非法。
+ */
+ErrorStatus DRV2605_ScriptRun(const DRV2605_ScriptEntry *entries, u8 count);
+
+/**
+ * @brief  向当前未提交的段追加一项（供运行期参数拼接脚本使用）。
+ * @param  reg   寄存器地址。
+ * @param  value 目标值。
+ * @param  mask  需要修改的位。
+ * @return READY 成功，NoREADY 地址越界或掩码合成时回读失败。
+ */
+ErrorStatus DRV2605_ScriptPut(DRV2605_Register reg, u8 value, u8 mask);
+
+/**
+ * @brief  提交当前段：按升序把累积的寄存器分组为连续写。
+ * @return READY 成功，NoREADY 写入失败。
+ */
+ErrorStatus DRV2605_ScriptFlush(void);
+
+#endif /* __DRV2605_SCRIPT_H */
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * 文件名   : haptic_bank.c
+ * 描述     : A/B 图案库。更新时只写非活动槽：擦除 → 逐页快速编程 → 回读 CRC →
+ *            编程提交页；活动槽在整个过程中保持可读。
+ ******************************************************************************/
+#include "haptic_bank.h"
+#include "haptic_config.h"
+#include "haptic_link.h"
+
+/* 未选用图案库时整个模块不编译：无人引用 _bank_start，Link.ld 便不保留 BANK 页 */
+#if HAPTIC_USE_BANK
+
+#define BANK_MAGIC             0x4B42
+#define BANK_VERSION           1
+#define BANK_SLOTS             2
+#define BANK_HEADER_CRC_BYTES  12     /* headerCrc 之前的字段 */
+
+extern const u8 _bank_start[];   /* Link.ld 中的 BANK 区 */
+
+typedef struct {
+	u16 magic;
+	u8 version;
+	u8 count;
+	u32 generation;
+	u16 size;
+	u16 imageCrc;
+	u16 headerCrc;
+} Bank_Header;
+
+static HapticBank_Info s_info;
+static u8 s_target = HAPTIC_BANK_NONE;   /* 正在写入的槽 */
+static u16 s_expect;                     /* 声明的映像长度 */
+static u16 s_written;
+static u32 s_page[HAPTIC_BANK_PAGE_BYTES / 4];
+
+static const u8 *Bank_Slot(u8 slot) {
+    return _bank_start + (u16)slot * HAPTIC_BANK_SLOT_BYTES;
+}
+
+static const Bank_Header *Bank_GetHeader(u8 slot) {
+    return (const Bank_Header *)(Bank_Slot(slot) + HAPTIC_BANK_IMAGE_MAX);
+}
+
+static u32 Bank_Address(u8 slot, u16 offset) {
+    return FLASH_BASE | (u32)(Bank_Slot(slot) + offset);
+}
+
+static void Bank_PageClear(void) {
+    for(u8 i = 0; i < HAPTIC_BANK_PAGE_BYTES / 4; i++) {
+        s_page[i] = 0xFFFFFFFFUL;
+    }
+}
+
+static ErrorStatus Bank_Program(u16 offset) {
+    if(FLASH_ROM_WRITE(Bank_Address(s_target, offset), s_page, HAPTIC_BANK_PAGE_BYTES) != FLASH_COMPLETE) {
+        s_target = HAPTIC_BANK_NONE;
+        return NoREADY;
+    }
+    Bank_PageClear();
+    return READY;
+}
+
+/* 头字段、头 CRC、映像 CRC 全部通过才算有效 */
+static u8 Bank_Valid(u8 slot) {
+    const Bank_Header *header = Bank_GetHeader(slot);
+
+    if(header->magic != BANK_MAGIC || header->version != BANK_VERSION ||
+       header->size > HAPTIC_BANK_IMAGE_MAX ||
+       (u16)header->count * HAPTIC_BANK_ENTRY_BYTES > header->size) {
+        return 0;
+    }
+    if(HapticLink_Crc16(0xFFFF, (const u8 *)header, BANK_HEADER_CRC_BYTES) != header->headerCrc) {
+        return 0;
+    }
+    return HapticLink_Crc16(0xFFFF, Bank_Slot(slot), header->size) == header->imageCrc;
+}
+
+/******************************************************************************
+ * @brief  两个槽都有效时取 generation 较新的一个（差值比较，容忍回绕）。
+ ******************************************************************************/
+void HapticBank_Init(void) {
+    s_info.slot = HAPTIC_BANK_NONE;
+    s_info.count = 0;
+    s_info.size = 0;
+    s_info.generation = 0;
+
+    for(u8 slot = 0; slot < BANK_SLOTS; slot++) {
+        const Bank_Header *header = Bank_GetHeader(slot);
+        if(!Bank_Valid(slot)) {
+            continue;
+        }
+        if(s_info.slot == HAPTIC_BANK_NONE || (s32)(header->generation - s_info.generation) > 0) {
+            s_info.slot = slot;
+            s_info.count = header->count;
+            s_info.size = header->size;
+            s_info.generation = header->generation;
+        }
+    }
+}
+
+const HapticBank_Info *HapticBank_GetInfo(void) {
+    return &s_info;
+}
+
+ErrorStatus HapticBank_Get(u8 index, HapticPattern *pattern) {
+    const u8 *image;
+    const u8 *entry;
+    u16 offset;
+    u16 size;
+
+    if(pattern == NULL || s_info.slot == HAPTIC_BANK_NONE || index >= s_info.count) {
+        return NoREADY;
+    }
+    image = Bank_Slot(s_info.slot);
+    entry = image + (u16)index * HAPTIC_BANK_ENTRY_BYTES;
+    offset = (u16)(entry[0] | ((u16)entry[1] << 8));
+    size = (u16)(entry[2] | ((u16)entry[3] << 8));
+    if(size == 0 || offset < (u16)s_info.count * HAPTIC_BANK_ENTRY_BYTES ||
+       (u32)offset + size > s_info.size) {
+        return NoREADY;
+    }
+    pattern->data = image + offset;
+    pattern->size = size;
+    pattern->unitMs = entry[4];
+    pattern->flags = entry[5];
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  目标为非活动槽（无有效槽时为槽 0）。
+ ******************************************************************************/
+ErrorStatus HapticBank_Begin(u16 size) {
+    u8 target = (s_info.slot == 0) ? 1 : 0;
+
+    s_target = HAPTIC_BANK_NONE;
+    if(size == 0 || size > HAPTIC_BANK_IMAGE_MAX) {
+        return NoREADY;
+    }
+    if(FLASH_ROM_ERASE(Bank_Address(target, 0), HAPTIC_BANK_SLOT_BYTES) != FLASH_COMPLETE) {
+        return NoREADY;
+    }
+    s_target = target;
+    s_expect = size;
+    s_written = 0;
+    Bank_PageClear();
+    return READY;
+}
+
+u16 HapticBank_Written(void) {
+    return s_written;
+}
+
+ErrorStatus HapticBank_Put(u8 value) {
+    if(s_target == HAPTIC_BANK_NONE || s_written >= s_expect) {
+        return NoREADY;
+    }
+    ((u8 *)s_page)[s_written & (HAPTIC_BANK_PAGE_BYTES - 1)] = value;
+    s_written++;
+    if((s_written & (HAPTIC_BANK_PAGE_BYTES - 1)) == 0) {
+        return Bank_Program((u16)(s_written - HAPTIC_BANK_PAGE_BYTES));
+    }
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  补写末页 → 回读 CRC → 编程提交页 → 重新选槽。
+ ******************************************************************************/
+ErrorStatus HapticBank_Commit(u16 crc) {
+    Bank_Header *header = (Bank_Header *)s_page;
+    u8 target = s_target;
+    u8 count;
+
+    if(target == HAPTIC_BANK_NONE || s_written != s_expect) {
+        return NoREADY;
+    }
+    if((s_written & (HAPTIC_BANK_PAGE_BYTES - 1)) != 0 &&
+       Bank_Program((u16)(s_written & ~(HAPTIC_BANK_PAGE_BYTES - 1))) == NoREADY) {
+        return NoREADY;
+    }
+    if(HapticLink_Crc16(0xFFFF, Bank_Slot(target), s_written) != crc) {
+        s_target = HAPTIC_BANK_NONE;
+        return NoREADY;
+    }
+
+    /* 索引项数由第一个索引项的偏移推出 */
+    count = (u8)((Bank_Slot(target)[0] | ((u16)Bank_Slot(target)[1] << 8)) / HAPTIC_BANK_ENTRY_BYTES);
+    header->magic = BANK_MAGIC;
+    header->version = BANK_VERSION;
+    header->count = count;
+    header->generation = s_info.generation + 1;
+    header->size = s_written;
+    header->imageCrc = crc;
+    header->headerCrc = HapticLink_Crc16(0xFFFF, (const u8 *)header, BANK_HEADER_CRC_BYTES);
+    if(Bank_Program(HAPTIC_BANK_IMAGE_MAX) == NoREADY) {
+        return NoREADY;
+    }
+    s_target = HAPTIC_BANK_NONE;
+
+    HapticBank_Init();
+    return (s_info.slot == target) ? READY : NoREADY;
+}
+
+#endif /* HAPTIC_USE_BANK */
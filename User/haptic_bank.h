@@ -0,0 +1,76 @@
+/******************************************************************************
+ * 文件名   : haptic_bank.h
+ * 描述     : flash 图案库：Link.ld 预留的 BANK 区分为 A/B 两个槽，运行中经主机链路
+ *            写入非活动槽，提交页写完才切换，图案直接从 flash 原地播放。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_BANK_H
+#define __HAPTIC_BANK_H
+
+#include "haptic_pattern.h"
+
+/*
+ * 槽布局（HAPTIC_BANK_SLOT_BYTES）：
+ *   [0, HAPTIC_BANK_IMAGE_MAX)   映像：count 个索引项 + 图案数据
+ *   最后 64 字节                  提交页：magic, version, count, generation,
+ *                                size, 映像 CRC16, 头 CRC16
+ * 索引项 6 字节（小端）：offset u16（相对映像起点）, size u16, unitMs u8, flags u8。
+ * 映像由 Tools/pattern_pack.cpp --bank 生成。提交页最后编程，掉电或中断的
+ * 更新不会产生有效槽；两个槽都有效时 generation 大者为活动槽。
+ */
+#define HAPTIC_BANK_SLOT_BYTES     512
+#define HAPTIC_BANK_PAGE_BYTES     64
+#define HAPTIC_BANK_IMAGE_MAX      (HAPTIC_BANK_SLOT_BYTES - HAPTIC_BANK_PAGE_BYTES)
+#define HAPTIC_BANK_ENTRY_BYTES    6
+#define HAPTIC_BANK_NONE           0xFF
+
+/* 活动槽信息 */
+typedef struct {
+	u8 slot;          /* 0/1，HAPTIC_BANK_NONE 表示无有效槽 */
+	u8 count;         /* 图案数 */
+	u16 size;         /* 映像字节数 */
+	u32 generation;   /* 提交序号 */
+} HapticBank_Info;
+
+/**
+ * @brief  校验两个槽并选出活动槽。
+ */
+void HapticBank_Init(void);
+
+/**
+ * @brief  活动槽信息。
+ */
+const HapticBank_Info *HapticBank_GetInfo(void);
+
+/**
+ * @brief  取活动槽中第 index 个图案；data 指向 flash，不复制。
+ * @return READY 成功，NoREADY 无有效槽、编号越界或索引项越界。
+ */
+ErrorStatus HapticBank_Get(u8 index, HapticPattern *pattern);
+
+/**
+ * @brief  开始更新：擦除非活动槽，准备接收 size 字节映像。
+ * @note   擦除期间 CPU 停顿，不可在播放过程中调用。
+ * @return READY 成功，NoREADY 长度非法或擦除失败。
+ */
+ErrorStatus HapticBank_Begin(u16 size);
+
+/**
+ * @brief  已接收的映像字节数（下一次写入的偏移）。
+ */
+u16 HapticBank_Written(void);
+
+/**
+ * @brief  追加一个映像字节；凑满一页即编程。
+ * @return READY 成功，NoREADY 未开始更新、超出声明长度或编程失败。
+ */
+ErrorStatus HapticBank_Put(u8 value);
+
+/**
+ * @brief  写完剩余数据，校验映像 CRC 后编程提交页，切换活动槽。
+ * @param  crc 主机计算的映像 CRC16（初值 0xFFFF）。
+ * @return READY 已切换，NoREADY 长度不足、CRC 不符或编程失败（原活动槽不变）。
+ */
+ErrorStatus HapticBank_Commit(u16 crc);
+
+#endif /* __HAPTIC_BANK_H */
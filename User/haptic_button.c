@@ -0,0 +1,239 @@
+/******************************************************************************
+ * 文件名   : haptic_button.c
+ * 描述     : EXTI7_0 中断按引脚电平区分边沿，去抖后查表触发；快速路径失败
+ *            （总线被主循环占用、器件待机或断电、MODE 不符）时记入待处理项。
+ ******************************************************************************/
+#include "haptic_button.h"
+#include "haptic_config.h"
+#include "haptic_power.h"
+#include "haptic_rtp.h"
+
+/* 未选用按键时整个模块连同 EXTI7_0 中断都不编译，向量落到启动文件的弱定义 */
+#if HAPTIC_USE_BUTTON
+
+#define BUTTON_MSTATUS_MIE  0x00000008UL
+
+void EXTI7_0_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+
+static const HapticButton_Map *s_map;
+static u8 s_count;
+static HapticButton_Config s_config;
+static DRV2605_Effect s_armed;          /* Arm 预写的效果，0 表示未预写 */
+static u32 s_lastEdge[HAPTIC_BUTTON_LINES];
+static volatile u8 s_pending = HAPTIC_BUTTON_NONE;
+static volatile u32 s_pendingAt;
+static HapticButton_Stats s_stats;
+static HapticInstr_Probe s_fastLatency;
+static HapticInstr_Probe s_deferredLatency;
+
+static GPIO_TypeDef *Button_Port(u8 portSource) {
+    if(portSource == GPIO_PortSourceGPIOA) {
+        return GPIOA;
+    }
+    return (portSource == GPIO_PortSourceGPIOC) ? GPIOC : GPIOD;
+}
+
+/* 影子中 MODE 为外部边沿触发且 WAVESEQ1 仍是预写效果时，拉高 IN/TRIG 约 1us */
+static ErrorStatus Button_Pulse(DRV2605_Effect effect) {
+    u32 start;
+    u8 mode;
+    u8 seq;
+
+    if(s_config.trigPort == NULL || effect != s_armed ||
+       DRV2605_GetShadowRegister(DRV2605_REG_MODE, &mode) == NoREADY || mode != DRV2605_MODE_EXT_EDGE ||
+       DRV2605_GetShadowRegister(DRV2605_REG_WAVESEQ1, &seq) == NoREADY || seq != (u8)effect) {
+        return NoREADY;
+    }
+    GPIO_SetBits(s_config.trigPort, s_config.trigPin);
+    start = HapticInstr_Cycles();
+    while(HapticInstr_Cycles() - start < HapticInstr_CyclesPerUs()) {
+    }
+    GPIO_ResetBits(s_config.trigPort, s_config.trigPin);
+    return READY;
+}
+
+static void Button_Edge(u8 line, u32 now) {
+    const HapticButton_Map *entry = NULL;
+    u8 edge = HAPTIC_BUTTON_FALLING;
+    u8 index;
+
+    if(now - s_lastEdge[line] < HAPTIC_BUTTON_DEBOUNCE_MS * 1000UL * HapticInstr_CyclesPerUs()) {
+        s_stats.bounced++;
+        return;
+    }
+    s_lastEdge[line] = now;
+
+    for(index = 0; index < s_count; index++) {
+        entry = &s_map[index];
+        if(entry->pin != line) {
+            continue;
+        }
+        edge = (GPIO_ReadInputDataBit(Button_Port(entry->port), (u16)(1U << line)) == Bit_SET) ?
+               HAPTIC_BUTTON_RISING : HAPTIC_BUTTON_FALLING;
+        if(entry->edge == edge) {
+            break;
+        }
+    }
+    if(index == s_count) {
+        return;
+    }
+
+    /* 待机/断电时唤醒要延时，不能在中断里做 */
+    if(entry->pattern == NULL && HapticPower_GetState() == HAPTIC_POWER_ACTIVE &&
+       (Button_Pulse(entry->effect) == READY || DRV2605_FireFromIsr(entry->effect) == READY)) {
+        HapticThermal_QueueRom(HapticRtp_GetThermal(), entry->effect);
+        s_stats.fast++;
+        HapticInstr_ProbeAdd(&s_fastLatency, HapticInstr_Cycles() - now);
+        return;
+    }
+    if(s_pending != HAPTIC_BUTTON_NONE) {
+        s_stats.dropped++;
+    }
+    s_pending = index;
+    s_pendingAt = now;
+    s_stats.deferred++;
+}
+
+/******************************************************************************
+ * @brief  同一引脚两个边沿都有表项时 EXTI 配置为双边沿。
+ ******************************************************************************/
+void HapticButton_Init(const HapticButton_Map *map, u8 count, const HapticButton_Config *cfg) {
+    GPIO_InitTypeDef gpio = {0};
+    EXTI_InitTypeDef exti = {0};
+    u8 edges[HAPTIC_BUTTON_LINES] = {0};
+
+    s_map = map;
+    s_count = (map != NULL) ? count : 0;
+    if(cfg != NULL) {
+        s_config = *cfg;
+    }
+    s_armed = (DRV2605_Effect)0;
+    s_pending = HAPTIC_BUTTON_NONE;
+    s_stats.fast = 0;
+    s_stats.deferred = 0;
+    s_stats.bounced = 0;
+    s_stats.dropped = 0;
+    HapticInstr_ProbeReset(&s_fastLatency);
+    HapticInstr_ProbeReset(&s_deferredLatency);
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOC | RCC_APB2Periph_GPIOD |
+                           RCC_APB2Periph_AFIO, ENABLE);
+    if(s_config.trigPort != NULL) {
+        gpio.GPIO_Pin = s_config.trigPin;
+        gpio.GPIO_Mode = GPIO_Mode_Out_PP;
+        gpio.GPIO_Speed = GPIO_Speed_30MHz;
+        GPIO_Init(s_config.trigPort, &gpio);
+        GPIO_ResetBits(s_config.trigPort, s_config.trigPin);
+    }
+
+    for(u8 i = 0; i < s_count; i++) {
+        if(map[i].pin >= HAPTIC_BUTTON_LINES) {
+            continue;
+        }
+        gpio.GPIO_Pin = (u16)(1U << map[i].pin);
+        gpio.GPIO_Mode = GPIO_Mode_IPU;
+        GPIO_Init(Button_Port(map[i].port), &gpio);
+        GPIO_EXTILineConfig(map[i].port, map[i].pin);
+        edges[map[i].pin] |= (u8)(1U << map[i].edge);
+    }
+    for(u8 line = 0; line < HAPTIC_BUTTON_LINES; line++) {
+        if(edges[line] == 0) {
+            continue;
+        }
+        exti.EXTI_Line = 1UL << line;
+        exti.EXTI_Mode = EXTI_Mode_Interrupt;
+        exti.EXTI_Trigger = (edges[line] == 0x03) ? EXTI_Trigger_Rising_Falling :
+                            (edges[line] == 0x02) ? EXTI_Trigger_Rising : EXTI_Trigger_Falling;
+        exti.EXTI_LineCmd = ENABLE;
+        EXTI_Init(&exti);
+        EXTI_ClearITPendingBit(exti.EXTI_Line);
+        s_lastEdge[line] = HapticInstr_Cycles();
+    }
+    NVIC_EnableIRQ(EXTI7_0_IRQn);
+}
+
+ErrorStatus HapticButton_Arm(void) {
+    for(u8 i = 0; i < s_count; i++) {
+        if(s_map[i].pattern != NULL) {
+            continue;
+        }
+        if(DRV2605_StageRomSequence(DRV2605_LIBRARY_LRA, &s_map[i].effect, 1) == NoREADY ||
+           DRV2605_SetMode((s_config.trigPort != NULL) ? DRV2605_MODE_EXT_EDGE : DRV2605_MODE_INT_TRIG) == NoREADY) {
+            s_armed = (DRV2605_Effect)0;
+            return NoREADY;
+        }
+        s_armed = s_map[i].effect;
+        return READY;
+    }
+    return NoREADY;
+}
+
+/******************************************************************************
+ * @brief  ROM 效果按常规路径预写后 GO；图案计时到开始播放为止，播放结束后
+ *         MODE 为 RTP，重新 Arm。
+ ******************************************************************************/
+u8 HapticButton_Poll(void) {
+    static HapticPatternDecoder decoder;
+    const HapticButton_Map *entry;
+    u32 mstatus = __get_MSTATUS();
+    u32 edgeAt;
+    u8 index;
+
+    __set_MSTATUS(mstatus & ~BUTTON_MSTATUS_MIE);
+    index = s_pending;
+    edgeAt = s_pendingAt;
+    s_pending = HAPTIC_BUTTON_NONE;
+    __set_MSTATUS(mstatus);
+    if(index == HAPTIC_BUTTON_NONE) {
+        return 0;
+    }
+    entry = &s_map[index];
+
+    if(entry->pattern == NULL) {
+        if(DRV2605_StageRomSequence(DRV2605_LIBRARY_LRA, &entry->effect, 1) == READY &&
+           DRV2605_CommitRomTransition() == READY) {
+            HapticInstr_ProbeAdd(&s_deferredLatency, HapticInstr_Cycles() - edgeAt);
+            HapticThermal_Update(HapticRtp_GetThermal());
+            HapticThermal_AccountRom(HapticRtp_GetThermal(), entry->effect);
+        }
+        return 1;
+    }
+
+    HapticPattern_Start(&decoder, entry->pattern);
+    HapticInstr_ProbeAdd(&s_deferredLatency, HapticInstr_Cycles() - edgeAt);
+    HapticRtp_Play(HapticPattern_Source, &decoder);
+    HapticButton_Arm();
+    return 1;
+}
+
+const HapticButton_Stats *HapticButton_GetStats(void) {
+    return &s_stats;
+}
+
+const HapticInstr_Probe *HapticButton_GetFastLatency(void) {
+    return &s_fastLatency;
+}
+
+const HapticInstr_Probe *HapticButton_GetDeferredLatency(void) {
+    return &s_deferredLatency;
+}
+
+/*********************************************************************
+ * @fn      EXTI7_0_IRQHandler
+ *
+ * @brief   EXTI 线 0~7：时间戳取在中断入口，作为边沿时刻。
+ *
+ * @return  none
+ */
+void EXTI7_0_IRQHandler(void) {
+    u32 now = HapticInstr_Cycles();
+
+    for(u8 line = 0; line < HAPTIC_BUTTON_LINES; line++) {
+        if(EXTI_GetITStatus(1UL << line) != RESET) {
+            EXTI_ClearITPendingBit(1UL << line);
+            Button_Edge(line, now);
+        }
+    }
+}
+
+#endif /* HAPTIC_USE_BUTTON */
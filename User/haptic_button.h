@@ -0,0 +1,80 @@
+/******************************************************************************
+ * 文件名   : haptic_button.h
+ * 描述     : 按键/传感器边沿到触感的映射：flash 中的常量表把 EXTI 线与边沿
+ *            对应到 ROM 效果或压缩图案。ROM 效果在中断中直接触发（IN/TRIG
+ *            引脚脉冲或一次突发写 GO），其余情况交给主循环播放。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_BUTTON_H
+#define __HAPTIC_BUTTON_H
+
+#include "drv2605.h"
+#include "haptic_pattern.h"
+#include "haptic_instr.h"
+
+#define HAPTIC_BUTTON_LINES        8     /* EXTI 线 0~7，对应各端口同号引脚 */
+#define HAPTIC_BUTTON_DEBOUNCE_MS  20
+#define HAPTIC_BUTTON_NONE         0xFF
+
+typedef enum {
+	HAPTIC_BUTTON_FALLING = 0,
+	HAPTIC_BUTTON_RISING  = 1
+} HapticButton_Edge;
+
+/*
+ * 映射表项。引脚配置为上拉输入（按键接地），同一引脚可分别为两个边沿
+ * 各配一项。pattern 非空时播放图案（需要 RTP 循环，总在主循环中执行）。
+ */
+typedef struct {
+	u8 port;                       /* GPIO_PortSourceGPIOA/C/D */
+	u8 pin;                        /* 引脚号 0~7，即 EXTI 线号 */
+	u8 edge;                       /* HapticButton_Edge */
+	DRV2605_Effect effect;         /* LRA 库 ROM 效果 */
+	const HapticPattern *pattern;  /* 非空时代替 effect */
+} HapticButton_Map;
+
+typedef struct {
+	GPIO_TypeDef *trigPort;  /* DRV2605 IN/TRIG 所接引脚，未连线时为 NULL */
+	u16 trigPin;
+} HapticButton_Config;
+
+typedef struct {
+	u16 fast;       /* 中断内直接触发 */
+	u16 deferred;   /* 转主循环播放 */
+	u16 bounced;    /* 去抖丢弃 */
+	u16 dropped;    /* 主循环未及处理即被新边沿覆盖 */
+} HapticButton_Stats;
+
+/**
+ * @brief  配置表中各引脚与 EXTI 线并开启中断。
+ * @param  map   映射表（常量，留在 flash），count 项。
+ * @param  cfg   IN/TRIG 连线，NULL 表示只用 I2C 触发。
+ */
+void HapticButton_Init(const HapticButton_Map *map, u8 count, const HapticButton_Config *cfg);
+
+/**
+ * @brief  预写表中第一个 ROM 效果：接了 IN/TRIG 时 MODE 置外部边沿触发，
+ *         否则置内部触发，使下一次边沿只需引脚脉冲或单字节 GO。
+ * @note   主循环调用；其他播放改变 MODE 后需重新调用才能恢复引脚路径。
+ */
+ErrorStatus HapticButton_Arm(void);
+
+/**
+ * @brief  主循环调用：播放中断转交的效果或图案。
+ * @return 1 本次播放了一项，0 无待处理。
+ */
+u8 HapticButton_Poll(void);
+
+const HapticButton_Stats *HapticButton_GetStats(void);
+
+/**
+ * @brief  中断入口到 GO（或引脚脉冲）完成的耗时，单位周期。
+ */
+const HapticInstr_Probe *HapticButton_GetFastLatency(void);
+
+/**
+ * @brief  中断入口到主循环 GO（图案为开始播放）的耗时，单位周期。
+ */
+const HapticInstr_Probe *HapticButton_GetDeferredLatency(void);
+
+#endif /* __HAPTIC_BUTTON_H */
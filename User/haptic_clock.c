@@ -0,0 +1,130 @@
+/******************************************************************************
+ * 文件名   : haptic_clock.c
+ * 描述     : 时钟档位切换。升频先加 flash 等待周期再切源，降频先切源再减等待
+ *            周期；低档位关闭 PLL。
+ ******************************************************************************/
+#include "haptic_clock.h"
+#include "haptic_log.h"
+
+#define CLOCK_MSTATUS_MIE   0x00000008UL
+
+static HapticClock_Config s_config;
+static HapticClock_Level s_level = HAPTIC_CLOCK_48MHZ;
+static HapticInstr_Probe s_switchCost;
+
+/* 从任意时钟源（含 Standby 唤醒后的 HSI）切到目标档位 */
+static ErrorStatus Clock_Apply(HapticClock_Level level) {
+    RCC_HSEConfig(RCC_HSE_ON);
+    if(RCC_WaitForHSEStartUp() == NoREADY) {
+        return NoREADY;
+    }
+
+    if(level == HAPTIC_CLOCK_48MHZ) {
+        FLASH_SetLatency(FLASH_Latency_1);
+        RCC_HCLKConfig(RCC_SYSCLK_Div1);
+        if(RCC_GetFlagStatus(RCC_FLAG_PLLRDY) == RESET) {
+            RCC_PLLConfig(RCC_PLLSource_HSE_MUL2);
+            RCC_PLLCmd(ENABLE);
+            while(RCC_GetFlagStatus(RCC_FLAG_PLLRDY) == RESET) {
+            }
+        }
+        RCC_SYSCLKConfig(RCC_SYSCLKSource_PLLCLK);
+        while(RCC_GetSYSCLKSource() != 0x08) {
+        }
+        return READY;
+    }
+
+    RCC_HCLKConfig((level == HAPTIC_CLOCK_8MHZ) ? RCC_SYSCLK_Div3 : RCC_SYSCLK_Div1);
+    RCC_SYSCLKConfig(RCC_SYSCLKSource_HSE);
+    while(RCC_GetSYSCLKSource() != 0x04) {
+    }
+    FLASH_SetLatency(FLASH_Latency_0);
+    RCC_PLLCmd(DISABLE);
+    return READY;
+}
+
+/* I2C_Init 按 PCLK1 重算 FREQ 与 CKCFGR；参数与 IIC_Init 一致（主机模式） */
+static void Clock_Retime(void) {
+    I2C_InitTypeDef i2c = {0};
+    RCC_ClocksTypeDef clocks;
+
+    SystemCoreClockUpdate();
+    HapticInstr_Retime();
+    Delay_Init();
+
+    RCC_GetClocksFreq(&clocks);
+    USART1->BRR = (u16)((clocks.PCLK2_Frequency + s_config.baud / 2) / s_config.baud);
+
+    i2c.I2C_ClockSpeed = s_config.i2cSpeed;
+    i2c.I2C_Mode = I2C_Mode_I2C;
+    i2c.I2C_DutyCycle = I2C_DutyCycle_16_9;
+    i2c.I2C_OwnAddress1 = 0x00;
+    i2c.I2C_Ack = I2C_Ack_Enable;
+    i2c.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+    I2C_Init(I2C1, &i2c);
+}
+
+static ErrorStatus Clock_Switch(HapticClock_Level level) {
+    u32 start;
+    u32 mstatus;
+    ErrorStatus status;
+
+    HapticLog_Flush();
+    start = HapticInstr_Cycles();
+    mstatus = __get_MSTATUS();
+    __set_MSTATUS(mstatus & ~CLOCK_MSTATUS_MIE);
+    status = Clock_Apply(level);
+    Clock_Retime();
+    __set_MSTATUS(mstatus);
+
+    if(status == READY) {
+        s_level = level;
+        HapticInstr_ProbeAdd(&s_switchCost, HapticInstr_Cycles() - start);
+    }
+    return status;
+}
+
+void HapticClock_Init(const HapticClock_Config *cfg) {
+    if(cfg != NULL) {
+        s_config = *cfg;
+    }
+    s_level = HAPTIC_CLOCK_48MHZ;
+    HapticInstr_ProbeReset(&s_switchCost);
+}
+
+ErrorStatus HapticClock_Set(HapticClock_Level level) {
+    if(level >= HAPTIC_CLOCK_LEVELS || s_config.baud == 0) {
+        return NoREADY;
+    }
+    if(level == s_level) {
+        return READY;
+    }
+    return Clock_Switch(level);
+}
+
+/******************************************************************************
+ * @brief  不计入切换耗时统计；HSE 未起振时仍运行于 HSI，外设按 HSI 重算。
+ ******************************************************************************/
+ErrorStatus HapticClock_Resume(void) {
+    u32 mstatus = __get_MSTATUS();
+    ErrorStatus status;
+
+    __set_MSTATUS(mstatus & ~CLOCK_MSTATUS_MIE);
+    status = Clock_Apply(s_level);
+    if(s_config.baud != 0) {
+        Clock_Retime();
+    } else {
+        SystemCoreClockUpdate();
+        HapticInstr_Retime();
+    }
+    __set_MSTATUS(mstatus);
+    return status;
+}
+
+HapticClock_Level HapticClock_Get(void) {
+    return s_level;
+}
+
+const HapticInstr_Probe *HapticClock_GetSwitchCost(void) {
+    return &s_switchCost;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * 文件名   : haptic_clock.h
+ * 描述     : 运行中切换系统时钟：48MHz（HSE×2 PLL）用于合成与混音，24MHz/8MHz
+ *            （HSE 直通 / 3 分频）用于空闲和受 I2C 总线限制的阶段。每次切换后
+ *            自动重算 Delay、I2C 时序、USART 波特率与 TIM2 计时倍率。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_CLOCK_H
+#define __HAPTIC_CLOCK_H
+
+#include "haptic_instr.h"
+
+typedef enum {
+	HAPTIC_CLOCK_48MHZ = 0,
+	HAPTIC_CLOCK_24MHZ = 1,
+	HAPTIC_CLOCK_8MHZ  = 2,
+	HAPTIC_CLOCK_LEVELS
+} HapticClock_Level;
+
+typedef struct {
+	u32 i2cSpeed;   /* 与 IIC_Init 相同的总线速率 */
+	u32 baud;       /* 与 USART_Printf_Init 相同的波特率 */
+} HapticClock_Config;
+
+/**
+ * @brief  记录需要随时钟重算的外设参数；当前时钟视为 48MHz。
+ * @note   在 IIC_Init、USART_Printf_Init 与 HapticInstr_Init 之后调用。
+ */
+void HapticClock_Init(const HapticClock_Config *cfg);
+
+/**
+ * @brief  切换系统时钟并重算相关外设。
+ * @note   先排空日志，整个切换在关中断下完成；不可在 I2C 事务或 RTP 播放
+ *         过程中调用。8MHz 下 460800 波特率误差约 2%，主机链路建议用 24MHz。
+ * @return READY 成功，NoREADY HSE 未起振（保持原时钟）。
+ */
+ErrorStatus HapticClock_Set(HapticClock_Level level);
+
+/**
+ * @brief  Standby 唤醒后（此时运行于 HSI）恢复切换前的档位。
+ */
+ErrorStatus HapticClock_Resume(void);
+
+HapticClock_Level HapticClock_Get(void);
+
+/**
+ * @brief  单次切换耗时（含日志排空之后的时钟切换与外设重算），单位周期。
+ */
+const HapticInstr_Probe *HapticClock_GetSwitchCost(void);
+
+#endif /* __HAPTIC_CLOCK_H */
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * 文件名   : haptic_config.h
+ * 描述     : 构建开关：产品固件与各演示组的功能取舍。CH32V003 只有 16KB flash，
+ *            装不下全部模块；每个镜像只编入自己用到的部分，超出预算时由
+ *            Link.ld 的 ASSERT 在链接时报错。各开关均可在编译命令行用 -D 覆盖。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_CONFIG_H
+#define __HAPTIC_CONFIG_H
+
+/* 0 为产品固件；非 0 时编入一组 Demo_* 轮播（每组单独一个镜像） */
+#ifndef HAPTIC_DEMO
+#define HAPTIC_DEMO                0
+#endif
+
+#define HAPTIC_DEMO_DRIVER         1   /* 频率/连续/ROM 与调校、共振/VBAT 跟踪 */
+#define HAPTIC_DEMO_RENDER         2   /* 合成/关键帧/混音/SWAR 核对比/抖动 */
+#define HAPTIC_DEMO_HOST           3   /* 主机链路与协议统计 */
+#define HAPTIC_DEMO_POWER          4   /* 热预算/过驱刹车/待机提醒 */
+#define HAPTIC_DEMO_INPUT          5   /* 图案、按键与力敏传感器中断触发 */
+
+/*
+ * 功能开关，1 编入，0 不编入（中断入口一并去掉）。产品默认只编入主机链路与
+ * 电源管理，约 14.0KB；括号内为在此基础上多编入该项时增加的 flash
+ * （RV32EC -Os 估算）。BANK/TUNE 页只在编入图案库/调校参数时保留。
+ */
+
+/* 主机串口链路与命令协议（产品默认，约 6.2KB） */
+#ifndef HAPTIC_USE_HOST
+#define HAPTIC_USE_HOST            (HAPTIC_DEMO == 0 || HAPTIC_DEMO == HAPTIC_DEMO_HOST)
+#endif
+
+/* EXTI 按键与中断快速触发（+2.6KB，与主机链路合计超出 16KB） */
+#ifndef HAPTIC_USE_BUTTON
+#define HAPTIC_USE_BUTTON          (HAPTIC_DEMO == HAPTIC_DEMO_INPUT)
+#endif
+
+/* ADC 看门狗力敏传感器（+1.9KB） */
+#ifndef HAPTIC_USE_SENSOR
+#define HAPTIC_USE_SENSOR          (HAPTIC_DEMO == HAPTIC_DEMO_INPUT)
+#endif
+
+/* flash 图案库：主机下载与 BANK_PLAY（+3.0KB 并保留 1KB BANK 页，
+ * 与主机链路合计超出 BANK 以下的 15296 字节） */
+#ifndef HAPTIC_USE_BANK
+#define HAPTIC_USE_BANK            0
+#endif
+
+/* flash 调校参数与主机 TUNE_* 命令（+2.0KB 并保留 64 字节 TUNE 页） */
+#ifndef HAPTIC_USE_TUNE
+#define HAPTIC_USE_TUNE            (HAPTIC_DEMO == HAPTIC_DEMO_DRIVER)
+#endif
+
+/* 播放间隙的共振与 VBAT 跟踪（+1.5KB） */
+#ifndef HAPTIC_USE_SUPPLY
+#define HAPTIC_USE_SUPPLY          (HAPTIC_DEMO == HAPTIC_DEMO_DRIVER)
+#endif
+
+/* RTP 过驱/刹车后处理（+0.8KB） */
+#ifndef HAPTIC_USE_KICK
+#define HAPTIC_USE_KICK            (HAPTIC_DEMO == HAPTIC_DEMO_POWER)
+#endif
+
+/* 延迟/开销探针，关闭时各探针保持清零（+0.3KB，另加各演示的统计输出） */
+#ifndef HAPTIC_USE_PROBE
+#define HAPTIC_USE_PROBE           (HAPTIC_DEMO != 0)
+#endif
+
+#endif /* __HAPTIC_CONFIG_H */
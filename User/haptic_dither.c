@@ -0,0 +1,85 @@
+/******************************************************************************
+ * 文件名   : haptic_dither.c
+ * 描述     : 误差反馈抖动。y = (x + e) >> shift，e = (x + e) 的低位，
+ *            输出噪声传递函数为 1 - z^-1（一阶高通）。
+ ******************************************************************************/
+#include "haptic_dither.h"
+
+#define DITHER_SHIFT    9                          /* 16 - 7 */
+#define DITHER_MASK     ((1U << DITHER_SHIFT) - 1U)
+#define DITHER_MAX_OUT  0x7F
+
+/******************************************************************************
+ * @brief  初始化量化器。
+ ******************************************************************************/
+void HapticDither_Init(HapticDither *dither) {
+    if(dither == NULL) {
+        return;
+    }
+    dither->residual = 0;
+}
+
+/******************************************************************************
+ * @brief  量化一块样本，误差带到下一样本；饱和时丢弃误差避免积分饱和。
+ ******************************************************************************/
+void HapticDither_Block(HapticDither *dither, const u16 *levels, u8 *samples, u16 count) {
+    u16 residual = dither->residual;
+
+    for(u16 i = 0; i < count; i++) {
+        u32 acc = (u32)levels[i] + residual;
+        u32 out = acc >> DITHER_SHIFT;
+        if(out > DITHER_MAX_OUT) {
+            samples[i] = DITHER_MAX_OUT;
+            residual = 0;
+        } else {
+            samples[i] = (u8)out;
+            residual = (u16)(acc & DITHER_MASK);
+        }
+    }
+
+    dither->residual = residual;
+}
+
+/******************************************************************************
+ * @brief  绑定样本源。
+ ******************************************************************************/
+void HapticDither_StageInit(HapticDither_Stage *stage, HapticDither_WideSource source, void *ctx) {
+    if(stage == NULL) {
+        return;
+    }
+    HapticDither_Init(&stage->dither);
+    stage->source = source;
+    stage->ctx = ctx;
+}
+
+/******************************************************************************
+ * @brief  按块拉取 16 位幅值并量化。
+ ******************************************************************************/
+u16 HapticDither_Source(void *ctx, u8 *samples, u16 count) {
+    HapticDither_Stage *stage = (HapticDither_Stage *)ctx;
+    u16 levels[HAPTIC_RTP_BLOCK];
+    u16 produced = 0;
+
+    if(stage == NULL || stage->source == NULL || samples == NULL) {
+        return 0;
+    }
+
+    while(produced < count) {
+        u16 chunk = (u16)(count - produced);
+        u16 got;
+        if(chunk > HAPTIC_RTP_BLOCK) {
+            chunk = HAPTIC_RTP_BLOCK;
+        }
+        got = stage->source(stage->ctx, levels, chunk);
+        if(got > chunk) {
+            got = chunk;
+        }
+        HapticDither_Block(&stage->dither, levels, samples + produced, got);
+        produced += got;
+        if(got < chunk) {
+            break;
+        }
+    }
+
+    return produced;
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * 文件名   : haptic_dither.h
+ * 描述     : 误差反馈（一阶噪声整形）抖动：16 位内部幅值 → 7 位 RTP 值，
+ *            量化误差累加到下一样本，时间平均保留亚 LSB 精度。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_DITHER_H
+#define __HAPTIC_DITHER_H
+
+#include "haptic_rtp.h"
+
+/*
+ * 16 位幅值约定：高 7 位为 RTP 值，低 9 位为小数，即 0xFE00 对应 0x7F。
+ * 只输出 7 位：增益、过驱/刹车与热预算各级都按有符号格式的 0~0x7F 处理样本，
+ * 0x80 以上会被当作负驱动。
+ * 量化噪声被推到高频（最高 500Hz 的 ±1 LSB 交替），由 LRA 的机械带通滤除。
+ * 注意：HapticRtp_Suppress 的阈值需为 0，否则 ±1 的交替会被当作不可感知而省略。
+ */
+
+/**
+ * @brief  16 位幅值样本源：向 levels 填充最多 count 个值。
+ * @return 实际数量，返回 0 表示结束。
+ */
+typedef u16 (*HapticDither_WideSource)(void *ctx, u16 *levels, u16 count);
+
+/* 量化器状态 */
+typedef struct {
+	u16 residual;  /* 上一样本留下的量化误差（低 9 位） */
+} HapticDither;
+
+/* 把 16 位样本源接到 RTP 输出的抖动级 */
+typedef struct {
+	HapticDither dither;
+	HapticDither_WideSource source;
+	void *ctx;
+} HapticDither_Stage;
+
+/**
+ * @brief  初始化量化器。
+ */
+void HapticDither_Init(HapticDither *dither);
+
+/**
+ * @brief  量化一块样本；逐样本为一次加法、移位、与运算和上限比较。
+ */
+void HapticDither_Block(HapticDither *dither, const u16 *levels, u8 *samples, u16 count);
+
+/**
+ * @brief  绑定 16 位样本源。
+ */
+void HapticDither_StageInit(HapticDither_Stage *stage, HapticDither_WideSource source, void *ctx);
+
+/**
+ * @brief  HapticRtp_Source 适配，ctx 为 HapticDither_Stage 指针。
+ */
+u16 HapticDither_Source(void *ctx, u8 *samples, u16 count);
+
+#endif /* __HAPTIC_DITHER_H */
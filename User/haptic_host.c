@@ -0,0 +1,442 @@
+/******************************************************************************
+ * 文件名   : haptic_host.c
+ * 描述     : 命令分发与 RTP 样本缓冲。命令数据通过读取器逐字节从 DMA 缓冲
+ *            取出，RTP 样本直接落入播放缓冲，中间不经过帧缓冲。
+ ******************************************************************************/
+#include "haptic_host.h"
+#include "haptic_config.h"
+#include "drv2605_profile.h"
+#include "haptic_tune.h"
+#include "haptic_bank.h"
+
+#define HOST_FIFO_MASK     (HAPTIC_HOST_RTP_FIFO - 1)
+
+static u8 s_fifo[HAPTIC_HOST_RTP_FIFO];
+static u16 s_fifoHead;    /* 读位置 */
+static u16 s_fifoTail;    /* 写位置 */
+static u8 s_streaming;     /* HapticRtp_Play 正在消费缓冲 */
+static u8 s_streamMode;    /* 主机流模式 */
+static u8 s_streamStop;    /* 已请求结束，放完缓冲即退出 */
+static u8 s_prebuffering;
+static u8 s_prebuffer;
+static u16 s_streamHz;
+static u16 s_consumed;     /* 累计消费样本（模 65536） */
+static u16 s_creditSent;   /* 最近一次通告时的 s_consumed */
+static u16 s_underruns;
+static u32 s_starveStart;
+#if HAPTIC_USE_BANK
+static u8 s_bankPending = HAPTIC_BANK_NONE;   /* BANK_PLAY 请求的图案编号 */
+#endif
+static HapticInstr_Probe s_latency;
+static HapticInstr_Probe s_parseCost;
+
+static void Host_Put16(u8 *dst, u16 value) {
+    dst[0] = (u8)value;
+    dst[1] = (u8)(value >> 8);
+}
+
+static void Host_Put32(u8 *dst, u32 value) {
+    Host_Put16(dst, (u16)value);
+    Host_Put16(dst + 2, (u16)(value >> 16));
+}
+
+static u16 Host_FifoCount(void) {
+    return (u16)(s_fifoTail - s_fifoHead);
+}
+
+static u8 Host_StatsReply(u8 *dst) {
+    const HapticLink_Stats *link = HapticLink_GetStats();
+    const HapticRtp_Stats *rtp = HapticRtp_GetStats();
+    u32 avg = s_latency.count ? s_latency.total / s_latency.count : 0;
+
+    Host_Put32(dst, link->frames);
+    Host_Put32(dst + 4, link->bytes);
+    Host_Put16(dst + 8, link->crcErrors);
+    Host_Put16(dst + 10, link->overruns);
+    Host_Put16(dst + 12, (u16)HapticInstr_CyclesToUs(avg));
+    Host_Put16(dst + 14, (u16)HapticInstr_CyclesToUs(s_latency.max));
+    Host_Put32(dst + 16, rtp->samples);
+    Host_Put32(dst + 20, rtp->late);
+    return HAPTIC_HOST_STATS_BYTES;
+}
+
+#if HAPTIC_USE_BANK
+static u8 Host_BankInfoReply(u8 *dst) {
+    const HapticBank_Info *info = HapticBank_GetInfo();
+
+    dst[0] = info->slot;
+    dst[1] = info->count;
+    Host_Put16(dst + 2, info->size);
+    Host_Put32(dst + 4, info->generation);
+    return HAPTIC_HOST_BANK_INFO_BYTES;
+}
+#endif
+
+/* 通告信用：edge = 已消费 + 缓冲容量 */
+static void Host_SendCredit(void) {
+    u8 frame[8];
+    u16 edge = (u16)(s_consumed + HAPTIC_HOST_RTP_FIFO);
+
+    frame[0] = 0;
+    frame[1] = HAPTIC_HOST_CREDIT;
+    Host_Put16(&frame[2], edge);
+    Host_Put16(&frame[4], s_underruns);
+    Host_Put16(&frame[6], (u16)HapticRtp_GetStats()->late);
+    s_creditSent = s_consumed;
+    HapticLink_Send(frame, sizeof(frame));
+}
+
+/* 执行一条命令；data 为该命令的数据区读取器（已限定长度），
+ * 附加数据写到 out[*outLen] 起，总长不超过 HAPTIC_HOST_REPLY_DATA */
+static ErrorStatus Host_Execute(u8 op, HapticLink_Reader *data, u8 len, u8 *out, u8 *outLen) {
+    u8 value;
+    u8 count;
+#if HAPTIC_USE_TUNE
+    u16 field;
+#endif
+    DRV2605_Effect effects[8];
+    u8 regs[HAPTIC_HOST_REG_BURST];
+
+    switch(op) {
+    case HAPTIC_HOST_OP_FIRE:
+        if(s_streaming || len != 1 || !HapticLink_ReadByte(data, &value)) {
+            return NoREADY;
+        }
+        effects[0] = (DRV2605_Effect)value;
+        if(DRV2605_StageRomSequence(DRV2605_LIBRARY_LRA, effects, 1) == NoREADY ||
+           DRV2605_CommitRomTransition() == NoREADY) {
+            return NoREADY;
+        }
+        HapticInstr_ProbeAdd(&s_latency, HapticInstr_Cycles() - HapticLink_FrameCycles());
+        HapticThermal_Update(HapticRtp_GetThermal());
+        HapticThermal_AccountRom(HapticRtp_GetThermal(), effects[0]);
+        return READY;
+
+    case HAPTIC_HOST_OP_SEQUENCE:
+        if(s_streaming || len < 2 || len > 9 || !HapticLink_ReadByte(data, &value)) {
+            return NoREADY;
+        }
+        for(u8 i = 0; i < len - 1; i++) {
+            u8 effect = 0;
+            HapticLink_ReadByte(data, &effect);
+            effects[i] = (DRV2605_Effect)effect;
+        }
+        return DRV2605_StageRomSequence((DRV2605_Library)value, effects, (u8)(len - 1));
+
+    case HAPTIC_HOST_OP_GO:
+        if(s_streaming || DRV2605_CommitRomTransition() == NoREADY) {
+            return NoREADY;
+        }
+        HapticInstr_ProbeAdd(&s_latency, HapticInstr_Cycles() - HapticLink_FrameCycles());
+        HapticThermal_Update(HapticRtp_GetThermal());
+        HapticThermal_AccountSequence(HapticRtp_GetThermal());
+        return READY;
+
+    case HAPTIC_HOST_OP_RTP:
+        if(len > HAPTIC_HOST_RTP_FIFO - Host_FifoCount()) {
+            return NoREADY;
+        }
+        while(HapticLink_ReadByte(data, &value)) {
+            s_fifo[s_fifoTail++ & HOST_FIFO_MASK] = value & 0x7F;
+        }
+        return READY;
+
+    case HAPTIC_HOST_OP_PROFILE:
+        if(s_streaming || len != 1 || !HapticLink_ReadByte(data, &value)) {
+            return NoREADY;
+        }
+        return DRV2605_ApplyProfile((DRV2605_ProfileId)value);
+
+    case HAPTIC_HOST_OP_STATS:
+        if(*outLen + HAPTIC_HOST_STATS_BYTES > HAPTIC_HOST_REPLY_DATA) {
+            return NoREADY;
+        }
+        *outLen = (u8)(*outLen + Host_StatsReply(&out[*outLen]));
+        return READY;
+
+    case HAPTIC_HOST_OP_STREAM:
+        if(len != 3 || !HapticLink_ReadByte(data, &value)) {
+            return NoREADY;
+        }
+        s_prebuffer = (value > HAPTIC_HOST_RTP_FIFO / 2) ? HAPTIC_HOST_RTP_FIFO / 2 : value;
+        HapticLink_ReadByte(data, &value);
+        s_streamHz = value;
+        HapticLink_ReadByte(data, &value);
+        s_streamHz |= (u16)value << 8;
+        if(s_streamHz > HAPTIC_HOST_STREAM_MAX_HZ) {
+            return NoREADY;
+        }
+        s_streamMode = 1;
+        s_streamStop = 0;
+        s_prebuffering = 1;
+        s_starveStart = HapticInstr_Cycles();
+        Host_SendCredit();
+        return READY;
+
+    case HAPTIC_HOST_OP_STREAM_STOP:
+        s_streamStop = 1;
+        return READY;
+
+    case HAPTIC_HOST_OP_REG_READ:
+        if(s_streaming || len != 2 || !HapticLink_ReadByte(data, &value) ||
+           !HapticLink_ReadByte(data, &count) || *outLen + count > HAPTIC_HOST_REPLY_DATA) {
+            return NoREADY;
+        }
+        for(u8 i = 0; i < count; i++) {
+            DRV2605_Register reg = (DRV2605_Register)(value + i);
+            u8 *dst = &out[*outLen + i];
+            if(DRV2605_GetShadowRegister(reg, dst) == NoREADY &&
+               DRV2605_ReadRegister(reg, dst) == NoREADY) {
+                return NoREADY;
+            }
+        }
+        *outLen = (u8)(*outLen + count);
+        return READY;
+
+    case HAPTIC_HOST_OP_REG_WRITE:
+        if(s_streaming || len < 2 || len > HAPTIC_HOST_REG_BURST + 1 ||
+           !HapticLink_ReadByte(data, &value)) {
+            return NoREADY;
+        }
+        count = (u8)HapticLink_Read(data, regs, (u16)(len - 1));
+        return DRV2605_WriteRegisters((DRV2605_Register)value, regs, count);
+
+#if HAPTIC_USE_TUNE
+    case HAPTIC_HOST_OP_TUNE_SET:
+        if(s_streaming || len != 3 || !HapticLink_ReadByte(data, &value) ||
+           HapticLink_Read(data, regs, 2) != 2) {
+            return NoREADY;
+        }
+        return HapticTune_SetField(value, (u16)(regs[0] | ((u16)regs[1] << 8)));
+
+    case HAPTIC_HOST_OP_TUNE_GET:
+        if(*outLen + 2 * HAPTIC_TUNE_COUNT > HAPTIC_HOST_REPLY_DATA) {
+            return NoREADY;
+        }
+        for(u8 i = 0; i < HAPTIC_TUNE_COUNT; i++) {
+            HapticTune_GetField(i, &field);
+            Host_Put16(&out[*outLen], field);
+            *outLen = (u8)(*outLen + 2);
+        }
+        return READY;
+
+    case HAPTIC_HOST_OP_TUNE_SAVE:
+        if(s_streaming) {
+            return NoREADY;   /* 擦写 flash 会让 CPU 停顿数毫秒 */
+        }
+        return HapticTune_Save();
+#endif
+
+#if HAPTIC_USE_BANK
+    case HAPTIC_HOST_OP_BANK_BEGIN:
+        if(s_streaming || len != 2 || HapticLink_Read(data, regs, 2) != 2) {
+            return NoREADY;
+        }
+        return HapticBank_Begin((u16)(regs[0] | ((u16)regs[1] << 8)));
+
+    case HAPTIC_HOST_OP_BANK_DATA:
+        /* 只接受紧接已写入部分的块；丢帧或重发都会失败，主机从 BANK_BEGIN 重来 */
+        if(s_streaming || len < 3 || HapticLink_Read(data, regs, 2) != 2 ||
+           (u16)(regs[0] | ((u16)regs[1] << 8)) != HapticBank_Written()) {
+            return NoREADY;
+        }
+        while(HapticLink_ReadByte(data, &value)) {
+            if(HapticBank_Put(value) == NoREADY) {
+                return NoREADY;
+            }
+        }
+        return READY;
+
+    case HAPTIC_HOST_OP_BANK_COMMIT:
+        if(s_streaming || len != 2 || HapticLink_Read(data, regs, 2) != 2) {
+            return NoREADY;
+        }
+        return HapticBank_Commit((u16)(regs[0] | ((u16)regs[1] << 8)));
+
+    case HAPTIC_HOST_OP_BANK_PLAY:
+        if(s_streaming || len != 1 || !HapticLink_ReadByte(data, &value) ||
+           value >= HapticBank_GetInfo()->count) {
+            return NoREADY;
+        }
+        s_bankPending = value;
+        return READY;
+
+    case HAPTIC_HOST_OP_BANK_INFO:
+        if(*outLen + HAPTIC_HOST_BANK_INFO_BYTES > HAPTIC_HOST_REPLY_DATA) {
+            return NoREADY;
+        }
+        *outLen = (u8)(*outLen + Host_BankInfoReply(&out[*outLen]));
+        return READY;
+#endif
+
+    default:
+        return NoREADY;
+    }
+}
+
+/******************************************************************************
+ * @brief  逐条执行命令并回应答；失败的命令不影响后续命令。
+ ******************************************************************************/
+static void Host_Dispatch(void *ctx, HapticLink_Reader *payload) {
+    u8 reply[4 + HAPTIC_HOST_REPLY_DATA];
+    u8 dataLen = 0;
+    u32 start = HapticInstr_Cycles();
+    u8 seq = 0;
+    u8 op;
+    u8 len;
+
+    (void)ctx;
+    HapticLink_ReadByte(payload, &seq);
+    reply[0] = seq;
+    reply[1] = HAPTIC_HOST_REPLY;
+    reply[2] = 0;
+    reply[3] = 0;
+
+    while(HapticLink_ReadByte(payload, &op)) {
+        if(!HapticLink_ReadByte(payload, &len) || len > HapticLink_Remaining(payload)) {
+            if(reply[3] == 0) {
+                reply[3] = op;
+            }
+            break;
+        }
+        /* 限定读取器到本命令的数据区，执行后跳过未读部分 */
+        u16 rest = (u16)(HapticLink_Remaining(payload) - len);
+        payload->remain = len;
+        if(Host_Execute(op, payload, len, &reply[4], &dataLen) == READY) {
+            reply[2]++;
+        } else if(reply[3] == 0) {
+            reply[3] = op;
+        }
+        HapticLink_Read(payload, NULL, payload->remain);
+        payload->remain = rest;
+    }
+    HapticInstr_ProbeAdd(&s_parseCost, HapticInstr_Cycles() - start);
+    HapticLink_Send(reply, (u16)(4 + dataLen));
+}
+
+/* 节拍等待期间收取链路数据 */
+static void Host_Idle(void) {
+    HapticLink_Poll(Host_Dispatch, NULL);
+}
+
+/* 预缓冲/欠载时输出一个零样本维持节拍；超时返回 0 结束流 */
+static u16 Host_Starve(u8 *samples) {
+    u32 cyclesPerMs = HapticInstr_CyclesPerUs() * 1000UL;
+
+    if((HapticInstr_Cycles() - s_starveStart) / cyclesPerMs >= HAPTIC_HOST_STREAM_TIMEOUT_MS) {
+        s_streamMode = 0;
+        return 0;
+    }
+    samples[0] = 0x00;
+    return 1;
+}
+
+/* 非流模式缓冲空即结束；流模式下按预缓冲深度起播，耗尽时记欠载 */
+static u16 Host_RtpSource(void *ctx, u8 *samples, u16 count) {
+    u16 available;
+
+    (void)ctx;
+    HapticLink_Poll(Host_Dispatch, NULL);
+    available = Host_FifoCount();
+
+    if(s_streamMode) {
+        if(s_prebuffering) {
+            if(available < s_prebuffer && !s_streamStop) {
+                return Host_Starve(samples);
+            }
+            s_prebuffering = 0;
+        }
+        if(available == 0) {
+            if(s_streamStop) {
+                s_streamMode = 0;
+                Host_SendCredit();
+                return 0;
+            }
+            s_underruns++;
+            s_prebuffering = 1;
+            s_starveStart = HapticInstr_Cycles();
+            Host_SendCredit();
+            return Host_Starve(samples);
+        }
+    }
+
+    if(count > available) {
+        count = available;
+    }
+    for(u16 i = 0; i < count; i++) {
+        samples[i] = s_fifo[s_fifoHead++ & HOST_FIFO_MASK];
+    }
+    s_consumed += count;
+    if(s_streamMode && (u16)(s_consumed - s_creditSent) >= HAPTIC_HOST_CREDIT_STEP) {
+        Host_SendCredit();
+    }
+    return count;
+}
+
+#if HAPTIC_USE_BANK
+/* 从 flash 原地解码播放图案库中的图案，期间照常收取命令 */
+static void Host_PlayBank(u8 index) {
+    static HapticPatternDecoder decoder;
+    HapticPattern pattern;
+
+    s_bankPending = HAPTIC_BANK_NONE;
+    if(HapticBank_Get(index, &pattern) == NoREADY) {
+        return;
+    }
+    s_streaming = 1;
+    HapticRtp_SetIdle(Host_Idle);
+    HapticPattern_Start(&decoder, &pattern);
+    HapticRtp_Play(HapticPattern_Source, &decoder);
+    HapticRtp_SetIdle(NULL);
+    s_streaming = 0;
+}
+#endif
+
+/******************************************************************************
+ * @brief  初始化链路与统计。
+ ******************************************************************************/
+void HapticHost_Init(void) {
+    HapticLink_Init();
+    s_fifoHead = 0;
+    s_fifoTail = 0;
+    s_streaming = 0;
+    s_streamMode = 0;
+    s_consumed = 0;
+    s_creditSent = 0;
+    s_underruns = 0;
+#if HAPTIC_USE_BANK
+    s_bankPending = HAPTIC_BANK_NONE;
+#endif
+    HapticInstr_ProbeReset(&s_latency);
+    HapticInstr_ProbeReset(&s_parseCost);
+}
+
+u8 HapticHost_Poll(void) {
+    u8 frames = HapticLink_Poll(Host_Dispatch, NULL);
+
+#if HAPTIC_USE_BANK
+    if(s_bankPending != HAPTIC_BANK_NONE && !s_streaming) {
+        Host_PlayBank(s_bankPending);
+    }
+#endif
+    if((Host_FifoCount() != 0 || s_streamMode) && !s_streaming) {
+        s_streaming = 1;
+        HapticRtp_SetIdle(Host_Idle);
+        HapticRtp_PlayRate(Host_RtpSource, NULL, s_streamMode ? s_streamHz : HAPTIC_RTP_SAMPLE_HZ);
+        HapticRtp_SetIdle(NULL);
+        s_streaming = 0;
+    }
+    return frames;
+}
+
+u16 HapticHost_GetUnderruns(void) {
+    return s_underruns;
+}
+
+const HapticInstr_Probe *HapticHost_GetLatency(void) {
+    return &s_latency;
+}
+
+const HapticInstr_Probe *HapticHost_GetParseCost(void) {
+    return &s_parseCost;
+}
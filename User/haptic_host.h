@@ -0,0 +1,93 @@
+/******************************************************************************
+ * 文件名   : haptic_host.h
+ * 描述     : 主机控制协议：一帧携带一批命令（ROM 效果、序列、RTP 块、配置档、
+ *            寄存器读写、调校参数、图案库更新、统计），直接从链路 DMA 缓冲解析执行，
+ *            每帧回一个应答。主机端交互调校见 Tools/haptic_link.cpp 的 shell。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_HOST_H
+#define __HAPTIC_HOST_H
+
+#include "haptic_link.h"
+#include "haptic_rtp.h"
+#include "haptic_instr.h"
+
+/*
+ * 请求负载：seq + 若干命令，每条命令为 op, len, data[len]。
+ * 应答负载：seq, HAPTIC_HOST_REPLY, 成功条数, 首个失败的 op（0 表示全部成功）
+ *           [+ 各命令的附加数据，按命令顺序，合计不超过 HAPTIC_HOST_REPLY_DATA]。主机收到应答后再发下一帧（停等），
+ *           保证 DMA 缓冲不会覆盖未处理的帧。
+ *
+ * 流模式（STREAM 命令开启）：设备主动发送信用帧
+ *   0x00, HAPTIC_HOST_CREDIT, edge u16, underruns u16, late u16
+ * edge = 已消费样本数 + HAPTIC_HOST_RTP_FIFO（模 65536），主机可连续发送
+ * 累计序号小于 edge 的样本而无需等待应答；播放期间每个采样节拍都会收取
+ * 链路数据，因此在途帧不会超出 DMA 缓冲。缓冲耗尽记一次欠载，输出归零并
+ * 重新预缓冲；预缓冲超时视为主机断开，流结束。
+ *
+ * TUNE_* 与 BANK_* 只在 haptic_config.h 编入对应功能时可用，否则按失败应答。
+ */
+#define HAPTIC_HOST_OP_FIRE        0x01  /* effect：单个 LRA 库效果立即播放 */
+#define HAPTIC_HOST_OP_SEQUENCE    0x02  /* library, effect[1..8]：预写序列 */
+#define HAPTIC_HOST_OP_GO          0x03  /* 播放预写序列 */
+#define HAPTIC_HOST_OP_RTP         0x04  /* sample[n]：追加到 RTP 缓冲 */
+#define HAPTIC_HOST_OP_PROFILE     0x05  /* DRV2605_ProfileId */
+#define HAPTIC_HOST_OP_STATS       0x06  /* 在应答中附加统计 */
+#define HAPTIC_HOST_OP_STREAM      0x07  /* prebuffer u8, rateHz u16：进入流模式 */
+#define HAPTIC_HOST_OP_STREAM_STOP 0x08  /* 放完缓冲后退出流模式 */
+#define HAPTIC_HOST_OP_REG_READ    0x09  /* reg, count：附加 count 字节（影子优先，未知时读总线） */
+#define HAPTIC_HOST_OP_REG_WRITE   0x0A  /* reg, value[1..16]：从 reg 起连续写 */
+#define HAPTIC_HOST_OP_TUNE_SET    0x0B  /* HapticTune_Field, value u16 */
+#define HAPTIC_HOST_OP_TUNE_GET    0x0C  /* 附加 HAPTIC_TUNE_COUNT 个 u16 */
+#define HAPTIC_HOST_OP_TUNE_SAVE   0x0D  /* 调校参数写入 flash */
+#define HAPTIC_HOST_OP_BANK_BEGIN  0x0E  /* size u16：擦除非活动槽，开始更新图案库 */
+#define HAPTIC_HOST_OP_BANK_DATA   0x0F  /* offset u16, byte[n]：offset 须等于已接收字节数 */
+#define HAPTIC_HOST_OP_BANK_COMMIT 0x10  /* crc u16：校验映像并切换活动槽 */
+#define HAPTIC_HOST_OP_BANK_PLAY   0x11  /* index：本帧处理完后播放活动槽中的图案 */
+#define HAPTIC_HOST_OP_BANK_INFO   0x12  /* 附加 slot, count, size u16, generation u32 */
+#define HAPTIC_HOST_REPLY          0x80
+#define HAPTIC_HOST_CREDIT         0x81
+
+#define HAPTIC_HOST_CREDIT_STEP    16    /* 消费这么多样本后补发信用 */
+#define HAPTIC_HOST_STREAM_TIMEOUT_MS  500
+#define HAPTIC_HOST_STREAM_MAX_HZ  2000  /* 100kHz I2C 下 RTPIN 写约 0.3ms */
+
+#define HAPTIC_HOST_RTP_FIFO       128   /* RTP 样本缓冲，2 的幂 */
+#define HAPTIC_HOST_REPLY_DATA     24    /* 应答附加数据上限 */
+#define HAPTIC_HOST_REG_BURST      16    /* REG_WRITE 单条最多字节 */
+
+/*
+ * STATS 数据（小端）：frames u32, bytes u32, crcErrors u16, overruns u16,
+ * latencyAvgUs u16, latencyMaxUs u16, rtpSamples u32, rtpLate u32
+ */
+#define HAPTIC_HOST_STATS_BYTES    24
+#define HAPTIC_HOST_BANK_INFO_BYTES  8
+
+/**
+ * @brief  初始化链路与命令状态。
+ */
+void HapticHost_Init(void);
+
+/**
+ * @brief  处理已到达的帧；RTP 缓冲非空或有待播的图案库图案时阻塞播放
+ *         直到结束（播放期间每块继续接收命令，flash 类命令被拒绝）。
+ * @return 本次处理的帧数。
+ */
+u8 HapticHost_Poll(void);
+
+/**
+ * @brief  命令到震动延迟（帧界到 GO 写完），单位周期。
+ */
+const HapticInstr_Probe *HapticHost_GetLatency(void);
+
+/**
+ * @brief  每帧解析执行耗时（不含应答发送），单位周期。
+ */
+const HapticInstr_Probe *HapticHost_GetParseCost(void);
+
+/**
+ * @brief  流模式累计欠载次数。
+ */
+u16 HapticHost_GetUnderruns(void);
+
+#endif /* __HAPTIC_HOST_H */
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * 文件名   : haptic_instr.c
+ * 描述     : TIM2 自由运行计时：16 位硬件计数 + 溢出中断扩展高 16 位。
+ *            降频后每个 TIM2 计数折算为 s_scale 个参考周期。
+ ******************************************************************************/
+#include "haptic_instr.h"
+#include "haptic_trace.h"
+
+void TIM2_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+
+static volatile u16 s_cyclesHigh = 0;
+static u32 s_cyclesPerUs = 48;
+static u32 s_scale = 1;     /* 参考周期 / TIM2 计数 */
+static u32 s_rawBase;       /* 最近一次切换时的 TIM2 计数与参考周期 */
+static u32 s_base;
+
+/******************************************************************************
+ * @brief  配置 TIM2：预分频 1，周期 0xFFFF，仅开启更新中断。
+ ******************************************************************************/
+void HapticInstr_Init(void) {
+    TIM_TimeBaseInitTypeDef timeBase = {0};
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+
+    timeBase.TIM_Period = 0xFFFF;
+    timeBase.TIM_Prescaler = 0;
+    timeBase.TIM_ClockDivision = TIM_CKD_DIV1;
+    timeBase.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM2, &timeBase);
+
+    TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+    TIM_ITConfig(TIM2, TIM_IT_Update, ENABLE);
+    NVIC_EnableIRQ(TIM2_IRQn);
+
+    s_cyclesPerUs = SystemCoreClock / 1000000UL;
+    if(s_cyclesPerUs == 0) {
+        s_cyclesPerUs = 1;
+    }
+    TIM_Cmd(TIM2, ENABLE);
+}
+
+/******************************************************************************
+ * @brief  组合高低 16 位；中断被屏蔽时通过挂起标志补偿一次溢出。
+ *         挂起标志与高低位在同一轮内采样：中断若在采样后清标志，
+ *         s_cyclesHigh 随之改变，整轮重采，不会用旧高位配新低位。
+ ******************************************************************************/
+static u32 Instr_Raw(void) {
+    u16 high;
+    u16 low;
+    FlagStatus pending;
+
+    do {
+        high = s_cyclesHigh;
+        low = TIM_GetCounter(TIM2);
+        pending = TIM_GetFlagStatus(TIM2, TIM_FLAG_Update);
+    } while(high != s_cyclesHigh);
+
+    if(pending != RESET && low < 0x8000) {
+        high++;
+    }
+    return ((u32)high << 16) | low;
+}
+
+u32 HapticInstr_Cycles(void) {
+    return s_base + (Instr_Raw() - s_rawBase) * s_scale;
+}
+
+void HapticInstr_Retime(void) {
+    u32 hclkPerUs = SystemCoreClock / 1000000UL;
+    u32 now = Instr_Raw();
+
+    s_base += (now - s_rawBase) * s_scale;
+    s_rawBase = now;
+    s_scale = (hclkPerUs != 0 && hclkPerUs < s_cyclesPerUs) ? s_cyclesPerUs / hclkPerUs : 1;
+}
+
+u32 HapticInstr_CyclesPerUs(void) {
+    return s_cyclesPerUs;
+}
+
+u32 HapticInstr_CyclesToUs(u32 cycles) {
+    return cycles / s_cyclesPerUs;
+}
+
+#if HAPTIC_USE_PROBE
+void HapticInstr_ProbeReset(HapticInstr_Probe *probe) {
+    if(probe == NULL) {
+        return;
+    }
+    probe->count = 0;
+    probe->total = 0;
+    probe->min = 0xFFFFFFFFUL;
+    probe->max = 0;
+}
+
+void HapticInstr_ProbeAdd(HapticInstr_Probe *probe, u32 cycles) {
+    if(probe == NULL) {
+        return;
+    }
+    probe->count++;
+    probe->total += cycles;
+    if(cycles < probe->min) {
+        probe->min = cycles;
+    }
+    if(cycles > probe->max) {
+        probe->max = cycles;
+    }
+}
+#endif
+
+void HapticInstr_ProbeTrace(u8 event, const HapticInstr_Probe *probe) {
+    if(probe == NULL || probe->count == 0) {
+        HAPTIC_TRACE4(event, 0, 0, 0, 0);
+        return;
+    }
+    HAPTIC_TRACE4(event, probe->count, probe->total / probe->count, probe->min, probe->max);
+}
+
+/*********************************************************************
+ * @fn      TIM2_IRQHandler
+ *
+ * @brief   TIM2 更新中断：计数高 16 位加一。
+ *
+ * @return  none
+ */
+void TIM2_IRQHandler(void) {
+    if(TIM_GetITStatus(TIM2, TIM_IT_Update) != RESET) {
+        s_cyclesHigh++;
+        TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+    }
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * 文件名   : haptic_instr.h
+ * 描述     : 触感链路计时与性能探针（TIM2 自由运行计数，扩展为 32 位周期数）。
+ *            周期数固定按启动时的 HCLK 计（参考周期），运行中降频时按倍率折算，
+ *            时间差与探针在切换前后保持同一单位。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_INSTR_H
+#define __HAPTIC_INSTR_H
+
+#include "debug.h"
+#include "haptic_config.h"
+
+/* 单个测量点的统计：次数/累计/最小/最大（单位：参考周期） */
+typedef struct {
+	u32 count;
+	u32 total;
+	u32 min;
+	u32 max;
+} HapticInstr_Probe;
+
+/**
+ * @brief  启动 TIM2 作为 HCLK 频率的自由运行计数器。
+ * @note   Delay_Us/Delay_Ms 会改写 SysTick，故计时不使用 SysTick。
+ */
+void HapticInstr_Init(void);
+
+/**
+ * @brief  读取 32 位周期时间戳（48MHz 下约 89 秒回绕，差值运算自然处理回绕）。
+ */
+u32 HapticInstr_Cycles(void);
+
+/**
+ * @brief  每微秒对应的参考周期数（启动时确定，不随运行中的时钟切换变化）。
+ */
+u32 HapticInstr_CyclesPerUs(void);
+
+/**
+ * @brief  HCLK 切换后立即调用：以当前时间戳为起点改用新的折算倍率。
+ * @note   须在关中断下与时钟切换一起完成；参考周期须为新 HCLK 的整数倍。
+ */
+void HapticInstr_Retime(void);
+
+/**
+ * @brief  周期数换算为微秒（含软件除法，仅用于统计输出）。
+ */
+u32 HapticInstr_CyclesToUs(u32 cycles);
+
+#if HAPTIC_USE_PROBE
+/**
+ * @brief  清空探针统计。
+ */
+void HapticInstr_ProbeReset(HapticInstr_Probe *probe);
+
+/**
+ * @brief  记录一次测量值。
+ * @param  probe  探针。
+ * @param  cycles 本次耗时（周期数）。
+ */
+void HapticInstr_ProbeAdd(HapticInstr_Probe *probe, u32 cycles);
+#else
+/* 探针关闭：调用点去掉，耗时表达式只出现在 sizeof 中不求值，静态探针保持清零 */
+#define HapticInstr_ProbeReset(probe)          ((void)(probe))
+#define HapticInstr_ProbeAdd(probe, cycles)    ((void)(probe), (void)sizeof(cycles))
+#endif
+
+/**
+ * @brief  以 trace 记录输出探针统计（次数/平均值/最小/最大，单位周期）。
+ * @param  event 字典中该探针的事件号（格式串带 4 个参数）。
+ * @param  probe 探针，无样本时各项均输出 0。
+ */
+void HapticInstr_ProbeTrace(u8 event, const HapticInstr_Probe *probe);
+
+#endif /* __HAPTIC_INSTR_H */
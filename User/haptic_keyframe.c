@@ -0,0 +1,216 @@
+/******************************************************************************
+ * 文件名   : haptic_keyframe.c
+ * 描述     : 关键帧插值。段 [k, k+1] 写成 f(t)=a·t³+b·t²+c·t+d，t 步长 1/N，
+ *            用前向差分 Δ1/Δ2/Δ3 递推，线性模式即 a=b=0。
+ *            长段上 a/N³ 的舍入误差按 N³ 累积，因此每 KEYFRAME_ANCHOR 个样本
+ *            按多项式直接求值重取锚点，段内误差与段长无关。
+ ******************************************************************************/
+#include "haptic_keyframe.h"
+
+#define KEYFRAME_FRAC      32
+#define KEYFRAME_ONE       ((s64)1 << KEYFRAME_FRAC)
+#define KEYFRAME_ANCHOR    128  /* 锚点间隔（样本，2 的幂），段内最大误差约 1/16384 LSB */
+
+/* 段多项式系数（Q32，自变量为段内归一化时间） */
+typedef struct {
+    s64 a;
+    s64 b;
+    s64 c;
+    s64 d;
+} KeyframeCurve;
+
+static u16 Keyframe_SegmentSamples(const HapticKeyframePattern *pattern, u8 index) {
+    if(index == 0 || index >= pattern->count) {
+        return 0;
+    }
+    return (u16)(pattern->keys[index].dtUnits * pattern->unitMs);
+}
+
+static s64 Keyframe_DivRound(s64 num, s64 den) {
+    return (num >= 0) ? (num + den / 2) / den : -((-num + den / 2) / den);
+}
+
+/* 关键帧 index 处的切线（单位：幅值/当前段，Q32）；极值点或端点为 0/单侧差分 */
+static s64 Keyframe_Tangent(const HapticKeyframePattern *pattern, u8 index, u16 segment) {
+    const HapticKeyframe *keys = pattern->keys;
+    s32 before;
+    s32 after;
+    u16 spanBefore;
+    u16 spanAfter;
+
+    if(index == 0) {
+        return (s64)(keys[1].amplitude - keys[0].amplitude) * KEYFRAME_ONE;
+    }
+    if(index >= pattern->count - 1) {
+        return (s64)(keys[index].amplitude - keys[index - 1].amplitude) * KEYFRAME_ONE;
+    }
+
+    before = (s32)keys[index].amplitude - keys[index - 1].amplitude;
+    after = (s32)keys[index + 1].amplitude - keys[index].amplitude;
+    if(before == 0 || after == 0 || ((before < 0) != (after < 0))) {
+        return 0;
+    }
+
+    spanBefore = Keyframe_SegmentSamples(pattern, index);
+    spanAfter = Keyframe_SegmentSamples(pattern, (u8)(index + 1));
+    if(spanBefore + spanAfter == 0) {
+        return 0;
+    }
+    /* 中心差分斜率换算到当前段长度 */
+    return Keyframe_DivRound((s64)(before + after) * segment * KEYFRAME_ONE,
+                             (s64)spanBefore + spanAfter);
+}
+
+/* Fritsch-Carlson 条件：|m| ≤ 3·|段差|，保证段内单调、不越过端点幅值 */
+static s64 Keyframe_LimitTangent(s64 m, s64 chord) {
+    s64 limit = 3 * ((chord < 0) ? -chord : chord);
+    if(m > limit) {
+        return limit;
+    }
+    if(m < -limit) {
+        return -limit;
+    }
+    return m;
+}
+
+/* 段 [k, k+1] 的多项式系数 */
+static void Keyframe_Curve(const HapticKeyframePattern *pattern, u8 k, u16 n, KeyframeCurve *curve) {
+    s64 p1 = (s64)pattern->keys[k].amplitude << KEYFRAME_FRAC;
+    s64 p2 = (s64)pattern->keys[k + 1].amplitude << KEYFRAME_FRAC;
+
+    curve->a = 0;
+    curve->b = 0;
+    curve->c = p2 - p1;
+    curve->d = p1;
+    if(pattern->mode == HAPTIC_KEYFRAME_CUBIC) {
+        s64 m1 = Keyframe_LimitTangent(Keyframe_Tangent(pattern, k, n), curve->c);
+        s64 m2 = Keyframe_LimitTangent(Keyframe_Tangent(pattern, (u8)(k + 1), n), curve->c);
+        curve->a = 2 * p1 - 2 * p2 + m1 + m2;
+        curve->b = -3 * p1 + 3 * p2 - 2 * m1 - m2;
+        curve->c = m1;
+    }
+}
+
+/* 第 i 个样本处的值：Horner 形式，每步除以 n，误差不超过 1.5 个 Q32 单位 */
+static s64 Keyframe_Eval(const KeyframeCurve *curve, u16 n, s32 i) {
+    s64 x = curve->a;
+    x = Keyframe_DivRound(x * i, n) + curve->b;
+    x = Keyframe_DivRound(x * i, n) + curve->c;
+    return Keyframe_DivRound(x * i, n) + curve->d;
+}
+
+/* 在当前段第 n - remain 个样本处重取值与前向差分 */
+static void Keyframe_Anchor(HapticKeyframePlayer *player, u16 n) {
+    KeyframeCurve curve;
+    s32 i = (s32)(n - player->remain);
+    s64 n3 = (s64)n * n * n;
+
+    Keyframe_Curve(player->pattern, player->index, n, &curve);
+    player->value = Keyframe_Eval(&curve, n, i);
+    player->d1 = Keyframe_Eval(&curve, n, i + 1) - player->value;
+    player->d2 = Keyframe_DivRound(6 * curve.a * (s64)(i + 1), n3) +
+                 Keyframe_DivRound(2 * curve.b, (s64)n * n);
+    player->d3 = Keyframe_DivRound(6 * curve.a, n3);
+}
+
+/* 准备从 player->index 开始的段；跳过零长度段 */
+static u8 Keyframe_PrepareSegment(HapticKeyframePlayer *player) {
+    const HapticKeyframePattern *pattern = player->pattern;
+
+    while((u8)(player->index + 1) < pattern->count) {
+        u16 n = Keyframe_SegmentSamples(pattern, (u8)(player->index + 1));
+        if(n == 0) {
+            player->index++;
+            continue;
+        }
+        player->remain = n;
+        Keyframe_Anchor(player, n);
+        return 1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+ * @brief  绑定图案。
+ ******************************************************************************/
+void HapticKeyframe_Start(HapticKeyframePlayer *player, const HapticKeyframePattern *pattern) {
+    if(player == NULL) {
+        return;
+    }
+    player->pattern = NULL;
+    player->index = 0;
+    player->remain = 0;
+    if(pattern != NULL && pattern->keys != NULL && pattern->count >= 2) {
+        player->pattern = pattern;
+        Keyframe_PrepareSegment(player);
+    }
+}
+
+/* 取当前值（Q32）并前进一个样本；图案结束返回 0 */
+static u8 Keyframe_Step(HapticKeyframePlayer *player, s64 *value) {
+    if(player->remain == 0) {
+        player->index++;
+        if(!Keyframe_PrepareSegment(player)) {
+            return 0;
+        }
+    } else {
+        u16 n = Keyframe_SegmentSamples(player->pattern, (u8)(player->index + 1));
+        if(((n - player->remain) & (KEYFRAME_ANCHOR - 1)) == 0) {
+            Keyframe_Anchor(player, n);
+        }
+    }
+
+    *value = player->value;
+    player->value += player->d1;
+    player->d1 += player->d2;
+    player->d2 += player->d3;
+    player->remain--;
+    return 1;
+}
+
+/******************************************************************************
+ * @brief  段内前向差分递推；段结束时切换到下一段。
+ * @note   每段输出 [起点, 终点) 的样本，末关键帧本身不输出（通常为 0）。
+ ******************************************************************************/
+u16 HapticKeyframe_Render(HapticKeyframePlayer *player, u8 *samples, u16 count) {
+    u16 produced = 0;
+    s64 value;
+
+    if(player == NULL || player->pattern == NULL || samples == NULL) {
+        return 0;
+    }
+
+    while(produced < count && Keyframe_Step(player, &value)) {
+        s32 level = (s32)((value + (KEYFRAME_ONE >> 1)) >> KEYFRAME_FRAC);
+        samples[produced++] = (u8)((level < 0) ? 0 : ((level > 0x7F) ? 0x7F : level));
+    }
+
+    return produced;
+}
+
+/******************************************************************************
+ * @brief  输出 16 位幅值（高 7 位为 RTP 值，低 9 位为小数），供抖动级使用。
+ ******************************************************************************/
+u16 HapticKeyframe_RenderWide(HapticKeyframePlayer *player, u16 *levels, u16 count) {
+    u16 produced = 0;
+    s64 value;
+
+    if(player == NULL || player->pattern == NULL || levels == NULL) {
+        return 0;
+    }
+
+    while(produced < count && Keyframe_Step(player, &value)) {
+        s32 level = (s32)(value >> (KEYFRAME_FRAC - 9));
+        levels[produced++] = (u16)((level < 0) ? 0 : ((level > 0xFFFF) ? 0xFFFF : level));
+    }
+
+    return produced;
+}
+
+u16 HapticKeyframe_Source(void *ctx, u8 *samples, u16 count) {
+    return HapticKeyframe_Render((HapticKeyframePlayer *)ctx, samples, count);
+}
+
+u16 HapticKeyframe_WideSource(void *ctx, u16 *levels, u16 count) {
+    return HapticKeyframe_RenderWide((HapticKeyframePlayer *)ctx, levels, count);
+}
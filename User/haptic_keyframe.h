@@ -0,0 +1,80 @@
+/******************************************************************************
+ * 文件名   : haptic_keyframe.h
+ * 描述     : 稀疏关键帧图案：以采样率做线性/三次（单调 Hermite）定点插值。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_KEYFRAME_H
+#define __HAPTIC_KEYFRAME_H
+
+#ifdef HAPTIC_KEYFRAME_HOST
+#include <stdint.h>
+#include <stddef.h>
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef int32_t  s32;
+typedef int64_t  s64;
+#else
+#include "haptic_rtp.h"
+#endif
+
+/* 插值方式 */
+typedef enum {
+	HAPTIC_KEYFRAME_LINEAR = 0,  /* 折线 */
+	HAPTIC_KEYFRAME_CUBIC  = 1   /* 三次 Hermite，极值点切线置零，不越过关键帧幅值 */
+} HapticKeyframe_Mode;
+
+/* 关键帧：相对上一帧的时间 + 幅值，每帧 2 字节 */
+typedef struct {
+	u8 dtUnits;    /* 距上一关键帧的单位数（首帧忽略） */
+	u8 amplitude;  /* RTP 值 0x00~0x7F */
+} HapticKeyframe;
+
+/* flash 中的关键帧图案 */
+typedef struct {
+	const HapticKeyframe *keys;
+	u8 count;      /* 关键帧数量（至少 2） */
+	u8 unitMs;     /* 时间单位 */
+	u8 mode;       /* HapticKeyframe_Mode */
+} HapticKeyframePattern;
+
+/* 插值器状态：Q32.32 前向差分，逐样本 3 次 64 位加法 */
+typedef struct {
+	const HapticKeyframePattern *pattern;
+	u8 index;      /* 当前段起点关键帧 */
+	u16 remain;    /* 当前段剩余样本 */
+	s64 value;
+	s64 d1;
+	s64 d2;
+	s64 d3;
+} HapticKeyframePlayer;
+
+/**
+ * @brief  绑定图案并准备第一段。
+ */
+void HapticKeyframe_Start(HapticKeyframePlayer *player, const HapticKeyframePattern *pattern);
+
+/**
+ * @brief  生成最多 count 个 RTP 样本。
+ * @note   每段起点及段内每 128 个样本做一次锚点计算（含 64 位除法），其余样本只做加法。
+ * @return 实际数量，最后一段结束后返回 0。
+ */
+u16 HapticKeyframe_Render(HapticKeyframePlayer *player, u8 *samples, u16 count);
+
+/**
+ * @brief  生成最多 count 个 16 位幅值（0xFE00 对应 0x7F），不做取整。
+ * @note   配合 haptic_dither 在 7 位 RTP 上保留亚 LSB 精度。
+ * @return 实际数量，最后一段结束后返回 0。
+ */
+u16 HapticKeyframe_RenderWide(HapticKeyframePlayer *player, u16 *levels, u16 count);
+
+/**
+ * @brief  HapticRtp_Source 适配，ctx 为 HapticKeyframePlayer 指针。
+ */
+u16 HapticKeyframe_Source(void *ctx, u8 *samples, u16 count);
+
+/**
+ * @brief  HapticDither_WideSource 适配，ctx 为 HapticKeyframePlayer 指针。
+ */
+u16 HapticKeyframe_WideSource(void *ctx, u16 *levels, u16 count);
+
+#endif /* __HAPTIC_KEYFRAME_H */
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * 文件名   : haptic_kick.c
+ * 描述     : 边沿检测 + 过驱/刹车脉冲。逐样本只有比较和一次 8 位乘法，
+ *            除法只在共振频率变化时出现。
+ ******************************************************************************/
+#include "haptic_kick.h"
+#include "haptic_rtp.h"
+#include "haptic_resonance.h"
+
+#define KICK_PHASE_NONE    0
+#define KICK_PHASE_KICK    1
+#define KICK_PHASE_BRAKE   2
+
+/* halfCycles 个共振半周期对应的样本数，四舍五入，至少 1 */
+static u8 Kick_HalfCycleSamples(u8 halfCycles, u16 hz, u16 sampleHz) {
+    u32 samples;
+
+    if(halfCycles == 0) {
+        return 0;
+    }
+    samples = ((u32)halfCycles * sampleHz + hz) / (2UL * hz);
+    if(samples == 0) {
+        samples = 1;
+    }
+    return (u8)((samples > 0xFF) ? 0xFF : samples);
+}
+
+static void Kick_Retune(HapticKick *kick) {
+    u16 hz = DRV2605_GetResonanceHz();
+
+    if(hz == 0) {
+        hz = HAPTIC_KICK_DEFAULT_HZ;
+    }
+    kick->kickSamples = Kick_HalfCycleSamples(kick->cfg->kickHalfCycles, hz, kick->sampleHz);
+    kick->brakeSamples = Kick_HalfCycleSamples(kick->cfg->brakeHalfCycles, hz, kick->sampleHz);
+    kick->resonanceVersion = HapticResonance_Version();
+}
+
+/******************************************************************************
+ * @brief  绑定配置。
+ ******************************************************************************/
+void HapticKick_Init(HapticKick *kick, const HapticKick_Config *cfg) {
+    if(kick == NULL || cfg == NULL) {
+        return;
+    }
+    kick->cfg = cfg;
+    kick->sampleHz = HAPTIC_RTP_SAMPLE_HZ;
+    Kick_Retune(kick);
+    HapticKick_Reset(kick, HAPTIC_RTP_SAMPLE_HZ);
+}
+
+void HapticKick_Reset(HapticKick *kick, u16 sampleHz) {
+    if(kick == NULL) {
+        return;
+    }
+    if(sampleHz != 0 && sampleHz != kick->sampleHz) {
+        kick->sampleHz = sampleHz;
+        if(kick->cfg != NULL) {
+            Kick_Retune(kick);
+        }
+    }
+    kick->remain = 0;
+    kick->phase = KICK_PHASE_NONE;
+    kick->boost = 0;
+    kick->last = 0;
+}
+
+/* 处理一个输入样本，返回输出值 */
+static u8 Kick_Step(HapticKick *kick, u8 in) {
+    const HapticKick_Config *cfg = kick->cfg;
+    u8 out = in;
+
+    if(in > (u16)kick->last + cfg->edgeThreshold) {
+        kick->phase = KICK_PHASE_KICK;
+        kick->remain = kick->kickSamples;
+        kick->boost = (u8)(((u16)(in - kick->last) * cfg->kickLevel) >> 7);
+    } else if((u16)in + cfg->edgeThreshold < kick->last) {
+        kick->phase = KICK_PHASE_BRAKE;
+        kick->remain = kick->brakeSamples;
+        kick->boost = (u8)(((u16)(kick->last - in) * cfg->brakeLevel) >> 7);
+    }
+    kick->last = in;
+
+    if(kick->remain == 0) {
+        kick->phase = KICK_PHASE_NONE;
+        return out;
+    }
+    kick->remain--;
+
+    if(kick->phase == KICK_PHASE_KICK) {
+        u16 boosted = (u16)in + kick->boost;
+        out = (u8)((boosted > 0x7F) ? 0x7F : boosted);
+    } else if(cfg->brakeMode == HAPTIC_KICK_BRAKE_ZERO || kick->boost == 0) {
+        out = 0x00;
+    } else {
+        out = (u8)(-(s8)((kick->boost > 0x7F) ? 0x7F : kick->boost));
+    }
+    return out;
+}
+
+/******************************************************************************
+ * @brief  原地改写样本：上升沿后 kickSamples 个样本叠加过驱，
+ *         下降沿后 brakeSamples 个样本输出刹车。
+ ******************************************************************************/
+void HapticKick_Block(HapticKick *kick, u8 *samples, u16 count) {
+    if(kick == NULL || kick->cfg == NULL || samples == NULL) {
+        return;
+    }
+    if(kick->resonanceVersion != HapticResonance_Version()) {
+        Kick_Retune(kick);
+    }
+    for(u16 i = 0; i < count; i++) {
+        samples[i] = Kick_Step(kick, samples[i]);
+    }
+}
+
+/******************************************************************************
+ * @brief  以零输入驱动处理器直到刹车结束。
+ ******************************************************************************/
+u16 HapticKick_Flush(HapticKick *kick, u8 *samples, u16 count) {
+    u16 produced = 0;
+
+    if(kick == NULL || kick->cfg == NULL || samples == NULL) {
+        return 0;
+    }
+    if(kick->last != 0) {
+        samples[produced++] = Kick_Step(kick, 0x00);
+    }
+    while(produced < count && kick->phase == KICK_PHASE_BRAKE && kick->remain != 0) {
+        samples[produced++] = Kick_Step(kick, 0x00);
+    }
+    /* 刹车未被触发（下降量不超过阈值）时只输出了一个零，无需保留 */
+    if(produced == 1 && samples[0] == 0x00) {
+        return 0;
+    }
+    return produced;
+}
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * 文件名   : haptic_kick.h
+ * 描述     : RTP 流的过驱启动与主动刹车后处理：上升沿叠加过驱脉冲，
+ *            下降沿插入反相（或零驱动）刹车，时长按共振半周期计算。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_KICK_H
+#define __HAPTIC_KICK_H
+
+#include "drv2605.h"
+
+/*
+ * 反相刹车输出负的 RTP 值（0x80~0xFF），要求 CONTROL3 bit3 = 0（有符号格式，
+ * 复位默认值）；LRA 下负值即 180° 相位驱动，振子被主动拉停。
+ * 无符号格式或 ERM 应使用 HAPTIC_KICK_BRAKE_ZERO。
+ */
+#define HAPTIC_KICK_DEFAULT_HZ    170   /* 共振未知时的估计值 */
+
+/* 刹车方式 */
+typedef enum {
+	HAPTIC_KICK_BRAKE_REVERSE = 0,  /* 反相驱动，幅值按下降量缩放 */
+	HAPTIC_KICK_BRAKE_ZERO    = 1   /* 刹车窗口内强制零驱动，忽略源样本 */
+} HapticKick_BrakeMode;
+
+typedef struct {
+	u8 kickLevel;        /* 过驱强度（Q7）：叠加量 = 上升量 × kickLevel / 128 */
+	u8 kickHalfCycles;   /* 过驱时长，单位：共振半周期，0 关闭 */
+	u8 brakeLevel;       /* 刹车强度（Q7）：反相幅值 = 下降量 × brakeLevel / 128 */
+	u8 brakeHalfCycles;  /* 刹车时长，单位：共振半周期，0 关闭 */
+	u8 edgeThreshold;    /* 相邻样本跳变超过此值才视为边沿 */
+	u8 brakeMode;        /* HapticKick_BrakeMode */
+} HapticKick_Config;
+
+/* 处理器状态（调用方分配） */
+typedef struct {
+	const HapticKick_Config *cfg;
+	u8 kickSamples;       /* 由共振频率换算的样本数 */
+	u8 brakeSamples;
+	u8 remain;            /* 当前脉冲剩余样本 */
+	u8 phase;             /* 0 无，1 过驱，2 刹车 */
+	u8 boost;             /* 过驱叠加量 / 刹车幅值 */
+	u8 last;              /* 上一个输入样本 */
+	u8 resonanceVersion;
+	u16 sampleHz;         /* 脉冲长度对应的采样率 */
+} HapticKick;
+
+/**
+ * @brief  绑定配置并按当前共振频率计算脉冲长度。
+ */
+void HapticKick_Init(HapticKick *kick, const HapticKick_Config *cfg);
+
+/**
+ * @brief  流开始前复位边沿状态（视为从静止开始）；采样率变化时重算脉冲长度。
+ */
+void HapticKick_Reset(HapticKick *kick, u16 sampleHz);
+
+/**
+ * @brief  原地处理一块增益后的样本；共振频率变化时每块重算一次脉冲长度。
+ */
+void HapticKick_Block(HapticKick *kick, u8 *samples, u16 count);
+
+/**
+ * @brief  流在非零电平处结束时生成收尾刹车。
+ * @return 写入 samples 的样本数（不超过 count），无需刹车时为 0。
+ */
+u16 HapticKick_Flush(HapticKick *kick, u8 *samples, u16 count);
+
+#endif /* __HAPTIC_KICK_H */
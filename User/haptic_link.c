@@ -0,0 +1,319 @@
+/******************************************************************************
+ * 文件名   : haptic_link.c
+ * 描述     : DMA 循环接收 + COBS/CRC16 分帧。半满/全满中断只计圈数，
+ *            数据处理全部在 HapticLink_Poll 中完成。
+ ******************************************************************************/
+#include "haptic_link.h"
+#include "haptic_config.h"
+#include "haptic_instr.h"
+#include "haptic_log.h"
+
+#if HAPTIC_USE_HOST
+void DMA1_Channel5_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+#endif
+
+#define LINK_RX_MASK       (HAPTIC_LINK_RX_SIZE - 1)
+#define LINK_RX_HALF       (HAPTIC_LINK_RX_SIZE / 2)
+#define LINK_COBS_MAX_RUN  0xFE
+
+static u8 s_rx[HAPTIC_LINK_RX_SIZE];
+static volatile u16 s_rxHalves;   /* DMA 写完的半区数 */
+static u32 s_scan;                /* 下一个待扫描字节（绝对位置） */
+static u32 s_frameStart;          /* 当前帧首字节 */
+static u8 s_synced;               /* 0：丢弃到下一个帧界 */
+static u32 s_frameCycles;
+static HapticLink_Stats s_stats;
+
+/* CRC16-CCITT 半字节查表 */
+static const u16 s_crcNibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static u16 Link_Crc(u16 crc, u8 value) {
+    crc = (u16)((crc << 4) ^ s_crcNibble[(crc >> 12) ^ (value >> 4)]);
+    crc = (u16)((crc << 4) ^ s_crcNibble[(crc >> 12) ^ (value & 0x0F)]);
+    return crc;
+}
+
+/* DMA 已写入的绝对位置；中断尚未响应时按计数器所在半区补一 */
+static u32 Link_WritePos(void) {
+    u16 halves;
+    u16 offset;
+
+    do {
+        halves = s_rxHalves;
+        offset = (u16)(HAPTIC_LINK_RX_SIZE - DMA_GetCurrDataCounter(DMA1_Channel5)) & LINK_RX_MASK;
+    } while(halves != s_rxHalves);
+
+    if((offset / LINK_RX_HALF) != (halves & 1)) {
+        halves++;
+    }
+    return (u32)halves * LINK_RX_HALF + (offset & (LINK_RX_HALF - 1));
+}
+
+/******************************************************************************
+ * @brief  RX 引脚、USART DMA 请求与循环 DMA。
+ ******************************************************************************/
+void HapticLink_Init(void) {
+    GPIO_InitTypeDef gpio = {0};
+    DMA_InitTypeDef dma = {0};
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOD, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    gpio.GPIO_Pin = GPIO_Pin_6;
+    gpio.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+    GPIO_Init(GPIOD, &gpio);
+
+    DMA_DeInit(DMA1_Channel5);
+    dma.DMA_PeripheralBaseAddr = (u32)&USART1->DATAR;
+    dma.DMA_MemoryBaseAddr = (u32)s_rx;
+    dma.DMA_DIR = DMA_DIR_PeripheralSRC;
+    dma.DMA_BufferSize = HAPTIC_LINK_RX_SIZE;
+    dma.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    dma.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    dma.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    dma.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    dma.DMA_Mode = DMA_Mode_Circular;
+    dma.DMA_Priority = DMA_Priority_High;
+    dma.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel5, &dma);
+
+    s_rxHalves = 0;
+    s_scan = 0;
+    s_frameStart = 0;
+    s_synced = 0;
+    DMA_ClearITPendingBit(DMA1_IT_GL5);
+    DMA_ITConfig(DMA1_Channel5, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+    DMA_Cmd(DMA1_Channel5, ENABLE);
+
+    USART1->CTLR1 |= USART_Mode_Rx;
+    USART_DMACmd(USART1, USART_DMAReq_Rx, ENABLE);
+}
+
+/* 初始化读取器到帧首；CRC 校验通过后 remain 才有效 */
+static void Link_ReaderStart(HapticLink_Reader *reader, u32 start, u32 end) {
+    reader->pos = start;
+    reader->end = end;
+    reader->remain = 0xFFFF;
+    reader->blockLeft = 0;
+    reader->zeroAfter = 0;
+}
+
+/* 解出下一个字节；COBS 块越过帧界时返回 0 并把 pos 置为帧界之后 */
+static u8 Link_Decode(HapticLink_Reader *reader, u8 *value) {
+    while(reader->blockLeft == 0) {
+        u8 code;
+        if(reader->zeroAfter && reader->pos != reader->end) {
+            reader->zeroAfter = 0;
+            *value = 0x00;
+            return 1;
+        }
+        if(reader->pos == reader->end) {
+            return 0;
+        }
+        code = s_rx[reader->pos++ & LINK_RX_MASK];
+        if((u32)(code - 1) > reader->end - reader->pos) {
+            reader->pos = reader->end + 1; /* 损坏标记 */
+            return 0;
+        }
+        reader->blockLeft = (u8)(code - 1);
+        reader->zeroAfter = (code != 0xFF);
+    }
+    *value = s_rx[reader->pos++ & LINK_RX_MASK];
+    reader->blockLeft--;
+    return 1;
+}
+
+/* 第一遍：校验 CRC 并得到负载长度 */
+static u8 Link_Verify(u32 start, u32 end, u16 *length) {
+    HapticLink_Reader reader;
+    u16 crc = 0xFFFF;
+    u16 count = 0;
+    u8 value;
+
+    Link_ReaderStart(&reader, start, end);
+    while(Link_Decode(&reader, &value)) {
+        crc = Link_Crc(crc, value);
+        count++;
+    }
+    if(reader.pos != end || count < 2 || crc != 0) {
+        return 0;
+    }
+    *length = (u16)(count - 2);
+    return 1;
+}
+
+/******************************************************************************
+ * @brief  查找帧界；帧在 DMA 缓冲中原地校验、原地解析。
+ ******************************************************************************/
+u8 HapticLink_Poll(HapticLink_Handler handler, void *ctx) {
+    u32 write = Link_WritePos();
+    u8 dispatched = 0;
+
+    if(write - s_scan > HAPTIC_LINK_RX_SIZE) {
+        /* 未处理的数据已被覆盖：跳到最新位置并等待下一个帧界 */
+        s_stats.overruns++;
+        s_stats.bytes += write - s_scan;
+        s_scan = write;
+        s_synced = 0;
+        return 0;
+    }
+
+    while(s_scan != write) {
+        u32 pos = s_scan++;
+        s_stats.bytes++;
+        if(s_rx[pos & LINK_RX_MASK] != 0x00) {
+            continue;
+        }
+
+        u32 start = s_frameStart;
+        s_frameStart = s_scan;
+        if(!s_synced) {
+            s_synced = 1;
+            continue;
+        }
+        if(pos == start) {
+            continue; /* 连续帧界 */
+        }
+        if(pos - start > HAPTIC_LINK_MAX_ENCODED) {
+            s_stats.oversize++;
+            continue;
+        }
+
+        HapticLink_Reader reader;
+        u16 length;
+        s_frameCycles = HapticInstr_Cycles();
+        if(!Link_Verify(start, pos, &length)) {
+            s_stats.crcErrors++;
+            continue;
+        }
+        s_stats.frames++;
+        dispatched++;
+        if(handler != NULL) {
+            Link_ReaderStart(&reader, start, pos);
+            reader.remain = length;
+            handler(ctx, &reader);
+        }
+    }
+    /* 超长的未完结帧：放弃并等待下一个帧界，避免起点被覆盖 */
+    if(s_synced && write - s_frameStart > HAPTIC_LINK_MAX_ENCODED) {
+        s_stats.oversize++;
+        s_synced = 0;
+    }
+    return dispatched;
+}
+
+u8 HapticLink_ReadByte(HapticLink_Reader *reader, u8 *value) {
+    if(reader->remain == 0 || !Link_Decode(reader, value)) {
+        return 0;
+    }
+    reader->remain--;
+    return 1;
+}
+
+u16 HapticLink_Read(HapticLink_Reader *reader, u8 *dst, u16 count) {
+    u16 done = 0;
+    u8 value;
+
+    while(done < count && HapticLink_ReadByte(reader, &value)) {
+        if(dst != NULL) {
+            dst[done] = value;
+        }
+        done++;
+    }
+    return done;
+}
+
+u16 HapticLink_Remaining(const HapticLink_Reader *reader) {
+    return reader->remain;
+}
+
+u32 HapticLink_FrameCycles(void) {
+    return s_frameCycles;
+}
+
+u16 HapticLink_Crc16(u16 crc, const u8 *data, u16 length) {
+    for(u16 i = 0; i < length; i++) {
+        crc = Link_Crc(crc, data[i]);
+    }
+    return crc;
+}
+
+/******************************************************************************
+ * @brief  负载 + CRC 拼入栈上缓冲后逐块 COBS 编码，前后各一个帧界，
+ *         整帧交给日志发送队列（与文本日志共用 USART1 TX DMA，不会交错）。
+ ******************************************************************************/
+ErrorStatus HapticLink_Send(const u8 *payload, u16 length) {
+    u8 frame[HAPTIC_LINK_MAX_PAYLOAD + 2];
+    u8 wire[HAPTIC_LINK_MAX_PAYLOAD + 2 + 4];
+    u16 wireLen = 0;
+    u16 crc = 0xFFFF;
+    u16 total;
+    u16 i = 0;
+
+    if(length > HAPTIC_LINK_MAX_PAYLOAD || (payload == NULL && length != 0)) {
+        return NoREADY;
+    }
+    for(u16 n = 0; n < length; n++) {
+        frame[n] = payload[n];
+        crc = Link_Crc(crc, payload[n]);
+    }
+    frame[length] = (u8)(crc >> 8);
+    frame[length + 1] = (u8)crc;
+    total = (u16)(length + 2);
+
+    wire[wireLen++] = 0x00;
+    while(1) {
+        u16 run = 0;
+        while(i + run < total && frame[i + run] != 0x00 && run < LINK_COBS_MAX_RUN) {
+            run++;
+        }
+        wire[wireLen++] = (u8)(run + 1);
+        for(u16 n = 0; n < run; n++) {
+            wire[wireLen++] = frame[i + n];
+        }
+        i += run;
+        if(i >= total) {
+            break;
+        }
+        if(run < LINK_COBS_MAX_RUN) {
+            i++; /* 跳过被编码掉的 0 */
+            if(i == total) {
+                wire[wireLen++] = 0x01; /* 以 0 结尾的数据需要一个空尾块 */
+                break;
+            }
+        }
+    }
+    wire[wireLen++] = 0x00;
+    HapticLog_WriteWait(wire, wireLen);
+    return READY;
+}
+
+const HapticLink_Stats *HapticLink_GetStats(void) {
+    return &s_stats;
+}
+
+/* 链路只由主机模块启用；未编入主机时去掉接收中断，其余函数无人引用，
+ * 由 --gc-sections 丢弃（CRC16 仍供图案库与调校页使用） */
+#if HAPTIC_USE_HOST
+/*********************************************************************
+ * @fn      DMA1_Channel5_IRQHandler
+ *
+ * @brief   USART1 RX DMA 半满/全满：半区计数加一。
+ *
+ * @return  none
+ */
+void DMA1_Channel5_IRQHandler(void) {
+    if(DMA_GetITStatus(DMA1_IT_HT5) != RESET) {
+        s_rxHalves++;
+        DMA_ClearITPendingBit(DMA1_IT_HT5);
+    }
+    if(DMA_GetITStatus(DMA1_IT_TC5) != RESET) {
+        s_rxHalves++;
+        DMA_ClearITPendingBit(DMA1_IT_TC5);
+    }
+}
+#endif /* HAPTIC_USE_HOST */
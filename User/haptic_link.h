@@ -0,0 +1,96 @@
+/******************************************************************************
+ * 文件名   : haptic_link.h
+ * 描述     : 主机二进制链路：USART1 接收走 DMA 循环缓冲，COBS 分帧 + CRC16，
+ *            在 DMA 缓冲上原地解码（零拷贝），发送经日志队列走 TX DMA。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_LINK_H
+#define __HAPTIC_LINK_H
+
+#include "debug.h"
+
+/*
+ * 帧格式（解码后）：payload[n] + CRC16-CCITT（多项式 0x1021，初值 0xFFFF，高字节在前）
+ * 线上格式：0x00 + COBS(解码后数据) + 0x00，0x00 只作帧界。
+ * 发送与文本日志共用 USART1 TX（整帧入队，不会交错）：文本不含 0x00，主机按 0x00 切分后
+ * 以 COBS/CRC 校验区分应答帧与日志文本。
+ */
+#define HAPTIC_LINK_RX_SIZE        128   /* DMA 循环缓冲，2 的幂 */
+#define HAPTIC_LINK_MAX_PAYLOAD    60    /* 解码后负载上限（不含 CRC） */
+#define HAPTIC_LINK_MAX_ENCODED    (HAPTIC_LINK_MAX_PAYLOAD + 2 + 2)
+
+/* 链路统计 */
+typedef struct {
+	u32 bytes;       /* 收到的线上字节 */
+	u32 frames;      /* CRC 正确并已分发的帧 */
+	u16 crcErrors;   /* CRC 或 COBS 错误 */
+	u16 overruns;    /* DMA 覆盖了未处理的数据 */
+	u16 oversize;    /* 超长帧 */
+} HapticLink_Stats;
+
+/* 帧负载读取器：直接从 DMA 缓冲逐字节解 COBS */
+typedef struct {
+	u32 pos;         /* 线上字节绝对位置 */
+	u32 end;         /* 帧界位置 */
+	u16 remain;      /* 剩余负载字节（不含 CRC） */
+	u8 blockLeft;    /* 当前 COBS 块剩余数据字节 */
+	u8 zeroAfter;    /* 当前块结束后补 0 */
+} HapticLink_Reader;
+
+/**
+ * @brief  帧处理回调：payload 只在回调期间有效。
+ */
+typedef void (*HapticLink_Handler)(void *ctx, HapticLink_Reader *payload);
+
+/**
+ * @brief  打开 USART1 RX（PD6）与 DMA1 通道 5 循环接收。
+ * @note   须在 USART_Printf_Init 之后调用，波特率沿用调试串口。
+ */
+void HapticLink_Init(void);
+
+/**
+ * @brief  扫描新到达的字节，对每个完整且 CRC 正确的帧调用 handler。
+ * @return 本次分发的帧数。
+ */
+u8 HapticLink_Poll(HapticLink_Handler handler, void *ctx);
+
+/**
+ * @brief  读取一个负载字节。
+ * @return 1 成功，0 负载已读完。
+ */
+u8 HapticLink_ReadByte(HapticLink_Reader *reader, u8 *value);
+
+/**
+ * @brief  读取最多 count 个负载字节到 dst（dst 为 NULL 时跳过）。
+ * @return 实际读取数量。
+ */
+u16 HapticLink_Read(HapticLink_Reader *reader, u8 *dst, u16 count);
+
+/**
+ * @brief  剩余负载字节数。
+ */
+u16 HapticLink_Remaining(const HapticLink_Reader *reader);
+
+/**
+ * @brief  当前帧的帧界被发现时的周期时间戳，用于命令到震动的延迟统计。
+ */
+u32 HapticLink_FrameCycles(void);
+
+/**
+ * @brief  附加 CRC 后 COBS 编码并整帧入队发送（队列满时等待）。
+ * @return READY 成功，NoREADY 负载超长。
+ */
+ErrorStatus HapticLink_Send(const u8 *payload, u16 length);
+
+/**
+ * @brief  CRC16-CCITT（多项式 0x1021），与帧校验相同，供 flash 记录等复用。
+ * @param  crc 初值（首段传 0xFFFF），可分段累计。
+ */
+u16 HapticLink_Crc16(u16 crc, const u8 *data, u16 length);
+
+/**
+ * @brief  获取链路统计。
+ */
+const HapticLink_Stats *HapticLink_GetStats(void);
+
+#endif /* __HAPTIC_LINK_H */
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * 文件名   : haptic_log.c
+ * 描述     : 环形缓冲按连续段交给 DMA 发送，传输完成中断推进读指针并
+ *            启动下一段。入队在关中断的短临界区内完成，中断上下文同样安全。
+ ******************************************************************************/
+#include "haptic_log.h"
+
+void DMA1_Channel4_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+
+#define LOG_RING_MASK      (HAPTIC_LOG_RING - 1)
+#define LOG_MSTATUS_MIE    0x08
+
+static u8 s_ring[HAPTIC_LOG_RING];
+static volatile u16 s_head;       /* DMA 读位置 */
+static volatile u16 s_tail;       /* 写位置 */
+static volatile u16 s_inFlight;   /* 当前 DMA 段长度，0 表示空闲 */
+static HapticLog_Stats s_stats;
+
+static u32 Log_Lock(void) {
+    u32 mstatus = __get_MSTATUS();
+    __set_MSTATUS(mstatus & ~LOG_MSTATUS_MIE);
+    return mstatus;
+}
+
+static void Log_Unlock(u32 mstatus) {
+    __set_MSTATUS(mstatus);
+}
+
+/* 空闲时把读指针之后的连续段交给 DMA；调用方持锁 */
+static void Log_Kick(void) {
+    u16 used = (u16)(s_tail - s_head);
+    u16 offset = s_head & LOG_RING_MASK;
+    u16 run;
+
+    if(s_inFlight != 0 || used == 0) {
+        return;
+    }
+    run = (u16)(HAPTIC_LOG_RING - offset);
+    if(run > used) {
+        run = used;
+    }
+    s_inFlight = run;
+    DMA_Cmd(DMA1_Channel4, DISABLE);
+    DMA1_Channel4->MADDR = (u32)&s_ring[offset];
+    DMA_SetCurrDataCounter(DMA1_Channel4, run);
+    DMA_Cmd(DMA1_Channel4, ENABLE);
+}
+
+/******************************************************************************
+ * @brief  DMA 内存到外设，单次模式，完成中断续传。
+ ******************************************************************************/
+void HapticLog_Init(void) {
+    DMA_InitTypeDef dma = {0};
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    DMA_DeInit(DMA1_Channel4);
+    dma.DMA_PeripheralBaseAddr = (u32)&USART1->DATAR;
+    dma.DMA_MemoryBaseAddr = (u32)s_ring;
+    dma.DMA_DIR = DMA_DIR_PeripheralDST;
+    dma.DMA_BufferSize = 0;
+    dma.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    dma.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    dma.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    dma.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    dma.DMA_Mode = DMA_Mode_Normal;
+    dma.DMA_Priority = DMA_Priority_Low;
+    dma.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel4, &dma);
+
+    s_head = 0;
+    s_tail = 0;
+    s_inFlight = 0;
+    DMA_ClearITPendingBit(DMA1_IT_TC4);
+    DMA_ITConfig(DMA1_Channel4, DMA_IT_TC, ENABLE);
+    NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+    USART_DMACmd(USART1, USART_DMAReq_Tx, ENABLE);
+}
+
+ErrorStatus HapticLog_Write(const u8 *data, u16 length) {
+    u32 lock;
+    u16 used;
+
+    if(data == NULL || length == 0) {
+        return READY;
+    }
+
+    lock = Log_Lock();
+    used = (u16)(s_tail - s_head);
+    if(length > HAPTIC_LOG_RING - used) {
+        s_stats.dropped++;
+        Log_Unlock(lock);
+        return NoREADY;
+    }
+    for(u16 i = 0; i < length; i++) {
+        s_ring[(s_tail + i) & LOG_RING_MASK] = data[i];
+    }
+    s_tail = (u16)(s_tail + length);
+    used = (u16)(used + length);
+    s_stats.bytes += length;
+    if(used > s_stats.highWater) {
+        s_stats.highWater = used;
+    }
+    Log_Kick();
+    Log_Unlock(lock);
+    return READY;
+}
+
+ErrorStatus HapticLog_WriteWait(const u8 *data, u16 length) {
+    if(length > HAPTIC_LOG_RING) {
+        return NoREADY;
+    }
+    while((u16)(HAPTIC_LOG_RING - (u16)(s_tail - s_head)) < length) {
+    }
+    return HapticLog_Write(data, length);
+}
+
+void HapticLog_Flush(void) {
+    while(s_tail != s_head) {
+    }
+    while(USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET) {
+    }
+}
+
+const HapticLog_Stats *HapticLog_GetStats(void) {
+    return &s_stats;
+}
+
+/*********************************************************************
+ * @fn      DMA1_Channel4_IRQHandler
+ *
+ * @brief   USART1 TX DMA 完成：释放已发送段并续传。
+ *
+ * @return  none
+ */
+void DMA1_Channel4_IRQHandler(void) {
+    if(DMA_GetITStatus(DMA1_IT_TC4) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_TC4);
+        s_head = (u16)(s_head + s_inFlight);
+        s_inFlight = 0;
+        Log_Kick();
+    }
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * 文件名   : haptic_log.h
+ * 描述     : 非阻塞日志：RAM 环形缓冲 + USART1 TX DMA 后台发送，满时丢弃计数，
+ *            可在中断中调用。内容为 haptic_trace 二进制记录与链路应答帧。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_LOG_H
+#define __HAPTIC_LOG_H
+
+#include "debug.h"
+
+#define HAPTIC_LOG_RING        256   /* 发送环形缓冲，2 的幂 */
+
+/* 日志统计 */
+typedef struct {
+	u32 bytes;         /* 已入队字节 */
+	u16 dropped;       /* 因缓冲满丢弃的条目 */
+	u16 highWater;     /* 缓冲占用峰值 */
+} HapticLog_Stats;
+
+/**
+ * @brief  配置 DMA1 通道 4 为 USART1 TX；此后所有串口输出都应经过本模块。
+ * @note   须在 USART_Printf_Init 之后调用。
+ */
+void HapticLog_Init(void);
+
+/**
+ * @brief  原样入队一段字节（全部或全不）。
+ * @return READY 已入队，NoREADY 空间不足已丢弃。
+ */
+ErrorStatus HapticLog_Write(const u8 *data, u16 length);
+
+/**
+ * @brief  等待空间后入队，用于不可丢失的协议帧；不可在中断中调用。
+ * @return READY 已入队，NoREADY 长度超过缓冲。
+ */
+ErrorStatus HapticLog_WriteWait(const u8 *data, u16 length);
+
+/**
+ * @brief  等待缓冲与 DMA 全部发送完毕（休眠、切换时钟前调用）。
+ */
+void HapticLog_Flush(void);
+
+/**
+ * @brief  获取统计。
+ */
+const HapticLog_Stats *HapticLog_GetStats(void);
+
+#endif /* __HAPTIC_LOG_H */
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * 文件名   : haptic_mixer.c
+ * 描述     : 多声部混音。增益在块边界按斜率逼近目标值，块内为常量；
+ *            缩放与饱和累加由 SWAR 核按字完成，每次处理 4 个样本。
+ ******************************************************************************/
+#include "haptic_mixer.h"
+#include "haptic_swar.h"
+#include "haptic_vbat.h"
+
+#define MIXER_DEFAULT_DUCK   32     /* 约 -12dB */
+#define MIXER_DEFAULT_SLEW   16     /* 每块（16ms）最多变化 1/8 */
+
+typedef struct {
+    HapticRtp_Source source;
+    void *ctx;
+    u16 delay;       /* 剩余延迟样本 */
+    u8 active;
+    u8 priority;
+    u8 gain;         /* 设定增益 */
+    u8 level;        /* 当前生效增益（含闪避） */
+    u8 fresh;        /* 首次发声直接取目标增益 */
+} Mixer_Voice;
+
+static Mixer_Voice s_voices[HAPTIC_MIXER_VOICES];
+static HapticMixer_Stats s_stats;
+static u8 s_duckGain = MIXER_DEFAULT_DUCK;
+static u8 s_slew = MIXER_DEFAULT_SLEW;
+
+static u8 Mixer_Approach(u8 current, u8 target) {
+    if(current < target) {
+        return (u8)((target - current > s_slew) ? current + s_slew : target);
+    }
+    return (u8)((current - target > s_slew) ? current - s_slew : target);
+}
+
+/******************************************************************************
+ * @brief  清空声部。
+ ******************************************************************************/
+void HapticMixer_Init(void) {
+    for(u8 i = 0; i < HAPTIC_MIXER_VOICES; i++) {
+        s_voices[i].active = 0;
+    }
+    s_duckGain = MIXER_DEFAULT_DUCK;
+    s_slew = MIXER_DEFAULT_SLEW;
+    s_stats.blocks = 0;
+    s_stats.clipped = 0;
+    s_stats.stolen = 0;
+}
+
+/******************************************************************************
+ * @brief  占用空闲声部，否则抢占优先级最低且低于新声部的声部。
+ ******************************************************************************/
+u8 HapticMixer_Add(HapticRtp_Source source, void *ctx, u8 gain, u8 priority, u16 delaySamples) {
+    u8 slot = HAPTIC_MIXER_NO_VOICE;
+
+    if(source == NULL || !HapticVbat_Allow(priority)) {
+        return HAPTIC_MIXER_NO_VOICE;
+    }
+
+    for(u8 i = 0; i < HAPTIC_MIXER_VOICES; i++) {
+        if(!s_voices[i].active) {
+            slot = i;
+            break;
+        }
+        if(s_voices[i].priority < priority &&
+           (slot == HAPTIC_MIXER_NO_VOICE || s_voices[i].priority < s_voices[slot].priority)) {
+            slot = i;
+        }
+    }
+    if(slot == HAPTIC_MIXER_NO_VOICE) {
+        return HAPTIC_MIXER_NO_VOICE;
+    }
+    if(s_voices[slot].active) {
+        s_stats.stolen++;
+    }
+
+    s_voices[slot].source = source;
+    s_voices[slot].ctx = ctx;
+    s_voices[slot].delay = delaySamples;
+    s_voices[slot].priority = priority;
+    s_voices[slot].gain = gain;
+    s_voices[slot].fresh = 1;
+    s_voices[slot].active = 1;
+    return slot;
+}
+
+void HapticMixer_Stop(u8 voice) {
+    if(voice < HAPTIC_MIXER_VOICES) {
+        s_voices[voice].active = 0;
+    }
+}
+
+void HapticMixer_SetGain(u8 voice, u8 gain) {
+    if(voice < HAPTIC_MIXER_VOICES) {
+        s_voices[voice].gain = gain;
+    }
+}
+
+void HapticMixer_SetDucking(u8 duckGain, u8 slew) {
+    s_duckGain = duckGain;
+    s_slew = (slew == 0) ? 1 : slew;
+}
+
+u8 HapticMixer_ActiveCount(void) {
+    u8 count = 0;
+    for(u8 i = 0; i < HAPTIC_MIXER_VOICES; i++) {
+        count += s_voices[i].active;
+    }
+    return count;
+}
+
+/******************************************************************************
+ * @brief  依次渲染各声部，按字缩放后饱和累加到输出块。
+ ******************************************************************************/
+u16 HapticMixer_Render(u8 *samples, u16 count) {
+    HapticRtp_Block scratch;
+    u8 topPriority = 0;
+    u8 any = 0;
+
+    if(samples == NULL) {
+        return 0;
+    }
+    if(count > HAPTIC_RTP_BLOCK) {
+        count = HAPTIC_RTP_BLOCK;
+    }
+
+    /* 本块内发声的最高优先级决定谁被闪避 */
+    for(u8 v = 0; v < HAPTIC_MIXER_VOICES; v++) {
+        if(s_voices[v].active) {
+            any = 1;
+            if(s_voices[v].delay < count && s_voices[v].priority > topPriority) {
+                topPriority = s_voices[v].priority;
+            }
+        }
+    }
+    if(!any) {
+        return 0;
+    }
+
+    HapticSwar_Fill(samples, 0, count);
+
+    for(u8 v = 0; v < HAPTIC_MIXER_VOICES; v++) {
+        Mixer_Voice *voice = &s_voices[v];
+        u16 offset;
+        u16 want;
+        u16 got;
+        u8 target;
+
+        if(!voice->active) {
+            continue;
+        }
+        if(voice->delay >= count) {
+            voice->delay -= count;
+            continue;
+        }
+        offset = voice->delay;
+        voice->delay = 0;
+
+        target = voice->gain;
+        if(voice->priority < topPriority) {
+            target = (u8)(((u16)target * s_duckGain) >> 7);
+        }
+        voice->level = voice->fresh ? target : Mixer_Approach(voice->level, target);
+        voice->fresh = 0;
+
+        /* 延迟起点之前与样本源结束之后保持为 0，整块按字处理 */
+        want = (u16)(count - offset);
+        HapticSwar_Fill(scratch.samples, 0, count);
+        got = voice->source(voice->ctx, scratch.samples + offset, want);
+        if(got > want) {
+            got = want;
+        }
+        if(got < want) {
+            voice->active = 0;
+        }
+        if(got == 0 || voice->level == 0) {
+            continue;
+        }
+
+        HapticSwar_Gain(scratch.samples, count, voice->level);
+        s_stats.clipped += HapticSwar_SatAdd(samples, scratch.samples, count);
+    }
+
+    s_stats.blocks++;
+    return count;
+}
+
+u16 HapticMixer_Source(void *ctx, u8 *samples, u16 count) {
+    (void)ctx;
+    return HapticMixer_Render(samples, count);
+}
+
+const HapticMixer_Stats *HapticMixer_GetStats(void) {
+    return &s_stats;
+}
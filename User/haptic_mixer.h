@@ -0,0 +1,79 @@
+/******************************************************************************
+ * 文件名   : haptic_mixer.h
+ * 描述     : 多声部 RTP 混音：每声部增益、饱和求和、按优先级闪避（ducking）。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_MIXER_H
+#define __HAPTIC_MIXER_H
+
+#include "haptic_rtp.h"
+
+#define HAPTIC_MIXER_VOICES      4      /* 声部数 */
+#define HAPTIC_MIXER_UNITY       128    /* 增益 1.0（Q7），允许 >128 提升 */
+#define HAPTIC_MIXER_NO_VOICE    0xFF
+
+/* 混音统计 */
+typedef struct {
+	u32 blocks;   /* 已混合块数 */
+	u32 clipped;  /* 累加时饱和的样本次数 */
+	u32 stolen;   /* 因声部已满被抢占的次数 */
+} HapticMixer_Stats;
+
+/**
+ * @brief  清空所有声部，恢复默认闪避参数。
+ */
+void HapticMixer_Init(void);
+
+/**
+ * @brief  添加一个声部。
+ * @param  source       样本源（与 HapticRtp_Play 相同的回调）。
+ * @param  ctx          样本源上下文。
+ * @param  gain         增益，HAPTIC_MIXER_UNITY 为原幅值。
+ * @param  priority     优先级，数值大者存在时其余声部被闪避。
+ * @param  delaySamples 延迟多少个样本后开始。
+ * @note   声部已满时抢占优先级更低的声部；仅在主循环/样本源回调中调用。
+ *         电量危急（HapticVbat_Allow）时低优先级声部被直接拒绝。
+ * @return 声部号，失败返回 HAPTIC_MIXER_NO_VOICE。
+ */
+u8 HapticMixer_Add(HapticRtp_Source source, void *ctx, u8 gain, u8 priority, u16 delaySamples);
+
+/**
+ * @brief  停止一个声部。
+ */
+void HapticMixer_Stop(u8 voice);
+
+/**
+ * @brief  修改声部增益，按闪避斜率平滑过渡。
+ */
+void HapticMixer_SetGain(u8 voice, u8 gain);
+
+/**
+ * @brief  设置闪避参数。
+ * @param  duckGain 被闪避声部的增益系数（Q7，128 表示不闪避）。
+ * @param  slew     每块增益最大变化量，避免切换时的阶跃。
+ */
+void HapticMixer_SetDucking(u8 duckGain, u8 slew);
+
+/**
+ * @brief  正在播放或等待开始的声部数。
+ */
+u8 HapticMixer_ActiveCount(void);
+
+/**
+ * @brief  混合最多 count 个样本（单次不超过 HAPTIC_RTP_BLOCK）。
+ * @note   各声部依次渲染到同一临时块再累加，RAM 开销与声部数无关。
+ * @return 实际数量，所有声部结束后返回 0。
+ */
+u16 HapticMixer_Render(u8 *samples, u16 count);
+
+/**
+ * @brief  HapticRtp_Source 适配，ctx 未使用。
+ */
+u16 HapticMixer_Source(void *ctx, u8 *samples, u16 count);
+
+/**
+ * @brief  获取混音统计。
+ */
+const HapticMixer_Stats *HapticMixer_GetStats(void);
+
+#endif /* __HAPTIC_MIXER_H */
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * 文件名   : haptic_pattern.c
+ * 描述     : 压缩图案流式解码：直接读取 flash，不做 RAM 展开。
+ ******************************************************************************/
+#include "haptic_pattern.h"
+#include "haptic_swar.h"
+
+#define PATTERN_OP_END     0xF0
+
+/* 4 位电平扩展到 7 位：15 → 0x7F，0 → 0 */
+static u8 Pattern_Expand(const HapticPatternDecoder *dec) {
+    if(dec->pattern->flags & HAPTIC_PATTERN_QUANT4) {
+        return (u8)((dec->level << 3) | (dec->level >> 1));
+    }
+    return dec->level;
+}
+
+static u8 Pattern_ClampLevel(const HapticPatternDecoder *dec, s16 level) {
+    s16 top = (dec->pattern->flags & HAPTIC_PATTERN_QUANT4) ? 0x0F : 0x7F;
+    if(level < 0) {
+        return 0;
+    }
+    return (u8)((level > top) ? top : level);
+}
+
+/* 读取下一个操作码，更新电平与保持样本数；返回 0 表示结束 */
+static u8 Pattern_NextOp(HapticPatternDecoder *dec) {
+    const HapticPattern *pattern = dec->pattern;
+    const u8 *data = pattern->data;
+    u16 units;
+
+    if(dec->nibbleBytes) {
+        u8 packed = data[dec->pos];
+        if(dec->nibbleLow) {
+            dec->level = packed & 0x0F;
+            dec->nibbleLow = 0;
+            dec->pos++;
+            dec->nibbleBytes--;
+        } else {
+            dec->level = packed >> 4;
+            dec->nibbleLow = 1;
+        }
+        dec->holdRemain = pattern->unitMs;
+        return 1;
+    }
+
+    if(dec->pos >= pattern->size) {
+        return 0;
+    }
+
+    u8 op = data[dec->pos++];
+    if((op & 0x80) == 0) {
+        s8 delta = (s8)((u8)(op << 1) & 0xF0) >> 4;
+        dec->level = Pattern_ClampLevel(dec, (s16)dec->level + delta);
+        units = (u16)((op & 0x07) + 1);
+    } else if((op & 0xC0) == 0x80) {
+        units = (u16)((op & 0x3F) + 1);
+    } else if((op & 0xE0) == 0xC0) {
+        if(dec->pos >= pattern->size) {
+            return 0;
+        }
+        dec->level = Pattern_ClampLevel(dec, data[dec->pos++]);
+        units = (u16)((op & 0x1F) + 1);
+    } else if((op & 0xF0) == 0xE0) {
+        if(dec->pos >= pattern->size) {
+            return 0;
+        }
+        units = (u16)((((u16)(op & 0x0F) << 8) | data[dec->pos++]) + 1);
+    } else {
+        if(op == PATTERN_OP_END || (u16)(dec->pos + (op & 0x0F)) > pattern->size) {
+            dec->pos = pattern->size;
+            return 0;
+        }
+        dec->nibbleBytes = op & 0x0F;
+        dec->nibbleLow = 0;
+        return Pattern_NextOp(dec);
+    }
+
+    dec->holdRemain = (u32)units * pattern->unitMs;
+    return 1;
+}
+
+/******************************************************************************
+ * @brief  绑定图案。
+ ******************************************************************************/
+void HapticPattern_Start(HapticPatternDecoder *dec, const HapticPattern *pattern) {
+    if(dec == NULL) {
+        return;
+    }
+    dec->pattern = pattern;
+    dec->pos = 0;
+    dec->holdRemain = 0;
+    dec->level = 0;
+    dec->nibbleBytes = 0;
+    dec->nibbleLow = 0;
+}
+
+/******************************************************************************
+ * @brief  按保持段整段填充当前电平（按字写入），保持耗尽时读取下一个操作码。
+ ******************************************************************************/
+u16 HapticPattern_Render(HapticPatternDecoder *dec, u8 *samples, u16 count) {
+    u16 produced = 0;
+    u16 run;
+
+    if(dec == NULL || dec->pattern == NULL || samples == NULL) {
+        return 0;
+    }
+
+    while(produced < count) {
+        if(dec->holdRemain == 0) {
+            if(!Pattern_NextOp(dec)) {
+                break;
+            }
+            if(dec->holdRemain == 0) {
+                continue; /* unitMs 为 0 的图案视为无效帧 */
+            }
+        }
+        run = (u16)(count - produced);
+        if(run > dec->holdRemain) {
+            run = (u16)dec->holdRemain;
+        }
+        HapticSwar_Fill(samples + produced, Pattern_Expand(dec), run);
+        produced += run;
+        dec->holdRemain -= run;
+    }
+
+    return produced;
+}
+
+u16 HapticPattern_Source(void *ctx, u8 *samples, u16 count) {
+    return HapticPattern_Render((HapticPatternDecoder *)ctx, samples, count);
+}
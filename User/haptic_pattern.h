@@ -0,0 +1,57 @@
+/******************************************************************************
+ * 文件名   : haptic_pattern.h
+ * 描述     : flash 压缩触感图案（差分幅值 + 游程保持 + 可选 4 位量化）及流式解码。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_PATTERN_H
+#define __HAPTIC_PATTERN_H
+
+#include "haptic_rtp.h"
+
+/*
+ * 字节流操作码（“单位” = unitMs 个采样，采样率见 HAPTIC_RTP_SAMPLE_HZ）：
+ *   0ddd dhhh          差分帧：电平 += d（4 位有符号），保持 h+1 个单位
+ *   10hh hhhh          游程：保持当前电平 h+1 个单位
+ *   110h hhhh  aaaaaaaa 绝对帧：电平 = a，保持 h+1 个单位
+ *   1110 hhhh  llllllll 长游程：保持当前电平 (h<<8 | l)+1 个单位
+ *   1111 cccc  ...      c 字节半字节块（仅量化模式）：每字节高/低 4 位各为一个单位的电平
+ *   1111 0000          结束
+ * 量化模式下电平为 0~15，输出时扩展为 0~0x7F；否则电平即 RTP 值。
+ */
+#define HAPTIC_PATTERN_QUANT4      0x01
+
+/* flash 中的一个压缩图案（由 Tools/pattern_pack.cpp 生成） */
+typedef struct {
+	const u8 *data;  /* 操作码流 */
+	u16 size;        /* 字节数 */
+	u8 unitMs;       /* 保持时间单位 */
+	u8 flags;        /* HAPTIC_PATTERN_QUANT4 等 */
+} HapticPattern;
+
+/* 解码器状态（调用方分配，无动态内存） */
+typedef struct {
+	const HapticPattern *pattern;
+	u32 holdRemain;   /* 当前电平剩余样本数：长游程 4096 单位 × unitMs 255 超出 u16 */
+	u16 pos;          /* 下一个读取位置 */
+	u8 level;         /* 当前电平（编码域） */
+	u8 nibbleBytes;   /* 半字节块剩余字节 */
+	u8 nibbleLow;     /* 1 表示下一个取低 4 位 */
+} HapticPatternDecoder;
+
+/**
+ * @brief  绑定图案并复位解码器。
+ */
+void HapticPattern_Start(HapticPatternDecoder *dec, const HapticPattern *pattern);
+
+/**
+ * @brief  解码最多 count 个 RTP 样本；每个操作码 O(1) 且至少产出一个样本。
+ * @return 实际数量，图案结束返回 0。
+ */
+u16 HapticPattern_Render(HapticPatternDecoder *dec, u8 *samples, u16 count);
+
+/**
+ * @brief  HapticRtp_Source 适配，ctx 为 HapticPatternDecoder 指针。
+ */
+u16 HapticPattern_Source(void *ctx, u8 *samples, u16 count);
+
+#endif /* __HAPTIC_PATTERN_H */
@@ -0,0 +1,34 @@
+/******************************************************************************
+ * 文件名   : haptic_patterns.c
+ * 描述     : 内置压缩图案库。数据由 Tools/pattern_pack.cpp 生成，请勿手工修改：
+ *              pattern_pack --quant4 --unit 5 heartbeatPattern Tools/patterns/heartbeat.csv
+ *              pattern_pack --quant4 swellPattern Tools/patterns/swell.csv
+ ******************************************************************************/
+#include "haptic_patterns.h"
+
+/* 由 Tools/pattern_pack.cpp 生成：heartbeat.csv，26 帧 -> 33 字节 */
+static const u8 heartbeatPattern_data[] = {
+    0x19, 0x29, 0x33, 0x0D, 0x63, 0x53, 0x5F, 0x8F, 0x21, 0x33, 0x1C, 0x5A,
+    0x5A, 0x6F, 0xE0, 0x47, 0x19, 0x29, 0x33, 0x0D, 0x63, 0x53, 0x5F, 0x8F,
+    0x21, 0x33, 0x1C, 0x5A, 0x5A, 0x6F, 0xE0, 0x47, 0xF0
+};
+const HapticPattern heartbeatPattern = { heartbeatPattern_data, sizeof(heartbeatPattern_data), 5, HAPTIC_PATTERN_QUANT4 };
+
+/* 由 Tools/pattern_pack.cpp 生成：swell.csv，400 帧 -> 160 字节 */
+static const u8 swellPattern_data[] = {
+    0x03, 0x0F, 0x89, 0x0B, 0x0A, 0x0F, 0x80, 0x7F, 0x81, 0x09, 0x09, 0x0A,
+    0x0D, 0x79, 0x7A, 0x7C, 0x0A, 0x08, 0x09, 0x09, 0x0A, 0x08, 0x7A, 0x79,
+    0x79, 0x7A, 0x79, 0x0A, 0x08, 0x09, 0x08, 0x08, 0x09, 0x0B, 0x79, 0x79,
+    0x78, 0x79, 0x79, 0x79, 0x09, 0x09, 0x08, 0x08, 0x08, 0x09, 0x09, 0x09,
+    0x79, 0x79, 0x78, 0x78, 0x79, 0x79, 0x7A, 0x09, 0xF2, 0x9A, 0xBC, 0x08,
+    0x09, 0x0B, 0x79, 0xF2, 0xDC, 0xBA, 0x79, 0x7C, 0xF2, 0x9A, 0xBC, 0x08,
+    0x09, 0x0D, 0xF2, 0xED, 0xCB, 0x79, 0x78, 0x7B, 0x09, 0xF2, 0xAB, 0xCD,
+    0x08, 0x0E, 0xF2, 0xED, 0xCB, 0x79, 0x78, 0x7B, 0x09, 0xF2, 0xAB, 0xCD,
+    0x09, 0x0C, 0x79, 0xF2, 0xDC, 0xBA, 0x78, 0x7D, 0x09, 0x08, 0x08, 0x08,
+    0x09, 0x0C, 0x79, 0xF2, 0xCB, 0xA9, 0x79, 0x7C, 0x09, 0x08, 0x08, 0x09,
+    0x09, 0x0A, 0x79, 0x78, 0x79, 0x78, 0x78, 0x79, 0x7C, 0x09, 0x09, 0x08,
+    0x09, 0x0B, 0x79, 0x79, 0x78, 0x79, 0x78, 0x7E, 0x09, 0x09, 0x0E, 0x7A,
+    0x78, 0x79, 0x7B, 0x79, 0x0B, 0x0F, 0x81, 0x7A, 0x7A, 0x7F, 0x82, 0x0B,
+    0x7D, 0x7E, 0x7D, 0xF0
+};
+const HapticPattern swellPattern = { swellPattern_data, sizeof(swellPattern_data), 1, HAPTIC_PATTERN_QUANT4 };
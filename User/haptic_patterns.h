@@ -0,0 +1,14 @@
+/******************************************************************************
+ * 文件名   : haptic_patterns.h
+ * 描述     : 内置压缩图案库声明。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_PATTERNS_H
+#define __HAPTIC_PATTERNS_H
+
+#include "haptic_pattern.h"
+
+extern const HapticPattern heartbeatPattern;  /* 双脉冲心跳，5ms 单位 */
+extern const HapticPattern swellPattern;      /* 1ms 采样的起伏渐强纹理 */
+
+#endif /* __HAPTIC_PATTERNS_H */
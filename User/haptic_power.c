@@ -0,0 +1,315 @@
+/******************************************************************************
+ * 文件名   : haptic_power.c
+ * 描述     : 电源状态机 ACTIVE → STANDBY → OFF。降级只在 HapticPower_Idle 与
+ *            HapticPower_Standby 中进行，唤醒由 DRV2605 总线钩子在下一次事务前触发。
+ ******************************************************************************/
+#include "haptic_power.h"
+#include "haptic_log.h"
+#include "haptic_clock.h"
+
+#define POWER_MSTATUS_MIE   0x00000008UL
+
+/* AWU 分频：下标即 PWR_AWU_Prescaler_x 编码（编码 1 不存在） */
+static const u16 s_awuDivider[16] = {
+    1, 0, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 10240, 61440
+};
+
+static HapticPower_Config s_config;
+static HapticPower_Stats s_stats;
+static HapticPower_State s_state;
+static u8 s_switching;     /* 本模块自己的总线事务不触发钩子 */
+static u32 s_lastActive;   /* 最近一次总线事务的时间戳 */
+static u32 s_stateSince;   /* 当前状态未结算部分的起点 */
+static HapticInstr_Probe s_wakeLatency[HAPTIC_POWER_STATES];
+static HapticInstr_Probe s_onsetLatency;
+static u8 s_awuReady;
+static u8 s_onsetPending;
+static u32 s_deepWake;     /* 最近一次 WFE 返回的时间戳 */
+
+/* 结算当前状态的驻留时间，不足 1ms 的余数留到下次 */
+static void Power_Account(void) {
+    u32 cyclesPerMs = HapticInstr_CyclesPerUs() * 1000UL;
+    u32 ms = (HapticInstr_Cycles() - s_stateSince) / cyclesPerMs;
+
+    s_stats.residencyMs[s_state] += ms;
+    s_stateSince += ms * cyclesPerMs;
+}
+
+static void Power_Enter(HapticPower_State state) {
+    Power_Account();
+    s_state = state;
+}
+
+/* 屏蔽中断下复查空闲时长并先行切换状态：此后按键/传感器中断看到非 ACTIVE
+ * 只会转交主循环，不会在待机/断电事务进行中 GO 后被截断 */
+static u8 Power_Claim(HapticPower_State next, u16 limitMs) {
+    u32 mstatus = __get_MSTATUS();
+    u32 cyclesPerMs = HapticInstr_CyclesPerUs() * 1000UL;
+    u8 claimed = 0;
+
+    __set_MSTATUS(mstatus & ~POWER_MSTATUS_MIE);
+    if(limitMs != 0 && (HapticInstr_Cycles() - s_lastActive) / cyclesPerMs >= limitMs) {
+        Power_Enter(next);
+        s_switching = 1;
+        claimed = 1;
+    }
+    __set_MSTATUS(mstatus);
+    return claimed;
+}
+
+static void Power_BusHook(void) {
+    if(s_switching) {
+        return;
+    }
+    s_lastActive = HapticInstr_Cycles();
+    if(s_state != HAPTIC_POWER_ACTIVE) {
+        HapticPower_Wake();
+    }
+}
+
+/* PWR 时钟、LSI 与 AWU 事件线（EXTI 线 9，事件模式）只需配置一次 */
+static void Power_AwuInit(void) {
+    EXTI_InitTypeDef exti = {0};
+
+    if(s_awuReady) {
+        return;
+    }
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR, ENABLE);
+    exti.EXTI_Line = EXTI_Line9;
+    exti.EXTI_Mode = EXTI_Mode_Event;
+    exti.EXTI_Trigger = EXTI_Trigger_Falling;
+    exti.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&exti);
+    RCC_LSICmd(ENABLE);
+    while(RCC_GetFlagStatus(RCC_FLAG_LSIRDY) == RESET) {
+    }
+    s_awuReady = 1;
+}
+
+/* 取能容纳 ms 的最小分频（窗口 ≤ 63），返回实际周期 ms */
+static u32 Power_AwuArm(u32 ms) {
+    u32 ticks = ms * (HAPTIC_POWER_LSI_HZ / 1000);
+    u32 window;
+    u8 code = 0;
+
+    while(code < 15 && (s_awuDivider[code] == 0 || ticks > 63UL * s_awuDivider[code])) {
+        code++;
+    }
+    window = (ticks + s_awuDivider[code] / 2) / s_awuDivider[code];
+    if(window == 0) {
+        window = 1;
+    } else if(window > 63) {
+        window = 63;
+    }
+    PWR_AWU_SetPrescaler(code);
+    PWR_AWU_SetWindowValue((u8)window);
+    PWR_AutoWakeUpCmd(ENABLE);
+    return window * s_awuDivider[code] / (HAPTIC_POWER_LSI_HZ / 1000);
+}
+
+/******************************************************************************
+ * @brief  EN 引脚已由 IIC_Init 配置为推挽输出并拉高。
+ ******************************************************************************/
+void HapticPower_Init(const HapticPower_Config *cfg) {
+    if(cfg != NULL) {
+        s_config = *cfg;
+    }
+    for(u8 i = 0; i < HAPTIC_POWER_STATES; i++) {
+        s_stats.residencyMs[i] = 0;
+        HapticInstr_ProbeReset(&s_wakeLatency[i]);
+    }
+    s_stats.sleeps = 0;
+    s_stats.standbyEntries = 0;
+    s_stats.offEntries = 0;
+    s_stats.wakeErrors = 0;
+    s_stats.deepMs = 0;
+    s_stats.deepWakes = 0;
+    HapticInstr_ProbeReset(&s_onsetLatency);
+    s_onsetPending = 0;
+
+    GPIO_SetBits(HAPTIC_POWER_EN_PORT, HAPTIC_POWER_EN_PIN);
+    s_state = HAPTIC_POWER_ACTIVE;
+    s_switching = 0;
+    s_lastActive = HapticInstr_Cycles();
+    s_stateSince = s_lastActive;
+    DRV2605_SetBusHook(Power_BusHook);
+}
+
+/******************************************************************************
+ * @brief  空闲时长从最近一次总线事务算起；待机前须保证没有 ROM 效果仍在播放
+ *         （standbyMs 应大于最长效果时长）。断电前先把影子与器件对齐，
+ *         同步失败则不拉低 EN、停留在当前状态，下次空闲再试。
+ *         每次降级前由 Power_Claim 在屏蔽中断下复查空闲并先切换状态，
+ *         事务失败时退回原状态。
+ ******************************************************************************/
+void HapticPower_Idle(void) {
+    HapticPower_State from = s_state;
+    ErrorStatus status;
+
+    Power_Account();
+    if(from == HAPTIC_POWER_ACTIVE && Power_Claim(HAPTIC_POWER_STANDBY, s_config.standbyMs)) {
+        status = DRV2605_SetStandby(ENABLE);
+        s_switching = 0;
+        if(status == READY) {
+            s_stats.standbyEntries++;
+        } else {
+            Power_Enter(from);
+        }
+    }
+    from = s_state;
+    if(from != HAPTIC_POWER_OFF && Power_Claim(HAPTIC_POWER_OFF, s_config.offMs)) {
+        status = DRV2605_SyncShadow();
+        if(status == READY) {
+            GPIO_ResetBits(HAPTIC_POWER_EN_PORT, HAPTIC_POWER_EN_PIN);
+            s_stats.offEntries++;
+        }
+        s_switching = 0;
+        if(status != READY) {
+            Power_Enter(from);
+        }
+    }
+
+    s_stats.sleeps++;
+    __WFI();
+}
+
+/******************************************************************************
+ * @brief  断电唤醒后器件寄存器可能已复位，按影子整体重写后再清待机位。
+ *         失败时同样回到 ACTIVE，由调用方的事务报告错误。
+ ******************************************************************************/
+ErrorStatus HapticPower_Wake(void) {
+    HapticPower_State from = s_state;
+    u32 start = HapticInstr_Cycles();
+    ErrorStatus status = READY;
+
+    if(from == HAPTIC_POWER_ACTIVE) {
+        return READY;
+    }
+
+    s_switching = 1;
+    if(from == HAPTIC_POWER_OFF) {
+        GPIO_SetBits(HAPTIC_POWER_EN_PORT, HAPTIC_POWER_EN_PIN);
+        Delay_Us(HAPTIC_POWER_EN_SETTLE_US);
+        status = DRV2605_RestoreShadow();
+    }
+    if(status == READY) {
+        status = DRV2605_SetStandby(DISABLE);
+    }
+    s_switching = 0;
+
+    Power_Enter(HAPTIC_POWER_ACTIVE);
+    if(status == READY) {
+        HapticInstr_ProbeAdd(&s_wakeLatency[from], HapticInstr_Cycles() - start);
+    } else {
+        s_stats.wakeErrors++;
+    }
+    s_lastActive = HapticInstr_Cycles();
+    return status;
+}
+
+/******************************************************************************
+ * @brief  休眠期间 TIM2 停止计数，休眠时长按 AWU 周期计入 OFF 驻留。唤醒后
+ *         系统时钟为 HSI，HapticClock_Resume 恢复休眠前的档位；HSE 起振期间
+ *         TIM2 以 HSI 频率计数、仍按原倍率折算，这一段计时只是近似。
+ ******************************************************************************/
+ErrorStatus HapticPower_Standby(u32 ms) {
+    ErrorStatus status;
+    u32 slept;
+
+    if(ms == 0) {
+        return NoREADY;
+    }
+    Power_AwuInit();
+
+    s_switching = 1;
+    status = DRV2605_SyncShadow();
+    s_switching = 0;
+    if(status == NoREADY) {
+        return NoREADY;
+    }
+    if(s_state != HAPTIC_POWER_OFF) {
+        GPIO_ResetBits(HAPTIC_POWER_EN_PORT, HAPTIC_POWER_EN_PIN);
+        Power_Enter(HAPTIC_POWER_OFF);
+        s_stats.offEntries++;
+    }
+    Power_Account();
+    HapticLog_Flush();
+
+    while(ms != 0) {
+        slept = Power_AwuArm((ms > HAPTIC_POWER_AWU_MAX_MS) ? HAPTIC_POWER_AWU_MAX_MS : ms);
+        PWR_EnterSTANDBYMode(PWR_STANDBYEntry_WFE);
+        ms = (ms > HAPTIC_POWER_AWU_MAX_MS) ? ms - HAPTIC_POWER_AWU_MAX_MS : 0;
+        s_stats.deepMs += slept;
+        s_stats.residencyMs[HAPTIC_POWER_OFF] += slept;
+    }
+    s_deepWake = HapticInstr_Cycles();
+    PWR_AutoWakeUpCmd(DISABLE);
+    if(HapticClock_Resume() == NoREADY) {
+        s_stats.wakeErrors++;
+    }
+
+    s_stats.deepWakes++;
+    s_onsetPending = 1;
+    s_stateSince = HapticInstr_Cycles();
+    s_lastActive = s_stateSince;
+    return READY;
+}
+
+void HapticPower_NoteOnset(void) {
+    if(s_onsetPending) {
+        HapticInstr_ProbeAdd(&s_onsetLatency, HapticInstr_Cycles() - s_deepWake);
+        s_onsetPending = 0;
+    }
+}
+
+HapticPower_State HapticPower_GetState(void) {
+    return s_state;
+}
+
+const HapticPower_Stats *HapticPower_GetStats(void) {
+    Power_Account();
+    return &s_stats;
+}
+
+const HapticInstr_Probe *HapticPower_GetWakeLatency(HapticPower_State from) {
+    return &s_wakeLatency[(from < HAPTIC_POWER_STATES) ? from : HAPTIC_POWER_ACTIVE];
+}
+
+const HapticInstr_Probe *HapticPower_GetOnsetLatency(void) {
+    return &s_onsetLatency;
+}
+
+/******************************************************************************
+ * @brief  各驻留时间同步右移到总和不超过 15 位，MCU 与驱动两组乘积之和
+ *         保持在 32 位内。
+ ******************************************************************************/
+u32 HapticPower_EstimateCurrentUa(const HapticPower_CurrentModel *model) {
+    u32 active;
+    u32 standby;
+    u32 off;
+    u32 deep;
+    u32 total;
+    u32 charge;
+
+    if(model == NULL) {
+        return 0;
+    }
+    Power_Account();
+    active = s_stats.residencyMs[HAPTIC_POWER_ACTIVE];
+    standby = s_stats.residencyMs[HAPTIC_POWER_STANDBY];
+    off = s_stats.residencyMs[HAPTIC_POWER_OFF];
+    deep = s_stats.deepMs;
+    while(active + standby + off > 0x7FFF) {
+        active >>= 1;
+        standby >>= 1;
+        off >>= 1;
+        deep >>= 1;
+    }
+    total = active + standby + off;
+    if(total == 0) {
+        return 0;
+    }
+    charge = (total - deep) * model->mcuRunUa + deep * model->mcuDeepUa +
+             active * model->drvActiveUa + standby * model->drvStandbyUa + off * model->drvOffUa;
+    return charge / total;
+}
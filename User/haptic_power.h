@@ -0,0 +1,103 @@
+/******************************************************************************
+ * 文件名   : haptic_power.h
+ * 描述     : 空闲功耗管理：空闲等待时 WFI 休眠，空闲超时后依次让 DRV2605
+ *            进入软件待机（MODE bit6）与 EN 断电（PC3 拉低）；下一次总线事务
+ *            前自动唤醒，并统计唤醒延迟与各状态驻留时间。定时提醒类场合可让
+ *            MCU 进入 Standby，由 AWU 定时唤醒。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_POWER_H
+#define __HAPTIC_POWER_H
+
+#include "drv2605.h"
+#include "haptic_instr.h"
+
+#define HAPTIC_POWER_EN_PORT       GPIOC
+#define HAPTIC_POWER_EN_PIN        GPIO_Pin_3
+#define HAPTIC_POWER_EN_SETTLE_US  250   /* EN 拉高到可接受 I2C 的等待 */
+#define HAPTIC_POWER_LSI_HZ        128000
+#define HAPTIC_POWER_AWU_MAX_MS    30000 /* 单次 AWU 周期上限（61440 分频 × 63 约 30.2s） */
+
+typedef enum {
+	HAPTIC_POWER_ACTIVE  = 0,  /* 可立即播放 */
+	HAPTIC_POWER_STANDBY = 1,  /* MODE 待机位置位 */
+	HAPTIC_POWER_OFF     = 2,  /* EN 拉低 */
+	HAPTIC_POWER_STATES
+} HapticPower_State;
+
+typedef struct {
+	u16 standbyMs;  /* 空闲多久后进入待机，0 表示不进入 */
+	u16 offMs;      /* 空闲多久后拉低 EN，0 表示不断电 */
+} HapticPower_Config;
+
+typedef struct {
+	u32 residencyMs[HAPTIC_POWER_STATES];  /* 各状态累计驻留时间 */
+	u32 sleeps;                            /* WFI 次数 */
+	u16 standbyEntries;
+	u16 offEntries;
+	u16 wakeErrors;
+	u32 deepMs;                            /* MCU Standby 累计时间（计入 OFF 驻留） */
+	u16 deepWakes;
+} HapticPower_Stats;
+
+/* 平均电流估算用的典型值，单位 uA；电机驱动电流不在此列 */
+typedef struct {
+	u16 mcuRunUa;      /* MCU 运行（含 WFI） */
+	u16 mcuDeepUa;     /* MCU Standby + LSI/AWU */
+	u16 drvActiveUa;   /* DRV2605 就绪、未播放 */
+	u16 drvStandbyUa;
+	u16 drvOffUa;      /* EN 拉低 */
+} HapticPower_CurrentModel;
+
+/**
+ * @brief  记录配置并注册 DRV2605 总线钩子；器件视为已唤醒。
+ */
+void HapticPower_Init(const HapticPower_Config *cfg);
+
+/**
+ * @brief  空闲等待中调用：按空闲时长降级电源状态后执行一次 WFI。
+ * @note   仅在没有采样节拍与总线事务待处理时调用（如主机链路等待窗口）；
+ *         TIM2 溢出（48MHz 下约 1.4ms）与链路 DMA 中断都会唤醒 CPU。
+ *         进入 OFF 前先 DRV2605_SyncShadow，失败时保持 EN 为高。
+ */
+void HapticPower_Idle(void);
+
+/**
+ * @brief  立即唤醒器件（通常无需调用，总线钩子会在下一次事务前自动唤醒）。
+ * @return READY 已可播放，NoREADY 唤醒过程中总线失败。
+ */
+ErrorStatus HapticPower_Wake(void);
+
+/**
+ * @brief  MCU 进入 Standby 约 ms 毫秒，由 AWU 唤醒后恢复原时钟档位返回。
+ * @note   进入前一次突发读补全 DRV2605 影子并拉低 EN，唤醒后由下一次总线事务
+ *         一次突发写恢复。休眠期间 TIM2、串口与主机链路都停止，日志先排空。
+ * @return READY 已休眠并唤醒，NoREADY ms 为 0 或读影子失败（未休眠）。
+ */
+ErrorStatus HapticPower_Standby(u32 ms);
+
+/**
+ * @brief  Standby 唤醒后首次启动播放（GO 之后）时调用，记录唤醒到振动的耗时。
+ */
+void HapticPower_NoteOnset(void);
+
+HapticPower_State HapticPower_GetState(void);
+
+const HapticPower_Stats *HapticPower_GetStats(void);
+
+/**
+ * @brief  从待机/断电唤醒到可播放的耗时，单位周期。
+ */
+const HapticInstr_Probe *HapticPower_GetWakeLatency(HapticPower_State from);
+
+/**
+ * @brief  Standby 唤醒（WFE 返回）到 HapticPower_NoteOnset 的耗时，单位周期。
+ */
+const HapticInstr_Probe *HapticPower_GetOnsetLatency(void);
+
+/**
+ * @brief  按各状态驻留时间加权估算平均电流，单位 uA。
+ */
+u32 HapticPower_EstimateCurrentUa(const HapticPower_CurrentModel *model);
+
+#endif /* __HAPTIC_POWER_H */
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * 文件名   : haptic_resonance.c
+ * 描述     : 共振跟踪。周期以 Q8 做一阶低通（α = 1/8），偏离滤波值 1/4
+ *            以上的读数视为毛刺剔除，连续剔除 4 次则认为共振确实移动并重新起跳。
+ ******************************************************************************/
+#include "haptic_resonance.h"
+#include "haptic_instr.h"
+
+#define RESONANCE_FILTER_SHIFT   3
+#define RESONANCE_REJECT_LIMIT   4
+#define RESONANCE_PERIOD_MIN     ((u8)(DRV2605_LRA_PERIOD_HZ_NUM / HAPTIC_RESONANCE_MAX_HZ))
+#define RESONANCE_PERIOD_MAX     ((u8)(DRV2605_LRA_PERIOD_HZ_NUM / HAPTIC_RESONANCE_MIN_HZ))
+
+static u16 s_periodQ8;        /* 滤波后的周期，Q8，0 表示未知 */
+static u16 s_hz;
+static u8 s_version;
+static u8 s_rejectRun;
+static u32 s_intervalCycles;
+static u32 s_lastPoll;
+static HapticResonance_Stats s_stats;
+
+/* 滤波值变化后同步到驱动层，频率换算的除法只在这里发生 */
+static void Resonance_Apply(void) {
+    u16 hz = (u16)((DRV2605_LRA_PERIOD_HZ_NUM * 256UL + s_periodQ8 / 2U) / s_periodQ8);
+    u8 period = (u8)((s_periodQ8 + 0x80U) >> 8);
+
+    DRV2605_SetResonance(period, hz);
+    if(hz != s_hz) {
+        s_hz = hz;
+        s_version++;
+    }
+}
+
+/******************************************************************************
+ * @brief  复位跟踪器。
+ ******************************************************************************/
+void HapticResonance_Init(u8 seedPeriod) {
+    s_periodQ8 = 0;
+    s_hz = 0;
+    s_rejectRun = 0;
+    s_stats.samples = 0;
+    s_stats.rejected = 0;
+    s_stats.lastRaw = 0;
+    s_intervalCycles = (u32)HAPTIC_RESONANCE_INTERVAL_MS * 1000UL * HapticInstr_CyclesPerUs();
+    s_lastPoll = HapticInstr_Cycles();
+    if(seedPeriod >= RESONANCE_PERIOD_MIN && seedPeriod <= RESONANCE_PERIOD_MAX) {
+        s_periodQ8 = (u16)seedPeriod << 8;
+        Resonance_Apply();
+    }
+}
+
+void HapticResonance_SetInterval(u16 intervalMs) {
+    s_intervalCycles = (u32)((intervalMs == 0) ? 1 : intervalMs) * 1000UL * HapticInstr_CyclesPerUs();
+}
+
+/******************************************************************************
+ * @brief  读取 LRARESON 并滤波。
+ ******************************************************************************/
+ErrorStatus HapticResonance_Sample(void) {
+    u8 raw;
+    u16 rawQ8;
+    u16 deviation;
+
+    if(DRV2605_ReadLraResonance(&raw) == NoREADY) {
+        return NoREADY;
+    }
+    s_stats.lastRaw = raw;
+    if(raw < RESONANCE_PERIOD_MIN || raw > RESONANCE_PERIOD_MAX) {
+        s_stats.rejected++;
+        return NoREADY;
+    }
+
+    rawQ8 = (u16)raw << 8;
+    if(s_periodQ8 == 0) {
+        s_periodQ8 = rawQ8;
+    } else {
+        deviation = (rawQ8 > s_periodQ8) ? rawQ8 - s_periodQ8 : s_periodQ8 - rawQ8;
+        if(deviation > (s_periodQ8 >> 2) && ++s_rejectRun < RESONANCE_REJECT_LIMIT) {
+            s_stats.rejected++;
+            return NoREADY;
+        }
+        if(s_rejectRun >= RESONANCE_REJECT_LIMIT) {
+            s_periodQ8 = rawQ8;
+        } else {
+            s_periodQ8 = (u16)((s32)s_periodQ8 + (((s32)rawQ8 - (s32)s_periodQ8) >> RESONANCE_FILTER_SHIFT));
+        }
+    }
+    s_rejectRun = 0;
+    s_stats.samples++;
+    Resonance_Apply();
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  按间隔采样；只在 LRA 闭环（FEEDBACK bit7 = 1、CONTROL3 bit0 = 0）时读取。
+ ******************************************************************************/
+void HapticResonance_Poll(void) {
+    u32 now = HapticInstr_Cycles();
+    u8 feedback;
+    u8 control3;
+
+    if(now - s_lastPoll < s_intervalCycles) {
+        return;
+    }
+    s_lastPoll = now;
+
+    if(DRV2605_GetShadowRegister(DRV2605_REG_FEEDBACK, &feedback) == NoREADY || (feedback & 0x80) == 0) {
+        return;
+    }
+    if(DRV2605_GetShadowRegister(DRV2605_REG_CONTROL3, &control3) == READY && (control3 & 0x01) != 0) {
+        return;
+    }
+    HapticResonance_Sample();
+}
+
+u16 HapticResonance_Hz(void) {
+    return s_hz;
+}
+
+u8 HapticResonance_Version(void) {
+    return s_version;
+}
+
+const HapticResonance_Stats *HapticResonance_GetStats(void) {
+    return &s_stats;
+}
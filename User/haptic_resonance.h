@@ -0,0 +1,61 @@
+/******************************************************************************
+ * 文件名   : haptic_resonance.h
+ * 描述     : LRA 共振跟踪：闭环播放期间周期性读取 LRARESON，滤波后
+ *            同步到开环驱动周期、频率直驱与合成器频率。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_RESONANCE_H
+#define __HAPTIC_RESONANCE_H
+
+#include "drv2605.h"
+
+#define HAPTIC_RESONANCE_INTERVAL_MS   50    /* 默认采样间隔 */
+#define HAPTIC_RESONANCE_MIN_HZ        80    /* 合理范围，超出视为无效读数 */
+#define HAPTIC_RESONANCE_MAX_HZ        400
+
+/* 跟踪统计 */
+typedef struct {
+	u32 samples;   /* 接受的读数 */
+	u32 rejected;  /* 越界或跳变过大的读数 */
+	u8 lastRaw;    /* 最近一次原始读数 */
+} HapticResonance_Stats;
+
+/**
+ * @brief  复位跟踪器。
+ * @param  seedPeriod 初始周期（如自动校准结果 lraResonance），0 表示未知。
+ */
+void HapticResonance_Init(u8 seedPeriod);
+
+/**
+ * @brief  设置采样间隔（ms）。
+ */
+void HapticResonance_SetInterval(u16 intervalMs);
+
+/**
+ * @brief  到达采样间隔且器件处于 LRA 闭环时读取一次；在播放循环中调用。
+ * @note   只有 GO 有效、闭环驱动时 LRARESON 才是实测值，调用方需在播放中调用。
+ */
+void HapticResonance_Poll(void);
+
+/**
+ * @brief  立即读取一次并更新滤波值。
+ * @return READY 读数被接受，NoREADY 读失败或被剔除。
+ */
+ErrorStatus HapticResonance_Sample(void);
+
+/**
+ * @brief  滤波后的共振频率（Hz），未知时为 0。
+ */
+u16 HapticResonance_Hz(void);
+
+/**
+ * @brief  滤波值每次变化（1Hz 粒度）时递增，供样本源判断是否需要重新调谐。
+ */
+u8 HapticResonance_Version(void);
+
+/**
+ * @brief  获取跟踪统计。
+ */
+const HapticResonance_Stats *HapticResonance_GetStats(void);
+
+#endif /* __HAPTIC_RESONANCE_H */
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * 文件名   : haptic_rtp.c
+ * 描述     : RTP 采样流输出，以 TIM2 周期时间戳做节拍。
+ ******************************************************************************/
+#include "haptic_rtp.h"
+#include "haptic_instr.h"
+#include "haptic_resonance.h"
+#include "haptic_vbat.h"
+#include "haptic_swar.h"
+
+static HapticRtp_Stats s_stats;
+static HapticRtp_Suppress s_suppress = { ENABLE, 0, 100 };
+static u16 s_sinceWrite;  /* 距上次真正写出的样本数 */
+static HapticThermal *s_thermal;
+#if HAPTIC_USE_KICK
+static HapticKick *s_kick;
+#endif
+static HapticRtp_Idle s_idle;
+
+/******************************************************************************
+ * @brief  准备 RTP 输出。
+ ******************************************************************************/
+ErrorStatus HapticRtp_Begin(void) {
+    if(DRV2605_PrepareFreqAmpRealtime() == NoREADY) {
+        return NoREADY;
+    }
+    return DRV2605_Start();
+}
+
+/******************************************************************************
+ * @brief  写一个 RTP 样本；与影子中的 RTPIN 相同或相差不超过阈值时省略。
+ ******************************************************************************/
+ErrorStatus HapticRtp_Write(u8 value) {
+    u8 last;
+
+    if(s_suppress.enable == ENABLE &&
+       DRV2605_GetShadowRegister(DRV2605_REG_RTPIN, &last) == READY) {
+        u8 delta = (u8)((value > last) ? value - last : last - value);
+        if(delta == 0 || (value != 0 && delta <= s_suppress.threshold)) {
+            if(s_suppress.refreshSamples == 0 || s_sinceWrite < s_suppress.refreshSamples) {
+                s_sinceWrite++;
+                s_stats.samples++;
+                s_stats.suppressed++;
+                s_stats.busBytesSaved += HAPTIC_RTP_WRITE_BYTES;
+                return READY;
+            }
+            s_stats.refreshes++;
+        }
+    }
+
+    if(DRV2605_SetRealtimeValue(value) == NoREADY) {
+        s_stats.errors++;
+        return NoREADY;
+    }
+    s_sinceWrite = 0;
+    s_stats.samples++;
+    return READY;
+}
+
+void HapticRtp_SetSuppress(const HapticRtp_Suppress *cfg) {
+    if(cfg != NULL) {
+        s_suppress = *cfg;
+        s_sinceWrite = 0;
+    }
+}
+
+void HapticRtp_SetThermal(HapticThermal *thermal) {
+    s_thermal = thermal;
+}
+
+HapticThermal *HapticRtp_GetThermal(void) {
+    return s_thermal;
+}
+
+#if HAPTIC_USE_KICK
+void HapticRtp_SetKick(HapticKick *kick) {
+    s_kick = kick;
+}
+#endif
+
+void HapticRtp_SetIdle(HapticRtp_Idle idle) {
+    s_idle = idle;
+}
+
+/* 按采样周期逐个写出；落后超过一个周期时重新对齐 */
+static void Rtp_WriteTimed(const u8 *samples, u16 count, u32 *deadline, u32 period) {
+    for(u16 i = 0; i < count; i++) {
+        while((s32)(HapticInstr_Cycles() - *deadline) < 0) {
+            if(s_idle != NULL) {
+                s_idle();
+            }
+        }
+        HapticRtp_Write(samples[i]);
+        *deadline += period;
+        if((s32)(HapticInstr_Cycles() - *deadline) > (s32)period) {
+            s_stats.late++;
+            *deadline = HapticInstr_Cycles();
+        }
+    }
+}
+
+ErrorStatus HapticRtp_Play(HapticRtp_Source source, void *ctx) {
+    return HapticRtp_PlayRate(source, ctx, HAPTIC_RTP_SAMPLE_HZ);
+}
+
+/******************************************************************************
+ * @brief  按块拉取样本，乘以电源补偿与热降额增益、叠加过驱/刹车后
+ *         按采样周期写出。块间空隙用于共振/VBAT 的低频采样与热预算结算
+ *         （按最终输出幅值计入，过驱同样消耗预算）。
+ ******************************************************************************/
+ErrorStatus HapticRtp_PlayRate(HapticRtp_Source source, void *ctx, u16 sampleHz) {
+    HapticRtp_Block block;
+    u32 period;
+    u32 deadline;
+    u16 count;
+    u16 gain;
+
+    if(source == NULL) {
+        return NoREADY;
+    }
+    if(HapticRtp_Begin() == NoREADY) {
+        return NoREADY;
+    }
+
+    if(sampleHz == 0) {
+        sampleHz = HAPTIC_RTP_SAMPLE_HZ;
+    }
+    period = HapticInstr_CyclesPerUs() * 1000000UL / sampleHz;
+#if HAPTIC_USE_KICK
+    HapticKick_Reset(s_kick, sampleHz);
+#endif
+    deadline = HapticInstr_Cycles();
+    while((count = source(ctx, block.samples, HAPTIC_RTP_BLOCK)) != 0) {
+#if HAPTIC_USE_SUPPLY
+        HapticResonance_Poll();
+        HapticVbat_Poll();
+#endif
+        HapticThermal_Update(s_thermal);
+        gain = (u16)((DRV2605_GetSupplyGain() * HapticThermal_Gain(s_thermal)) >> 7);
+        HapticSwar_Gain(block.samples, count, (u8)((gain > 0xFF) ? 0xFF : gain));
+#if HAPTIC_USE_KICK
+        HapticKick_Block(s_kick, block.samples, count);
+#endif
+        HapticThermal_AccountSamples(s_thermal, block.samples, count, sampleHz);
+        Rtp_WriteTimed(block.samples, count, &deadline, period);
+    }
+
+#if HAPTIC_USE_KICK
+    count = HapticKick_Flush(s_kick, block.samples, HAPTIC_RTP_BLOCK);
+    Rtp_WriteTimed(block.samples, count, &deadline, period);
+#endif
+
+    return HapticRtp_Write(0x00);
+}
+
+const HapticRtp_Stats *HapticRtp_GetStats(void) {
+    return &s_stats;
+}
+
+void HapticRtp_ResetStats(void) {
+    s_stats.samples = 0;
+    s_stats.late = 0;
+    s_stats.errors = 0;
+    s_stats.suppressed = 0;
+    s_stats.refreshes = 0;
+    s_stats.busBytesSaved = 0;
+}
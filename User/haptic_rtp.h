@@ -0,0 +1,123 @@
+/******************************************************************************
+ * 文件名   : haptic_rtp.h
+ * 描述     : RTP 采样流输出：按固定采样率把样本源写入 RTPIN。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_RTP_H
+#define __HAPTIC_RTP_H
+
+#include "drv2605.h"
+#include "haptic_config.h"
+#include "haptic_thermal.h"
+#include "haptic_kick.h"
+
+#define HAPTIC_RTP_SAMPLE_HZ    1000   /* RTP 输出采样率 */
+#define HAPTIC_RTP_BLOCK        16     /* 样本源每次填充的块长度 */
+#define HAPTIC_RTP_WRITE_BYTES  3      /* 一次 RTPIN 写的总线字节：地址 + 寄存器 + 数据 */
+
+/**
+ * @brief  样本源回调：向 samples 填充最多 count 个 RTP 值（0x00~0x7F）。
+ * @return 实际填充的数量，返回 0 表示播放结束。
+ */
+typedef u16 (*HapticRtp_Source)(void *ctx, u8 *samples, u16 count);
+
+/**
+ * @brief  等待下一个采样节拍时反复调用的空闲回调（如接收主机数据）。
+ * @note   单次执行应远小于一个采样周期，否则记为迟到。
+ */
+typedef void (*HapticRtp_Idle)(void);
+
+/* 字对齐的样本块，供 SWAR 核按 32 位字处理 */
+typedef union {
+	u32 words[HAPTIC_RTP_BLOCK / 4];
+	u8 samples[HAPTIC_RTP_BLOCK];
+} HapticRtp_Block;
+
+/* 输出统计 */
+typedef struct {
+	u32 samples;        /* 已输出样本数（含被省略的） */
+	u32 late;           /* 错过节拍的样本数 */
+	u32 errors;         /* I2C 写失败次数 */
+	u32 suppressed;     /* 因与 RTPIN 当前值相同/相近而省略的写 */
+	u32 refreshes;      /* 到达刷新间隔而强制重写的次数 */
+	u32 busBytesSaved;  /* 省下的总线字节数 */
+} HapticRtp_Stats;
+
+/* 差值抑制：与最近写入 RTPIN 的值（驱动影子寄存器）比较 */
+typedef struct {
+	FunctionalState enable;
+	u8 threshold;        /* 变化 ≤ threshold 视为不可感知，0 表示只省略相同值 */
+	u16 refreshSamples;  /* 连续省略这么多样本后强制重写一次，0 表示不强制 */
+} HapticRtp_Suppress;
+
+/**
+ * @brief  进入 LRA + RTP 模式并置 GO，准备流式输出。
+ * @return READY 成功，NoREADY 失败。
+ */
+ErrorStatus HapticRtp_Begin(void);
+
+/**
+ * @brief  阻塞播放一个样本源直至其返回 0，结束后 RTPIN 归零。
+ * @note   样本按 DRV2605_GetSupplyGain() 做电源补偿。
+ * @param  source 样本源回调。
+ * @param  ctx    回调上下文。
+ * @return READY 成功，NoREADY 参数非法或准备失败。
+ */
+ErrorStatus HapticRtp_Play(HapticRtp_Source source, void *ctx);
+
+/**
+ * @brief  同 HapticRtp_Play，但按指定采样率输出（主机流等非 1kHz 内容）。
+ * @note   热预算计入量与过驱/刹车脉冲长度都按 sampleHz 换算，
+ *         与采样率无关。
+ * @param  sampleHz 采样率，0 视为 HAPTIC_RTP_SAMPLE_HZ。
+ */
+ErrorStatus HapticRtp_PlayRate(HapticRtp_Source source, void *ctx, u16 sampleHz);
+
+/**
+ * @brief  设置节拍等待期间的空闲回调，NULL 清除。
+ */
+void HapticRtp_SetIdle(HapticRtp_Idle idle);
+
+/**
+ * @brief  立即输出一个样本（不做节拍等待），经过差值抑制。
+ * @note   归零总是写出，避免阈值把残余振动留在 RTPIN。
+ * @param  value RTP 值。
+ * @return READY 成功或已省略，NoREADY 写入失败。
+ */
+ErrorStatus HapticRtp_Write(u8 value);
+
+/**
+ * @brief  配置差值抑制；默认开启，阈值 0，每 100 个样本强制刷新。
+ */
+void HapticRtp_SetSuppress(const HapticRtp_Suppress *cfg);
+
+/**
+ * @brief  绑定热预算：播放时按其增益降额，并把实际输出计入预算。
+ * @param  thermal 预算状态，NULL 解除绑定。
+ */
+void HapticRtp_SetThermal(HapticThermal *thermal);
+
+/**
+ * @brief  当前绑定的热预算，供 ROM 效果触发路径计入；未绑定时为 NULL。
+ */
+HapticThermal *HapticRtp_GetThermal(void);
+
+#if HAPTIC_USE_KICK
+/**
+ * @brief  绑定过驱/刹车后处理：在增益之后处理每块样本，流结束时补收尾刹车。
+ * @param  kick 处理器状态（已 HapticKick_Init），NULL 解除绑定。
+ */
+void HapticRtp_SetKick(HapticKick *kick);
+#endif
+
+/**
+ * @brief  获取输出统计。
+ */
+const HapticRtp_Stats *HapticRtp_GetStats(void);
+
+/**
+ * @brief  清零输出统计。
+ */
+void HapticRtp_ResetStats(void);
+
+#endif /* __HAPTIC_RTP_H */
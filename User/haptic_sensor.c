@@ -0,0 +1,191 @@
+/******************************************************************************
+ * 文件名   : haptic_sensor.c
+ * 描述     : 看门狗窗口随状态切换：松开时为 [0, pressLevel]，按下时为
+ *            [releaseLevel, 满量程]；越出窗口即中断，先换门限再清标志。
+ ******************************************************************************/
+#include "haptic_sensor.h"
+#include "haptic_config.h"
+#include "haptic_power.h"
+#include "haptic_rtp.h"
+
+/* 未选用传感器时 ADC1 中断与其余代码一起去掉 */
+#if HAPTIC_USE_SENSOR
+
+#define SENSOR_MSTATUS_MIE  0x00000008UL
+
+void ADC1_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+
+/* A0~A7 所在引脚 */
+static GPIO_TypeDef *const s_channelPort[8] = {
+    GPIOA, GPIOA, GPIOC, GPIOD, GPIOD, GPIOD, GPIOD, GPIOD
+};
+static const u16 s_channelPin[8] = {
+    GPIO_Pin_2, GPIO_Pin_1, GPIO_Pin_4, GPIO_Pin_2, GPIO_Pin_3, GPIO_Pin_5, GPIO_Pin_6, GPIO_Pin_4
+};
+
+static HapticSensor_Config s_config;
+static volatile u8 s_pressed;
+static volatile DRV2605_Effect s_pending;   /* 0 表示无待处理 */
+static volatile u32 s_pendingAt;
+static HapticSensor_Stats s_stats;
+static HapticInstr_Probe s_fastLatency;
+static HapticInstr_Probe s_deferredLatency;
+
+static void Sensor_Window(u8 pressed) {
+    if(pressed) {
+        ADC_AnalogWatchdogThresholdsConfig(ADC1, HAPTIC_SENSOR_FULL_SCALE, s_config.releaseLevel);
+    } else {
+        ADC_AnalogWatchdogThresholdsConfig(ADC1, s_config.pressLevel, 0);
+    }
+}
+
+/******************************************************************************
+ * @brief  引脚设为模拟输入；校准后开启连续转换，看门狗只监视该通道。
+ ******************************************************************************/
+void HapticSensor_Init(const HapticSensor_Config *cfg) {
+    GPIO_InitTypeDef gpio = {0};
+    ADC_InitTypeDef adc = {0};
+
+    if(cfg == NULL || cfg->channel > ADC_Channel_7 || cfg->releaseLevel >= cfg->pressLevel) {
+        return;
+    }
+    s_config = *cfg;
+    s_pressed = 0;
+    s_pending = (DRV2605_Effect)0;
+    s_stats.presses = 0;
+    s_stats.releases = 0;
+    s_stats.fast = 0;
+    s_stats.deferred = 0;
+    HapticInstr_ProbeReset(&s_fastLatency);
+    HapticInstr_ProbeReset(&s_deferredLatency);
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOC | RCC_APB2Periph_GPIOD |
+                           RCC_APB2Periph_ADC1, ENABLE);
+    RCC_ADCCLKConfig(RCC_PCLK2_Div4);
+    gpio.GPIO_Pin = s_channelPin[cfg->channel];
+    gpio.GPIO_Mode = GPIO_Mode_AIN;
+    GPIO_Init(s_channelPort[cfg->channel], &gpio);
+
+    ADC_DeInit(ADC1);
+    adc.ADC_Mode = ADC_Mode_Independent;
+    adc.ADC_ScanConvMode = DISABLE;
+    adc.ADC_ContinuousConvMode = ENABLE;
+    adc.ADC_ExternalTrigConv = ADC_ExternalTrigConv_None;
+    adc.ADC_DataAlign = ADC_DataAlign_Right;
+    adc.ADC_NbrOfChannel = 1;
+    ADC_Init(ADC1, &adc);
+    ADC_RegularChannelConfig(ADC1, cfg->channel, 1, HAPTIC_SENSOR_SAMPLE_TIME);
+
+    ADC_Cmd(ADC1, ENABLE);
+    ADC_ResetCalibration(ADC1);
+    while(ADC_GetResetCalibrationStatus(ADC1) != RESET) {
+    }
+    ADC_StartCalibration(ADC1);
+    while(ADC_GetCalibrationStatus(ADC1) != RESET) {
+    }
+
+    Sensor_Window(0);
+    ADC_AnalogWatchdogSingleChannelConfig(ADC1, cfg->channel);
+    ADC_AnalogWatchdogCmd(ADC1, ADC_AnalogWatchdog_SingleRegEnable);
+    ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);
+    ADC_ITConfig(ADC1, ADC_IT_AWD, ENABLE);
+    NVIC_EnableIRQ(ADC_IRQn);
+    ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+}
+
+/******************************************************************************
+ * @brief  恢复时回到松开状态，由第一次转换重新判定。
+ ******************************************************************************/
+void HapticSensor_Cmd(FunctionalState state) {
+    if(state == DISABLE) {
+        ADC_Cmd(ADC1, DISABLE);
+        return;
+    }
+    s_pressed = 0;
+    Sensor_Window(0);
+    ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);
+    ADC_Cmd(ADC1, ENABLE);
+    ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+}
+
+u8 HapticSensor_Poll(void) {
+    u32 mstatus = __get_MSTATUS();
+    DRV2605_Effect effect;
+    u32 edgeAt;
+
+    __set_MSTATUS(mstatus & ~SENSOR_MSTATUS_MIE);
+    effect = s_pending;
+    edgeAt = s_pendingAt;
+    s_pending = (DRV2605_Effect)0;
+    __set_MSTATUS(mstatus);
+    if(effect == (DRV2605_Effect)0) {
+        return 0;
+    }
+
+    if(DRV2605_StageRomSequence(DRV2605_LIBRARY_LRA, &effect, 1) == READY &&
+       DRV2605_CommitRomTransition() == READY) {
+        HapticInstr_ProbeAdd(&s_deferredLatency, HapticInstr_Cycles() - edgeAt);
+        HapticThermal_Update(HapticRtp_GetThermal());
+        HapticThermal_AccountRom(HapticRtp_GetThermal(), effect);
+    }
+    return 1;
+}
+
+u16 HapticSensor_Read(void) {
+    return ADC_GetConversionValue(ADC1);
+}
+
+const HapticSensor_Stats *HapticSensor_GetStats(void) {
+    return &s_stats;
+}
+
+const HapticInstr_Probe *HapticSensor_GetFastLatency(void) {
+    return &s_fastLatency;
+}
+
+const HapticInstr_Probe *HapticSensor_GetDeferredLatency(void) {
+    return &s_deferredLatency;
+}
+
+/*********************************************************************
+ * @fn      ADC1_IRQHandler
+ *
+ * @brief   模拟看门狗：翻转按下状态并换窗口，再触发对应效果；器件未就绪或
+ *          总线被占用时交给 HapticSensor_Poll。
+ *
+ * @return  none
+ */
+void ADC1_IRQHandler(void) {
+    u32 now = HapticInstr_Cycles();
+    DRV2605_Effect effect;
+
+    if(ADC_GetITStatus(ADC1, ADC_IT_AWD) == RESET) {
+        return;
+    }
+    s_pressed = !s_pressed;
+    Sensor_Window(s_pressed);
+    ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);
+
+    if(s_pressed) {
+        s_stats.presses++;
+        effect = s_config.pressEffect;
+    } else {
+        s_stats.releases++;
+        effect = s_config.releaseEffect;
+    }
+    if(effect == (DRV2605_Effect)0) {
+        return;
+    }
+
+    if(HapticPower_GetState() == HAPTIC_POWER_ACTIVE && DRV2605_FireFromIsr(effect) == READY) {
+        HapticThermal_QueueRom(HapticRtp_GetThermal(), effect);
+        s_stats.fast++;
+        HapticInstr_ProbeAdd(&s_fastLatency, HapticInstr_Cycles() - now);
+        return;
+    }
+    s_pending = effect;
+    s_pendingAt = now;
+    s_stats.deferred++;
+}
+
+#endif /* HAPTIC_USE_SENSOR */
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * 文件名   : haptic_sensor.h
+ * 描述     : 力/压力传感器触发：ADC 单通道连续转换，由模拟看门狗在越过门限
+ *            时产生中断触发 ROM 效果，中断内切换门限实现迟滞重装；主循环
+ *            不读 ADC，等待期间 CPU 可一直 WFI。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_SENSOR_H
+#define __HAPTIC_SENSOR_H
+
+#include "drv2605.h"
+#include "haptic_instr.h"
+
+#define HAPTIC_SENSOR_FULL_SCALE   0x3FF                   /* 10 位 ADC */
+#define HAPTIC_SENSOR_SAMPLE_TIME  ADC_SampleTime_73Cycles /* ADCCLK 12MHz 下每次转换约 7us */
+
+typedef struct {
+	u8 channel;                    /* ADC_Channel_0~7（A0~A7） */
+	u16 pressLevel;                /* 高于此值视为按下 */
+	u16 releaseLevel;              /* 低于此值视为松开，须小于 pressLevel */
+	DRV2605_Effect pressEffect;    /* LRA 库 ROM 效果 */
+	DRV2605_Effect releaseEffect;  /* 0 表示松开时不振 */
+} HapticSensor_Config;
+
+typedef struct {
+	u16 presses;
+	u16 releases;
+	u16 fast;       /* 中断内直接 GO */
+	u16 deferred;   /* 转主循环播放 */
+} HapticSensor_Stats;
+
+/**
+ * @brief  配置通道引脚、ADC 连续转换与模拟看门狗，按松开状态装入按下门限并启动。
+ * @note   ADCCLK = PCLK2/4，随 HapticClock 切换按比例变慢，门限不受影响。
+ */
+void HapticSensor_Init(const HapticSensor_Config *cfg);
+
+/**
+ * @brief  停止/恢复转换（停止后 ADC 断电，不再触发）。
+ */
+void HapticSensor_Cmd(FunctionalState state);
+
+/**
+ * @brief  主循环调用：播放中断未能直接触发的效果。
+ * @return 1 本次播放了一项，0 无待处理。
+ */
+u8 HapticSensor_Poll(void);
+
+/**
+ * @brief  最近一次转换结果（仅用于调试输出）。
+ */
+u16 HapticSensor_Read(void);
+
+const HapticSensor_Stats *HapticSensor_GetStats(void);
+
+/**
+ * @brief  看门狗中断入口到 GO 完成的耗时，单位周期（不含约一次转换的检测延迟）。
+ */
+const HapticInstr_Probe *HapticSensor_GetFastLatency(void);
+
+/**
+ * @brief  看门狗中断入口到主循环 GO 的耗时，单位周期。
+ */
+const HapticInstr_Probe *HapticSensor_GetDeferredLatency(void);
+
+#endif /* __HAPTIC_SENSOR_H */
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * 文件名   : haptic_swar.c
+ * 描述     : SWAR 字节核。RV32EC 没有 SIMD 与硬件乘法，按字处理把
+ *            访存、分支和 libgcc 乘法次数都降到逐样本循环的 1/2~1/4。
+ ******************************************************************************/
+#include "haptic_swar.h"
+
+#define SWAR_ONES      0x01010101UL
+#define SWAR_HIGH      0x80808080UL
+#define SWAR_LOW7      0x7F7F7F7FUL
+#define SWAR_EVEN      0x00FF00FFUL
+
+/* 允许与 u8 缓冲区别名访问 */
+typedef u32 __attribute__((may_alias)) Swar_Word;
+
+#define SWAR_ALIGNED(p)   ((((size_t)(p)) & 3U) == 0)
+
+/* 最高位置位的字节 → 0x7F，其余保留低 7 位 */
+static inline u32 Swar_Clamp7Word(u32 w) {
+    u32 over = w & SWAR_HIGH;
+    return (w | (over - (over >> 7))) & SWAR_LOW7;
+}
+
+/* 16 位通道内 x·gain ≤ 127·255，不会溢出到相邻通道 */
+static inline u32 Swar_GainWord(u32 w, u8 gain) {
+    u32 even = (((w & SWAR_EVEN) * gain) >> 7) & SWAR_EVEN;
+    u32 odd = ((((w >> 8) & SWAR_EVEN) * gain) >> 7) & SWAR_EVEN;
+    return even | (odd << 8);
+}
+
+/* 每字节最高位 → 4 位掩码 */
+static inline u32 Swar_PackHigh(u32 flags) {
+    flags >>= 7;
+    return (flags | (flags >> 7) | (flags >> 14) | (flags >> 21)) & 0x0F;
+}
+
+static inline u8 Swar_Abs(u8 a, u8 b) {
+    return (u8)((a > b) ? a - b : b - a);
+}
+
+/******************************************************************************
+ * @brief  填充。
+ ******************************************************************************/
+void HapticSwar_Fill(u8 *samples, u8 value, u16 count) {
+    u32 word = value | ((u32)value << 8);
+    word |= word << 16;
+
+    while(count && !SWAR_ALIGNED(samples)) {
+        *samples++ = value;
+        count--;
+    }
+    for(; count >= 4; count -= 4, samples += 4) {
+        *(Swar_Word *)samples = word;
+    }
+    while(count--) {
+        *samples++ = value;
+    }
+}
+
+/******************************************************************************
+ * @brief  增益。
+ ******************************************************************************/
+void HapticSwar_Gain(u8 *samples, u16 count, u8 gain) {
+    u8 clamp = (gain > 128);
+
+    if(gain == 128) {
+        return;
+    }
+    if(gain == 0) {
+        HapticSwar_Fill(samples, 0, count);
+        return;
+    }
+
+    while(count && !SWAR_ALIGNED(samples)) {
+        u16 v = (u16)((*samples * gain) >> 7);
+        *samples++ = (u8)((v > 0x7F) ? 0x7F : v);
+        count--;
+    }
+    for(; count >= 4; count -= 4, samples += 4) {
+        u32 w = Swar_GainWord(*(Swar_Word *)samples, gain);
+        *(Swar_Word *)samples = clamp ? Swar_Clamp7Word(w) : w;
+    }
+    while(count--) {
+        u16 v = (u16)((*samples * gain) >> 7);
+        *samples++ = (u8)((v > 0x7F) ? 0x7F : v);
+    }
+}
+
+/******************************************************************************
+ * @brief  饱和加：两个 ≤0x7F 的字节相加 ≤0xFE，不会进位到相邻字节。
+ ******************************************************************************/
+u16 HapticSwar_SatAdd(u8 *dst, const u8 *src, u16 count) {
+    u16 clipped = 0;
+
+    if(((size_t)dst & 3U) == ((size_t)src & 3U)) {
+        while(count && !SWAR_ALIGNED(dst)) {
+            u8 v = (u8)(*dst + *src++);
+            if(v > 0x7F) {
+                v = 0x7F;
+                clipped++;
+            }
+            *dst++ = v;
+            count--;
+        }
+        for(; count >= 4; count -= 4, dst += 4, src += 4) {
+            u32 sum = *(Swar_Word *)dst + *(const Swar_Word *)src;
+            u32 over = sum & SWAR_HIGH;
+            if(over) {
+                over >>= 7;
+                over += over >> 16;
+                over += over >> 8;
+                clipped += (u16)(over & 0x07);
+                sum = Swar_Clamp7Word(sum);
+            }
+            *(Swar_Word *)dst = sum;
+        }
+    }
+    while(count--) {
+        u8 v = (u8)(*dst + *src++);
+        if(v > 0x7F) {
+            v = 0x7F;
+            clipped++;
+        }
+        *dst++ = v;
+    }
+    return clipped;
+}
+
+/******************************************************************************
+ * @brief  钳位到 0x7F。
+ ******************************************************************************/
+void HapticSwar_Clamp7(u8 *samples, u16 count) {
+    while(count && !SWAR_ALIGNED(samples)) {
+        if(*samples > 0x7F) {
+            *samples = 0x7F;
+        }
+        samples++;
+        count--;
+    }
+    for(; count >= 4; count -= 4, samples += 4) {
+        *(Swar_Word *)samples = Swar_Clamp7Word(*(Swar_Word *)samples);
+    }
+    while(count--) {
+        if(*samples > 0x7F) {
+            *samples = 0x7F;
+        }
+        samples++;
+    }
+}
+
+/******************************************************************************
+ * @brief  差值检测。每字节 |cur - prev| 由两次带 0x80 偏置的减法得到，
+ *         再加 (0x7F - threshold) 看最高位是否进位。
+ ******************************************************************************/
+u32 HapticSwar_ChangedMask(const u8 *samples, u16 count, u8 previous, u8 threshold) {
+    u32 mask = 0;
+    u16 i = 0;
+    u32 bias;
+
+    if(count > 32) {
+        count = 32;
+    }
+    if(threshold > 0x7F) {
+        threshold = 0x7F;
+    }
+    bias = (u32)(0x7F - threshold) * SWAR_ONES;
+
+    /* 未对齐的头部与不足一字的尾部共用逐字节分支 */
+    while(i < count) {
+        if(i + 4 <= count && SWAR_ALIGNED(samples + i)) {
+            u32 cur = *(const Swar_Word *)(samples + i);
+            u32 prev = (cur << 8) | previous;
+            u32 up = (cur | SWAR_HIGH) - prev;
+            u32 down = (prev | SWAR_HIGH) - cur;
+            u32 ge = up & SWAR_HIGH;
+            u32 full = ge | (ge - (ge >> 7));
+            u32 diff = ((up & full) | (down & ~full)) & SWAR_LOW7;
+            mask |= Swar_PackHigh((diff + bias) & SWAR_HIGH) << i;
+            previous = (u8)(cur >> 24);
+            i += 4;
+        } else {
+            if(Swar_Abs(samples[i], previous) > threshold) {
+                mask |= 1UL << i;
+            }
+            previous = samples[i++];
+        }
+    }
+    return mask;
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * 文件名   : haptic_swar.h
+ * 描述     : 寄存器内 SIMD（SWAR）字节核：一个 32 位字并行处理 4 个 RTP 样本。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_SWAR_H
+#define __HAPTIC_SWAR_H
+
+#ifdef HAPTIC_SWAR_HOST
+#include <stdint.h>
+#include <stddef.h>
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+#else
+#include "debug.h"
+#endif
+
+/*
+ * 所有核都接受任意对齐的缓冲区：未对齐的头尾逐字节处理，中间按字处理。
+ * 除 HapticSwar_Fill 外，输入样本须在 RTP 范围 0x00~0x7F 内，
+ * 这样每个字节的最高位可作为进位/比较标志，字节之间不会互相借位。
+ */
+
+/**
+ * @brief  用同一电平填充 count 个样本。
+ */
+void HapticSwar_Fill(u8 *samples, u8 value, u16 count);
+
+/**
+ * @brief  样本乘以增益 gain/128，结果饱和到 0x7F。
+ * @note   奇偶字节拆到两个 16 位通道，每字两次 8 位乘法（逐样本为四次）。
+ */
+void HapticSwar_Gain(u8 *samples, u16 count, u8 gain);
+
+/**
+ * @brief  dst[i] = min(dst[i] + src[i], 0x7F)。
+ * @note   dst 与 src 对齐方式不同时退化为逐字节。
+ * @return 饱和的样本数。
+ */
+u16 HapticSwar_SatAdd(u8 *dst, const u8 *src, u16 count);
+
+/**
+ * @brief  把 0x00~0xFF 的样本钳位到 0x7F。
+ */
+void HapticSwar_Clamp7(u8 *samples, u16 count);
+
+/**
+ * @brief  差值检测：bit i 置位表示 |samples[i] - samples[i-1]| > threshold。
+ * @note   比较的是相邻样本，不是 RTPIN 影子值：阈值非 0 时，一串小台阶的
+ *         慢斜坡每步都不置位，累计偏差却会超过阈值，所以不能代替
+ *         HapticRtp_Write 的逐样本抑制。threshold = 0 且 previous 取 RTPIN
+ *         当前值时，返回 0 表示整块与 RTPIN 相同，可整块跳过。
+ * @param  previous  samples[-1]，即上一块最后输出的值。
+ * @param  count     不超过 32。
+ * @return 变化位图，0 表示整块相对 previous 没有超过阈值的变化。
+ */
+u32 HapticSwar_ChangedMask(const u8 *samples, u16 count, u8 previous, u8 threshold);
+
+#endif /* __HAPTIC_SWAR_H */
@@ -0,0 +1,254 @@
+/******************************************************************************
+ * 文件名   : haptic_synth.c
+ * 描述     : DDS + ADSR 合成。逐样本只有加法、移位、查表与 8 位乘法，
+ *            RV32EC 无硬件乘除，8 位操作数使 libgcc 乘法循环不超过 8 次。
+ *            电平恒定且无调制的区段（持续段）用 SWAR 核整段缩放，
+ *            与逐样本结果逐位相同；斜坡与调制段的增益逐样本变化，仍逐样本乘。
+ ******************************************************************************/
+#include "haptic_synth.h"
+#include "haptic_swar.h"
+#include "haptic_resonance.h"
+
+enum {
+    SYNTH_STAGE_ATTACK = 0,
+    SYNTH_STAGE_DECAY,
+    SYNTH_STAGE_SUSTAIN,
+    SYNTH_STAGE_RELEASE,
+    SYNTH_STAGE_DONE
+};
+
+/* round(127 * sin(2π·i/256))，i = 0~64，1/4 周期 */
+static const u8 s_quarterSine[65] = {
+      0,   3,   6,   9,  12,  16,  19,  22,  25,  28,  31,  34,  37,
+     40,  43,  46,  49,  51,  54,  57,  60,  63,  65,  68,  71,  73,
+     76,  78,  81,  83,  85,  88,  90,  92,  94,  96,  98, 100, 102,
+    104, 106, 107, 109, 111, 112, 113, 115, 116, 117, 118, 120, 121,
+    122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127, 127
+};
+
+static u32 Synth_MsToSamples(u16 ms) {
+    return ((u32)ms * HAPTIC_RTP_SAMPLE_HZ + 999UL) / 1000UL;
+}
+
+/* 8 位相位 → 单极性正弦 0~127 */
+static u8 Synth_Sine(u8 index) {
+    u8 j = index & 0x3F;
+    s16 value;
+    switch(index >> 6) {
+    case 0:  value = s_quarterSine[j]; break;
+    case 1:  value = s_quarterSine[64 - j]; break;
+    case 2:  value = -(s16)s_quarterSine[j]; break;
+    default: value = -(s16)s_quarterSine[64 - j]; break;
+    }
+    return (u8)((value + 127) >> 1);
+}
+
+/* 进入下一个非空阶段，斜率除法只在这里发生 */
+static void Synth_EnterStage(HapticSynth *synth, u8 stage) {
+    while(stage < SYNTH_STAGE_DONE && synth->stageSamples[stage] == 0) {
+        if(stage == SYNTH_STAGE_ATTACK) {
+            synth->envLevel = synth->peakLevel;
+        } else if(stage == SYNTH_STAGE_DECAY) {
+            synth->envLevel = synth->sustainLevel;
+        } else if(stage == SYNTH_STAGE_RELEASE) {
+            synth->envLevel = 0;
+        }
+        stage++;
+    }
+
+    synth->envStage = stage;
+    if(stage == SYNTH_STAGE_DONE) {
+        synth->envStep = 0;
+        synth->envRemain = 0;
+        return;
+    }
+
+    s32 target;
+    switch(stage) {
+    case SYNTH_STAGE_ATTACK: target = synth->peakLevel; break;
+    case SYNTH_STAGE_DECAY:  target = synth->sustainLevel; break;
+    case SYNTH_STAGE_SUSTAIN: target = synth->envLevel; break;
+    default:                 target = 0; break;
+    }
+    synth->envRemain = synth->stageSamples[stage];
+    synth->envStep = (target - synth->envLevel) / (s32)synth->envRemain;
+}
+
+/* 阶段结束时把电平钉到目标值，避免累加误差 */
+static void Synth_FinishStage(HapticSynth *synth) {
+    switch(synth->envStage) {
+    case SYNTH_STAGE_ATTACK: synth->envLevel = synth->peakLevel; break;
+    case SYNTH_STAGE_DECAY:  synth->envLevel = synth->sustainLevel; break;
+    case SYNTH_STAGE_RELEASE: synth->envLevel = 0; break;
+    default: break;
+    }
+    Synth_EnterStage(synth, (u8)(synth->envStage + 1));
+}
+
+static u16 Synth_ResonanceHz(void) {
+    u16 hz = HapticResonance_Hz();
+    return (hz == 0) ? HAPTIC_SYNTH_DEFAULT_HZ : hz;
+}
+
+/******************************************************************************
+ * @brief  启动合成器。
+ ******************************************************************************/
+void HapticSynth_Start(HapticSynth *synth, const HapticSynth_Config *cfg) {
+    u32 total;
+    u8 amplitude;
+    u16 startHz;
+    u16 endHz;
+
+    if(synth == NULL || cfg == NULL) {
+        return;
+    }
+
+    startHz = (cfg->startHz == HAPTIC_SYNTH_RESONANCE) ? Synth_ResonanceHz() : cfg->startHz;
+    endHz = (cfg->endHz == HAPTIC_SYNTH_RESONANCE) ? Synth_ResonanceHz() : cfg->endHz;
+    synth->follow = (cfg->startHz == HAPTIC_SYNTH_RESONANCE && endHz == startHz);
+    synth->resonanceVersion = HapticResonance_Version();
+
+    amplitude = (cfg->amplitude > 0x7F) ? 0x7F : cfg->amplitude;
+    synth->wave = (u8)cfg->wave;
+    synth->phase = 0;
+    synth->inc = (u32)startHz * HAPTIC_SYNTH_INC_PER_HZ;
+    synth->amPhase = 0x40000000UL; /* 从调制峰值开始，起振不被削弱 */
+    synth->amInc = (u32)cfg->amHz * HAPTIC_SYNTH_INC_PER_HZ;
+    synth->amDepth = (cfg->amHz == 0) ? 0 : ((cfg->amDepth > 128) ? 128 : cfg->amDepth);
+    synth->lfsr = 0xACE1;
+    synth->noise = 0;
+
+    synth->peakLevel = (s32)amplitude << 16;
+    synth->sustainLevel = (s32)(((u32)amplitude * cfg->env.sustainLevel) << 9);
+    synth->stageSamples[SYNTH_STAGE_ATTACK] = Synth_MsToSamples(cfg->env.attackMs);
+    synth->stageSamples[SYNTH_STAGE_DECAY] = Synth_MsToSamples(cfg->env.decayMs);
+    synth->stageSamples[SYNTH_STAGE_SUSTAIN] = Synth_MsToSamples(cfg->env.sustainMs);
+    synth->stageSamples[SYNTH_STAGE_RELEASE] = Synth_MsToSamples(cfg->env.releaseMs);
+
+    total = synth->stageSamples[0] + synth->stageSamples[1] +
+            synth->stageSamples[2] + synth->stageSamples[3];
+    synth->incStep = 0;
+    synth->chirpRemain = 0;
+    if(endHz != startHz && total > 1) {
+        s32 span = (s32)((u32)endHz * HAPTIC_SYNTH_INC_PER_HZ - synth->inc);
+        synth->incStep = span / (s32)(total - 1);
+        synth->chirpRemain = total - 1;
+    }
+
+    synth->envLevel = 0;
+    Synth_EnterStage(synth, SYNTH_STAGE_ATTACK);
+}
+
+/******************************************************************************
+ * @brief  提前进入释放阶段。
+ ******************************************************************************/
+void HapticSynth_Release(HapticSynth *synth) {
+    if(synth == NULL || synth->envStage >= SYNTH_STAGE_RELEASE) {
+        return;
+    }
+    synth->chirpRemain = 0;
+    if(synth->stageSamples[SYNTH_STAGE_RELEASE] == 0) {
+        synth->stageSamples[SYNTH_STAGE_RELEASE] = 1;
+    }
+    Synth_EnterStage(synth, SYNTH_STAGE_RELEASE);
+}
+
+/* 相位累加 → 波形，0~127 */
+static u8 Synth_Wave(HapticSynth *synth) {
+    u32 previous = synth->phase;
+    u8 index = (u8)(previous >> 24);
+    u8 wave;
+
+    synth->phase = previous + synth->inc;
+    if(synth->chirpRemain) {
+        synth->inc += (u32)synth->incStep;
+        synth->chirpRemain--;
+    }
+
+    switch(synth->wave) {
+    case HAPTIC_WAVE_SQUARE:
+        wave = (index & 0x80) ? 0 : 0x7F;
+        break;
+    case HAPTIC_WAVE_TRIANGLE:
+        wave = (index & 0x80) ? (u8)(0x7F - (index & 0x7F)) : (u8)(index & 0x7F);
+        break;
+    case HAPTIC_WAVE_NOISE:
+        if(synth->phase < previous) { /* 每个振荡周期更新一次 */
+            u16 lsb = synth->lfsr & 0x01;
+            synth->lfsr >>= 1;
+            if(lsb) {
+                synth->lfsr ^= 0xB400;
+            }
+            synth->noise = (u8)(synth->lfsr & 0x7F);
+        }
+        wave = synth->noise;
+        break;
+    default:
+        wave = Synth_Sine(index);
+        break;
+    }
+    return wave;
+}
+
+/******************************************************************************
+ * @brief  生成样本：相位累加 → 波形 → 调制 → 包络。
+ ******************************************************************************/
+u16 HapticSynth_Render(HapticSynth *synth, u8 *samples, u16 count) {
+    u16 produced = 0;
+
+    if(synth == NULL || samples == NULL) {
+        return 0;
+    }
+
+    /* 共振跟踪有更新时按块重新调谐，相位连续 */
+    if(synth->follow && synth->resonanceVersion != HapticResonance_Version()) {
+        synth->resonanceVersion = HapticResonance_Version();
+        synth->inc = (u32)Synth_ResonanceHz() * HAPTIC_SYNTH_INC_PER_HZ;
+    }
+
+    while(produced < count && synth->envStage != SYNTH_STAGE_DONE) {
+        /* 电平不变且无调制：增益 env + 1 ≤ 128 在整段内恒定，
+         * SWAR 核的 (x·gain) >> 7 与逐样本相同，且不会触发饱和 */
+        if(synth->envStep == 0 && synth->amDepth == 0) {
+            u16 run = (u16)(count - produced);
+            u16 start = produced;
+
+            if(run > synth->envRemain) {
+                run = (u16)synth->envRemain;
+            }
+            while(produced < start + run) {
+                samples[produced++] = Synth_Wave(synth);
+            }
+            HapticSwar_Gain(samples + start, run, (u8)((synth->envLevel >> 16) + 1));
+
+            synth->envRemain -= run;
+            if(synth->envRemain == 0) {
+                Synth_FinishStage(synth);
+            }
+            continue;
+        }
+
+        u8 wave = Synth_Wave(synth);
+
+        if(synth->amDepth) {
+            u8 mod = Synth_Sine((u8)(synth->amPhase >> 24));
+            u16 gain = (u16)(128 - ((synth->amDepth * (u16)(0x7F - mod)) >> 7));
+            synth->amPhase += synth->amInc;
+            wave = (u8)((wave * gain) >> 7);
+        }
+
+        u8 env = (u8)(synth->envLevel >> 16);
+        samples[produced++] = (u8)((wave * (u16)(env + 1)) >> 7);
+
+        synth->envLevel += synth->envStep;
+        if(--synth->envRemain == 0) {
+            Synth_FinishStage(synth);
+        }
+    }
+
+    return produced;
+}
+
+u16 HapticSynth_Source(void *ctx, u8 *samples, u16 count) {
+    return HapticSynth_Render((HapticSynth *)ctx, samples, count);
+}
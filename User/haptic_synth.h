@@ -0,0 +1,92 @@
+/******************************************************************************
+ * 文件名   : haptic_synth.h
+ * 描述     : 定点 DDS 振荡器 + ADSR 包络，为 RTP 采样流生成样本（逐样本无除法）。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_SYNTH_H
+#define __HAPTIC_SYNTH_H
+
+#include "haptic_rtp.h"
+
+/* 每 Hz 对应的 32 位相位增量（2^32 / 采样率），乘法在启动时完成 */
+#define HAPTIC_SYNTH_INC_PER_HZ   ((u32)(4294967296ULL / HAPTIC_RTP_SAMPLE_HZ))
+
+/* 频率填 HAPTIC_SYNTH_RESONANCE 表示跟随 haptic_resonance 跟踪到的共振频率，
+ * 共振未知时使用 HAPTIC_SYNTH_DEFAULT_HZ */
+#define HAPTIC_SYNTH_RESONANCE    0
+#define HAPTIC_SYNTH_DEFAULT_HZ   170
+
+/* 振荡器波形 */
+typedef enum {
+	HAPTIC_WAVE_SINE     = 0,  /* 正弦（1/4 周期查表） */
+	HAPTIC_WAVE_SQUARE   = 1,  /* 方波 */
+	HAPTIC_WAVE_TRIANGLE = 2,  /* 三角波 */
+	HAPTIC_WAVE_NOISE    = 3   /* LFSR 噪声，按振荡频率采样保持 */
+} HapticSynth_Wave;
+
+/* ADSR 包络参数，时间单位 ms */
+typedef struct {
+	u16 attackMs;     /* 0 → 峰值 */
+	u16 decayMs;      /* 峰值 → 维持电平 */
+	u8  sustainLevel; /* 维持电平，相对峰值 0~0x7F */
+	u16 sustainMs;    /* 维持时长 */
+	u16 releaseMs;    /* 维持电平 → 0 */
+} HapticSynth_Envelope;
+
+/* 一次合成的配置 */
+typedef struct {
+	HapticSynth_Wave wave;
+	u16 startHz;       /* 起始频率，HAPTIC_SYNTH_RESONANCE 表示跟随共振 */
+	u16 endHz;         /* 结束频率，与起始不同则在整个包络内线性扫频 */
+	u8  amplitude;     /* 峰值 RTP 值 0~0x7F */
+	u16 amHz;          /* 幅度调制频率，0 表示不调制 */
+	u8  amDepth;       /* 调制深度 0~128 */
+	HapticSynth_Envelope env;
+} HapticSynth_Config;
+
+/* 合成器运行状态（调用方分配） */
+typedef struct {
+	u32 phase;         /* 载波相位 */
+	u32 inc;           /* 载波相位增量 */
+	s32 incStep;       /* 扫频时每样本的增量变化 */
+	u32 chirpRemain;   /* 剩余扫频样本数 */
+	u32 amPhase;       /* 调制相位 */
+	u32 amInc;         /* 调制相位增量 */
+	u8  amDepth;
+	u8  wave;
+	u8  noise;         /* 当前噪声保持值 */
+	u8  envStage;      /* 包络阶段 */
+	u8  follow;        /* 1 表示定频且跟随共振 */
+	u8  resonanceVersion;
+	u16 lfsr;          /* 噪声发生器 */
+	s32 envLevel;      /* 包络电平，Q16，峰值 = amplitude << 16 */
+	s32 envStep;       /* 每样本电平变化 */
+	u32 envRemain;     /* 当前阶段剩余样本 */
+	s32 peakLevel;
+	s32 sustainLevel;
+	u32 stageSamples[4];
+} HapticSynth;
+
+/**
+ * @brief  按配置启动合成器。
+ * @note   扫频与包络斜率的除法只在启动/阶段切换时执行。
+ */
+void HapticSynth_Start(HapticSynth *synth, const HapticSynth_Config *cfg);
+
+/**
+ * @brief  立即进入释放阶段（用于按键松开等提前结束）。
+ */
+void HapticSynth_Release(HapticSynth *synth);
+
+/**
+ * @brief  生成最多 count 个 RTP 样本。
+ * @return 实际生成数量，包络结束后返回 0。
+ */
+u16 HapticSynth_Render(HapticSynth *synth, u8 *samples, u16 count);
+
+/**
+ * @brief  HapticRtp_Source 适配，ctx 为 HapticSynth 指针。
+ */
+u16 HapticSynth_Source(void *ctx, u8 *samples, u16 count);
+
+#endif /* __HAPTIC_SYNTH_H */
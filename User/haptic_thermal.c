@@ -0,0 +1,199 @@
+/******************************************************************************
+ * 文件名   : haptic_thermal.c
+ * 描述     : 漏桶热预算。桶半满以下增益为 1.0，半满到满之间线性降到
+ *            minGain；minGain 使满幅输出的功率不超过散热速率，桶不会无限增长。
+ ******************************************************************************/
+#include "haptic_thermal.h"
+#include "haptic_instr.h"
+
+#define THERMAL_MSTATUS_MIE  0x00000008UL
+#define THERMAL_FULL_POWER   (0x7FUL * 0x7FUL)
+#define THERMAL_ROM_DEFAULT_MS   250   /* 未收录效果的保守时长 */
+
+/* ROM 效果元数据：时长为上限估计，幅值取名称中的强度百分比 */
+typedef struct {
+    u8 effect;
+    u8 level;
+    u16 durationMs;
+} Thermal_RomMeta;
+
+static const Thermal_RomMeta s_romMeta[] = {
+    { DRV2605_EFFECT_STRONG_CLICK_100,  0x7F,   60 },
+    { DRV2605_EFFECT_STRONG_CLICK_60,   0x4C,   60 },
+    { DRV2605_EFFECT_SHARP_CLICK_100,   0x7F,   40 },
+    { DRV2605_EFFECT_SOFT_BUMP_100,     0x7F,  150 },
+    { DRV2605_EFFECT_SOFT_BUMP_60,      0x4C,  150 },
+    { DRV2605_EFFECT_DOUBLE_CLICK_100,  0x7F,  200 },
+    { DRV2605_EFFECT_TRIPLE_CLICK_100,  0x7F,  300 },
+    { DRV2605_EFFECT_STRONG_BUZZ_100,   0x7F,  400 },
+    { DRV2605_EFFECT_750_MS_ALERT_100,  0x7F,  750 },
+    { DRV2605_EFFECT_1000_MS_ALERT_100, 0x7F, 1000 },
+    { DRV2605_EFFECT_BUZZ_1_100,        0x7F,  300 },
+    { DRV2605_EFFECT_BUZZ_3_60,         0x4C,  300 },
+};
+
+#define THERMAL_ROM_META_COUNT   (sizeof(s_romMeta) / sizeof(s_romMeta[0]))
+
+static u32 Thermal_RomEnergy(DRV2605_Effect effect) {
+    for(u8 i = 0; i < THERMAL_ROM_META_COUNT; i++) {
+        if(s_romMeta[i].effect == (u8)effect) {
+            return (u32)(s_romMeta[i].level * s_romMeta[i].level) * s_romMeta[i].durationMs;
+        }
+    }
+    return THERMAL_FULL_POWER * THERMAL_ROM_DEFAULT_MS;
+}
+
+static void Thermal_Add(HapticThermal *thermal, u32 energy) {
+    u32 limit = thermal->capacity << 1; /* 限制过冲，降额后的恢复时间有界 */
+    thermal->energy = (energy >= limit - thermal->energy || thermal->energy >= limit) ?
+                      limit : thermal->energy + energy;
+}
+
+/******************************************************************************
+ * @brief  初始化预算。
+ ******************************************************************************/
+void HapticThermal_Init(HapticThermal *thermal, const HapticThermal_Config *cfg) {
+    u32 level;
+
+    if(thermal == NULL || cfg == NULL) {
+        return;
+    }
+    level = (cfg->continuousLevel > 0x7F) ? 0x7F : cfg->continuousLevel;
+    thermal->leakPerMs = level * level;
+    thermal->capacity = (u32)cfg->burstMs * (THERMAL_FULL_POWER - thermal->leakPerMs);
+    if(thermal->capacity == 0) {
+        thermal->capacity = 1;
+    }
+    thermal->knee = thermal->capacity >> 1;
+    thermal->minGain = (u8)((level * 128UL) / 0x7F);
+    thermal->energy = 0;
+    thermal->pending = 0;
+    thermal->gain = 128;
+    thermal->lastCycles = HapticInstr_Cycles();
+}
+
+/******************************************************************************
+ * @brief  泄放 + 增益计算，除法只在这里（每块一次）发生。
+ ******************************************************************************/
+void HapticThermal_Update(HapticThermal *thermal) {
+    u32 mstatus;
+    u32 cyclesPerMs;
+    u32 elapsedMs;
+    u32 leak;
+    u32 pending;
+
+    if(thermal == NULL) {
+        return;
+    }
+
+    cyclesPerMs = HapticInstr_CyclesPerUs() * 1000UL;
+    elapsedMs = (HapticInstr_Cycles() - thermal->lastCycles) / cyclesPerMs;
+    if(elapsedMs) {
+        thermal->lastCycles += elapsedMs * cyclesPerMs;
+        /* leakPerMs < 2^14，间隔不足 2^16 ms 时乘积不会溢出 */
+        leak = (elapsedMs >= 0x10000UL) ? thermal->energy : elapsedMs * thermal->leakPerMs;
+        thermal->energy = (thermal->energy > leak) ? thermal->energy - leak : 0;
+    }
+
+    mstatus = __get_MSTATUS();
+    __set_MSTATUS(mstatus & ~THERMAL_MSTATUS_MIE);
+    pending = thermal->pending;
+    thermal->pending = 0;
+    __set_MSTATUS(mstatus);
+    Thermal_Add(thermal, pending);
+
+    if(thermal->energy <= thermal->knee) {
+        thermal->gain = 128;
+    } else if(thermal->energy >= thermal->capacity) {
+        thermal->gain = thermal->minGain;
+    } else {
+        u32 over = thermal->energy - thermal->knee;
+        u32 span = thermal->capacity - thermal->knee;
+        u32 drop = 128U - thermal->minGain;
+        /* over/span 先缩到 8 位，避免 32 位乘法溢出 */
+        thermal->gain = (u8)(128U - (drop * (over / ((span >> 8) + 1U))) / 256U);
+        if(thermal->gain < thermal->minGain) {
+            thermal->gain = thermal->minGain;
+        }
+    }
+}
+
+u8 HapticThermal_Gain(const HapticThermal *thermal) {
+    return (thermal == NULL) ? 128 : thermal->gain;
+}
+
+void HapticThermal_AccountSamples(HapticThermal *thermal, const u8 *samples, u16 count, u16 sampleHz) {
+    u32 energy = 0;
+
+    if(thermal == NULL || samples == NULL || sampleHz == 0) {
+        return;
+    }
+    for(u16 i = 0; i < count; i++) {
+        u8 v = (samples[i] & 0x80) ? (u8)-samples[i] : samples[i]; /* 刹车为负值 */
+        v &= 0x7F;
+        energy += (u16)(v * v);
+    }
+    /* 幅值² × 样本数换算为幅值² × ms；余数单独换算，避免 32 位溢出 */
+    if(sampleHz != 1000U) {
+        energy = (energy / sampleHz) * 1000UL + ((energy % sampleHz) * 1000UL) / sampleHz;
+    }
+    Thermal_Add(thermal, energy);
+}
+
+void HapticThermal_AccountDrive(HapticThermal *thermal, u8 level, u16 durationMs) {
+    if(thermal == NULL) {
+        return;
+    }
+    level &= 0x7F;
+    Thermal_Add(thermal, (u32)(level * level) * durationMs);
+}
+
+void HapticThermal_AccountRom(HapticThermal *thermal, DRV2605_Effect effect) {
+    if(thermal == NULL) {
+        return;
+    }
+    Thermal_Add(thermal, Thermal_RomEnergy(effect));
+}
+
+/* 中断之间也可能嵌套，读-改-写在屏蔽下进行；饱和到 32 位上限 */
+void HapticThermal_QueueRom(HapticThermal *thermal, DRV2605_Effect effect) {
+    u32 mstatus;
+    u32 energy;
+
+    if(thermal == NULL) {
+        return;
+    }
+    energy = Thermal_RomEnergy(effect);
+    mstatus = __get_MSTATUS();
+    __set_MSTATUS(mstatus & ~THERMAL_MSTATUS_MIE);
+    thermal->pending = (energy > 0xFFFFFFFFUL - thermal->pending) ? 0xFFFFFFFFUL : thermal->pending + energy;
+    __set_MSTATUS(mstatus);
+}
+
+void HapticThermal_AccountSequence(HapticThermal *thermal) {
+    u8 slot;
+
+    if(thermal == NULL) {
+        return;
+    }
+    for(u8 reg = DRV2605_REG_WAVESEQ1; reg <= DRV2605_REG_WAVESEQ8; reg++) {
+        if(DRV2605_GetShadowRegister((DRV2605_Register)reg, &slot) == NoREADY) {
+            /* 影子未知：按未收录效果保守计入一次 */
+            Thermal_Add(thermal, THERMAL_FULL_POWER * THERMAL_ROM_DEFAULT_MS);
+            break;
+        }
+        if(slot == 0x00) {
+            break;
+        }
+        if((slot & 0x80) == 0) {
+            Thermal_Add(thermal, Thermal_RomEnergy((DRV2605_Effect)slot));
+        }
+    }
+}
+
+u8 HapticThermal_Headroom(const HapticThermal *thermal) {
+    if(thermal == NULL || thermal->energy >= thermal->capacity) {
+        return 0;
+    }
+    return (u8)(100U - (thermal->energy / ((thermal->capacity / 100U) + 1U)));
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * 文件名   : haptic_thermal.h
+ * 描述     : 执行器热/能量预算：以幅值平方 × 时间估算发热，漏桶按恒定
+ *            散热速率泄放；余量充足时允许满幅过驱，接近上限时平滑降低增益。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_THERMAL_H
+#define __HAPTIC_THERMAL_H
+
+#include "drv2605.h"
+
+/* 能量单位：RTP 幅值² × ms（1kHz 采样下即逐样本幅值² 之和） */
+typedef struct {
+	u8 continuousLevel;  /* 可长期持续的 RTP 幅值，决定散热速率 */
+	u16 burstMs;         /* 冷态下允许满幅（0x7F）持续的时长 */
+} HapticThermal_Config;
+
+/* 单个执行器的预算状态（调用方分配） */
+typedef struct {
+	u32 energy;       /* 桶内能量 */
+	u32 capacity;     /* 桶容量，超过后增益降到 minGain */
+	u32 knee;         /* 低于此值不降额 */
+	u32 leakPerMs;    /* 每 ms 散热量 = continuousLevel² */
+	u32 lastCycles;   /* 上次泄放的时间戳 */
+	u8 minGain;       /* 满桶时的增益，满幅输出不超过 continuousLevel */
+	u8 gain;          /* 当前增益（Q7） */
+	volatile u32 pending;  /* 中断中触发、尚未计入的 ROM 效果能量 */
+} HapticThermal;
+
+/**
+ * @brief  初始化预算，桶为空（冷态）。
+ */
+void HapticThermal_Init(HapticThermal *thermal, const HapticThermal_Config *cfg);
+
+/**
+ * @brief  按流逝时间泄放、计入中断排队的能量并重新计算增益；在每块/每个效果前调用。
+ */
+void HapticThermal_Update(HapticThermal *thermal);
+
+/**
+ * @brief  当前增益（Q7，128 为满幅）。
+ */
+u8 HapticThermal_Gain(const HapticThermal *thermal);
+
+/**
+ * @brief  计入一块已输出的 RTP 样本（每样本 1000/sampleHz ms），有符号负值按绝对值计入。
+ */
+void HapticThermal_AccountSamples(HapticThermal *thermal, const u8 *samples, u16 count, u16 sampleHz);
+
+/**
+ * @brief  计入一段恒定幅值的驱动（持续震动、频率直驱等）。
+ */
+void HapticThermal_AccountDrive(HapticThermal *thermal, u8 level, u16 durationMs);
+
+/**
+ * @brief  按 ROM 效果元数据计入一次库效果；未收录的效果按保守值估算。
+ */
+void HapticThermal_AccountRom(HapticThermal *thermal, DRV2605_Effect effect);
+
+/**
+ * @brief  同 HapticThermal_AccountRom，可在中断中调用：能量先暂存，
+ *         下次 HapticThermal_Update 泄放之后再计入（偏保守）。
+ */
+void HapticThermal_QueueRom(HapticThermal *thermal, DRV2605_Effect effect);
+
+/**
+ * @brief  按 WAVESEQ1~8 影子计入已预写的整段序列（等待槽不计，遇结束符停止）。
+ */
+void HapticThermal_AccountSequence(HapticThermal *thermal);
+
+/**
+ * @brief  剩余余量百分比（0~100）。
+ */
+u8 HapticThermal_Headroom(const HapticThermal *thermal);
+
+#endif /* __HAPTIC_THERMAL_H */
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * 文件名   : haptic_trace.c
+ * 描述     : 记录在栈上按小端逐字节组装后整条交给 haptic_log，时间戳直接取
+ *            TIM2 周期计数，不做除法与格式化。
+ ******************************************************************************/
+#include "haptic_trace.h"
+#include "haptic_instr.h"
+#include "haptic_log.h"
+
+static u8 *Trace_Put32(u8 *p, u32 value) {
+    p[0] = (u8)value;
+    p[1] = (u8)(value >> 8);
+    p[2] = (u8)(value >> 16);
+    p[3] = (u8)(value >> 24);
+    return p + 4;
+}
+
+void HapticTrace_Boot(void) {
+    HAPTIC_TRACE4(HAPTIC_EV_BOOT, SystemCoreClock, DBGMCU_GetCHIPID(),
+                  HapticInstr_CyclesPerUs(), HAPTIC_TRACE_EVENT_COUNT);
+}
+
+/******************************************************************************
+ * @brief  头 + 时间戳 + argc 个参数，最长 HAPTIC_TRACE_RECORD_MAX 字节。
+ ******************************************************************************/
+void HapticTrace_Emit(u8 id, u8 argc, u32 a0, u32 a1, u32 a2, u32 a3) {
+    u8 record[HAPTIC_TRACE_RECORD_MAX];
+    u8 *p = &record[2];
+
+    if(argc > HAPTIC_TRACE_MAX_ARGS) {
+        argc = HAPTIC_TRACE_MAX_ARGS;
+    }
+    record[0] = (u8)(HAPTIC_TRACE_MARKER | argc);
+    record[1] = id;
+    p = Trace_Put32(p, HapticInstr_Cycles());
+    if(argc > 0) {
+        p = Trace_Put32(p, a0);
+    }
+    if(argc > 1) {
+        p = Trace_Put32(p, a1);
+    }
+    if(argc > 2) {
+        p = Trace_Put32(p, a2);
+    }
+    if(argc > 3) {
+        p = Trace_Put32(p, a3);
+    }
+    HapticLog_Write(record, (u16)(p - record));
+}
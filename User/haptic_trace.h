@@ -0,0 +1,50 @@
+/******************************************************************************
+ * 文件名   : haptic_trace.h
+ * 描述     : 二进制 trace：事件号 + 周期时间戳 + 原始整数参数，经 haptic_log 队列发送，
+ *            设备端不做任何格式化，由主机 Tools/trace_decode.cpp 按字典还原文本。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_TRACE_H
+#define __HAPTIC_TRACE_H
+
+#include "debug.h"
+#include "haptic_trace_ids.h"
+
+/*
+ * 记录格式（小端）：
+ *   [0xA0 | argc] [id] [cycles u32] [arg0 u32] ... [argN-1 u32]
+ * 链路应答帧以 0x00 开头，与 0xA0~0xA4 不冲突，二者可共用同一串口。
+ */
+#define HAPTIC_TRACE_MARKER        0xA0
+#define HAPTIC_TRACE_MAX_ARGS      4
+#define HAPTIC_TRACE_RECORD_MAX    (6 + 4 * HAPTIC_TRACE_MAX_ARGS)
+
+/* 事件编号，由字典展开 */
+typedef enum {
+#define HAPTIC_TRACE_ENUM(id, fmt) id,
+	HAPTIC_TRACE_EVENTS(HAPTIC_TRACE_ENUM)
+#undef HAPTIC_TRACE_ENUM
+	HAPTIC_TRACE_EVENT_COUNT
+} HapticTrace_Id;
+
+#define HAPTIC_TRACE0(id)                 HapticTrace_Emit((id), 0, 0, 0, 0, 0)
+#define HAPTIC_TRACE1(id, a)              HapticTrace_Emit((id), 1, (u32)(a), 0, 0, 0)
+#define HAPTIC_TRACE2(id, a, b)           HapticTrace_Emit((id), 2, (u32)(a), (u32)(b), 0, 0)
+#define HAPTIC_TRACE3(id, a, b, c)        HapticTrace_Emit((id), 3, (u32)(a), (u32)(b), (u32)(c), 0)
+#define HAPTIC_TRACE4(id, a, b, c, d)     HapticTrace_Emit((id), 4, (u32)(a), (u32)(b), (u32)(c), (u32)(d))
+
+/**
+ * @brief  输出启动记录（系统时钟、芯片 ID、时间基准、字典条目数），
+ *         解码端据此换算时间戳并校验字典版本。
+ * @note   须在 HapticInstr_Init 与 HapticLog_Init 之后调用。
+ */
+void HapticTrace_Boot(void);
+
+/**
+ * @brief  组装一条记录并入队；缓冲满时整条丢弃（计入日志统计），可在中断中调用。
+ * @param  id    HapticTrace_Id。
+ * @param  argc  有效参数个数（0~HAPTIC_TRACE_MAX_ARGS），须与字典格式串一致。
+ */
+void HapticTrace_Emit(u8 id, u8 argc, u32 a0, u32 a1, u32 a2, u32 a3);
+
+#endif /* __HAPTIC_TRACE_H */
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * 文件名   : haptic_trace_ids.h
+ * 描述     : trace 事件字典：X(编号名, "格式串")。固件只展开编号，格式串不进镜像；
+ *            主机端 Tools/trace_decode.cpp 编译时包含本文件生成解码字典。
+ *            转换只支持 %u %d %x %X %c 与 %%（可带宽度/补零），每条最多 4 个参数。
+ *            只允许在末尾追加，已有条目不改序号，旧日志才能继续解码。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_TRACE_IDS_H
+#define __HAPTIC_TRACE_IDS_H
+
+#define HAPTIC_TRACE_EVENTS(X) \
+    X(HAPTIC_EV_BOOT,               "SystemClk %u Hz, ChipID %08x, %u cyc/us, dictionary %u events") \
+    X(HAPTIC_EV_BANNER,             "DRV2605 low-level freq/amplitude demo") \
+    X(HAPTIC_EV_DEMO_FREQ,          "\n[Demo] Frequency + Voltage sweep") \
+    X(HAPTIC_EV_REALTIME_FAIL,      "Realtime prepare failed") \
+    X(HAPTIC_EV_TONE_UNTRACKED,     "Tone %u -> resonance not tracked yet") \
+    X(HAPTIC_EV_TONE,               "Tone %u -> %u Hz / %u mV") \
+    X(HAPTIC_EV_FREQ_FAIL,          "Freq/Voltage drive failed") \
+    X(HAPTIC_EV_DEMO_CONT,          "\n[Demo] Continuous pulses") \
+    X(HAPTIC_EV_CONT_CONFIG_FAIL,   "Continuous config failed") \
+    X(HAPTIC_EV_CONT_START_FAIL,    "Start continuous failed") \
+    X(HAPTIC_EV_CONT_STOP_FAIL,     "Stop continuous failed") \
+    X(HAPTIC_EV_RESONANCE,          "Resonance %u Hz (raw %u, accepted %u, rejected %u)") \
+    X(HAPTIC_EV_VBAT,               "VBAT %u mV, level %u, gain %u/128") \
+    X(HAPTIC_EV_DEMO_ROM,           "\n[Demo] ROM sequence playback") \
+    X(HAPTIC_EV_STAGE_FAIL,         "Stage sequence failed") \
+    X(HAPTIC_EV_START_FAIL,         "Start playback failed") \
+    X(HAPTIC_EV_STOP_FAIL,          "Stop playback failed") \
+    X(HAPTIC_EV_THERMAL_HEADROOM,   "Thermal headroom %u%%") \
+    X(HAPTIC_EV_DEMO_SYNTH,         "\n[Demo] DDS chirp + ADSR") \
+    X(HAPTIC_EV_PROBE_SYNTH,        "synth/block16: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_SYNTH_FAIL,         "Synth playback failed") \
+    X(HAPTIC_EV_RTP_STATS,          "RTP samples=%u late=%u err=%u") \
+    X(HAPTIC_EV_DEMO_PATTERN,       "\n[Demo] Packed flash patterns") \
+    X(HAPTIC_EV_PATTERN,            "Pattern %u: %u bytes") \
+    X(HAPTIC_EV_PATTERN_FAIL,       "Pattern playback failed") \
+    X(HAPTIC_EV_RTP_SAVED,          "RTP samples=%u suppressed=%u refresh=%u saved=%u B") \
+    X(HAPTIC_EV_DEMO_KEYFRAME,      "\n[Demo] Keyframe interpolation") \
+    X(HAPTIC_EV_PROBE_KF_LINEAR,    "keyframe/linear16: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_PROBE_KF_CUBIC,     "keyframe/cubic16: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_KEYFRAME_FAIL,      "Keyframe playback failed") \
+    X(HAPTIC_EV_DEMO_MIXER,         "\n[Demo] Mixer") \
+    X(HAPTIC_EV_MIXER_COST,         "mixer %u voice(s): %u cyc/sample, budget %u") \
+    X(HAPTIC_EV_MIXER_FAIL,         "Mixer playback failed") \
+    X(HAPTIC_EV_MIXER_STATS,        "Mixer blocks=%u clipped=%u") \
+    X(HAPTIC_EV_DEMO_DITHER,        "\n[Demo] Error-feedback dither") \
+    X(HAPTIC_EV_PROBE_DITHER,       "dither/block16: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_RAMP_ROUNDED,       "Rounded ramp") \
+    X(HAPTIC_EV_RAMP_DITHERED,      "Dithered ramp") \
+    X(HAPTIC_EV_RAMP_FAIL,          "Ramp playback failed") \
+    X(HAPTIC_EV_DEMO_THERMAL,       "\n[Demo] Thermal budget") \
+    X(HAPTIC_EV_BURST_FAIL,         "Burst playback failed") \
+    X(HAPTIC_EV_BURST,              "Burst %u: headroom %u%%, gain %u/128") \
+    X(HAPTIC_EV_AFTER_REST,         "After rest: headroom %u%%, gain %u/128") \
+    X(HAPTIC_EV_DEMO_KICK,          "\n[Demo] Overdrive kick + active brake") \
+    X(HAPTIC_EV_KICK_PULSES,        "Kick %u samples, brake %u samples") \
+    X(HAPTIC_EV_KICK_PLAIN,         "Plain clicks") \
+    X(HAPTIC_EV_KICK_SHAPED,        "Shaped clicks") \
+    X(HAPTIC_EV_CLICK_FAIL,         "Click playback failed") \
+    X(HAPTIC_EV_DEMO_HOST,          "\n[Demo] Host link (%u ms idle window)") \
+    X(HAPTIC_EV_LINK_STATS,         "Link frames=%u crcErr=%u overrun=%u, %u B/s") \
+    X(HAPTIC_EV_PROBE_HOST_PARSE,   "host/parse: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_PROBE_HOST_GO,      "host/cmd-to-go: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_STREAM_STATS,       "Stream underruns=%u late=%u") \
+    X(HAPTIC_EV_LOG_STATS,          "Log bytes=%u dropped=%u peak=%u/%u") \
+    X(HAPTIC_EV_TUNE_SOURCE,        "Tuning loaded from flash: %u") \
+    X(HAPTIC_EV_BANK_INFO,          "Pattern bank slot %u gen %u: %u patterns, %u bytes") \
+    X(HAPTIC_EV_POWER_STATS,        "Power ms: active=%u standby=%u off=%u, %u sleeps") \
+    X(HAPTIC_EV_PROBE_WAKE_STANDBY, "wake/standby: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_PROBE_WAKE_OFF,     "wake/off: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_DEMO_REMINDER,      "\n[Demo] Standby reminders (%u x %u ms)") \
+    X(HAPTIC_EV_STANDBY_FAIL,       "Standby entry failed") \
+    X(HAPTIC_EV_PROBE_WAKE_ONSET,   "wake/onset: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_POWER_CURRENT,      "Deep standby %u ms over %u wakes, est. avg %u uA") \
+    X(HAPTIC_EV_CLOCK,              "SYSCLK %u Hz") \
+    X(HAPTIC_EV_PROBE_CLOCK_SWITCH, "clock/switch: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_DEMO_BUTTONS,       "\n[Demo] Button edges (%u ms window)") \
+    X(HAPTIC_EV_BUTTON_STATS,       "Buttons fast=%u deferred=%u bounced=%u dropped=%u") \
+    X(HAPTIC_EV_PROBE_BUTTON_FAST,  "button/edge-to-go: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_PROBE_BUTTON_DEFER, "button/deferred: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_DEMO_SENSOR,        "\n[Demo] Force sensor watchdog (%u ms window, level %u)") \
+    X(HAPTIC_EV_SENSOR_STATS,       "Sensor presses=%u releases=%u fast=%u deferred=%u") \
+    X(HAPTIC_EV_PROBE_SENSOR_FAST,  "sensor/awd-to-go: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_PROBE_SENSOR_DEFER, "sensor/deferred: n=%u avg=%u min=%u max=%u cyc") \
+    X(HAPTIC_EV_INIT_FAIL,          "DRV2605 init failed") \
+    X(HAPTIC_EV_DEMO_SWAR,          "\n[Demo] SWAR kernels vs scalar (cyc per 16 samples)") \
+    X(HAPTIC_EV_SWAR_GAIN,          "gain: scalar %u, swar %u") \
+    X(HAPTIC_EV_SWAR_SATADD,        "satadd: scalar %u, swar %u") \
+    X(HAPTIC_EV_SWAR_CLAMP,         "clamp: scalar %u, swar %u") \
+    X(HAPTIC_EV_SWAR_DELTA,         "delta: scalar %u, swar %u")
+
+#endif /* __HAPTIC_TRACE_IDS_H */
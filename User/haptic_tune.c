@@ -0,0 +1,190 @@
+/******************************************************************************
+ * 文件名   : haptic_tune.c
+ * 描述     : 调校参数的 RAM 副本与 flash 记录。记录 = 魔数 + 版本 + 长度 +
+ *            参数 + CRC16，整页 64 字节用 FLASH_ROM_ERASE/FLASH_ROM_WRITE 写入。
+ ******************************************************************************/
+#include "haptic_tune.h"
+#include "haptic_config.h"
+#include "haptic_link.h"
+
+/* 未选用调校参数时整个模块不编译：无人引用 _tune_start，Link.ld 便不保留 TUNE 页 */
+#if HAPTIC_USE_TUNE
+
+#define TUNE_MAGIC         0x5455
+#define TUNE_VERSION       1
+#define TUNE_PAGE_BYTES    64
+
+extern const u8 _tune_start[];   /* Link.ld 中的 TUNE 区 */
+
+typedef struct {
+	u16 magic;
+	u8 version;
+	u8 size;
+	HapticTune_Params params;
+	u16 crc;
+} Tune_Record;
+
+static HapticTune_Params s_params;
+
+static u16 Tune_Crc(const HapticTune_Params *params) {
+    return HapticLink_Crc16(0xFFFF, (const u8 *)params, sizeof(*params));
+}
+
+static u8 Tune_Same(const HapticTune_Params *a, const HapticTune_Params *b) {
+    const u8 *pa = (const u8 *)a;
+    const u8 *pb = (const u8 *)b;
+    for(u8 i = 0; i < sizeof(HapticTune_Params); i++) {
+        if(pa[i] != pb[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* flash 中的有效记录；擦除态或校验失败返回 NULL */
+static const Tune_Record *Tune_Stored(void) {
+    const Tune_Record *record = (const Tune_Record *)_tune_start;
+
+    if(record->magic != TUNE_MAGIC || record->version != TUNE_VERSION ||
+       record->size != sizeof(HapticTune_Params) || record->crc != Tune_Crc(&record->params)) {
+        return NULL;
+    }
+    return record;
+}
+
+/******************************************************************************
+ * @brief  载入 flash 记录或默认值。
+ ******************************************************************************/
+ErrorStatus HapticTune_Init(const HapticTune_Params *defaults) {
+    const Tune_Record *stored = Tune_Stored();
+
+    if(stored != NULL) {
+        s_params = stored->params;
+        return READY;
+    }
+    if(defaults != NULL) {
+        s_params = *defaults;
+    }
+    return NoREADY;
+}
+
+const HapticTune_Params *HapticTune_Get(void) {
+    return &s_params;
+}
+
+ErrorStatus HapticTune_GetField(u8 field, u16 *value) {
+    if(value == NULL) {
+        return NoREADY;
+    }
+    switch(field) {
+    case HAPTIC_TUNE_DRIVE_TIME:  *value = s_params.driveTime;  break;
+    case HAPTIC_TUNE_STRENGTH:    *value = s_params.strength;   break;
+    case HAPTIC_TUNE_OVERDRIVE:   *value = s_params.overdrive;  break;
+    case HAPTIC_TUNE_SUSTAIN_POS: *value = s_params.sustainPos; break;
+    case HAPTIC_TUNE_SUSTAIN_NEG: *value = s_params.sustainNeg; break;
+    case HAPTIC_TUNE_BRAKE:       *value = s_params.brake;      break;
+    case HAPTIC_TUNE_BURST_MS:    *value = s_params.burstMs;    break;
+    case HAPTIC_TUNE_PAUSE_MS:    *value = s_params.pauseMs;    break;
+    default:
+        return NoREADY;
+    }
+    return READY;
+}
+
+/******************************************************************************
+ * @brief  修改后只下发受影响的部分：寄存器类参数写一个寄存器，其余只改 RAM。
+ ******************************************************************************/
+ErrorStatus HapticTune_SetField(u8 field, u16 value) {
+    u8 byte = (value > 0xFF) ? 0xFF : (u8)value;
+    DRV2605_FreqAmpTiming timing;
+
+    switch(field) {
+    case HAPTIC_TUNE_DRIVE_TIME:
+        s_params.driveTime = byte & 0x3F;
+        return READY;
+    case HAPTIC_TUNE_STRENGTH:
+        s_params.strength = (byte > 0x7F) ? 0x7F : byte;
+        return READY;
+    case HAPTIC_TUNE_OVERDRIVE:
+        s_params.overdrive = byte;
+        return DRV2605_SetOverdriveClamp(byte);
+    case HAPTIC_TUNE_SUSTAIN_POS:
+        s_params.sustainPos = byte;
+        return DRV2605_WriteRegister(DRV2605_REG_SUSTAINPOS, byte);
+    case HAPTIC_TUNE_SUSTAIN_NEG:
+        s_params.sustainNeg = byte;
+        return DRV2605_WriteRegister(DRV2605_REG_SUSTAINNEG, byte);
+    case HAPTIC_TUNE_BRAKE:
+        s_params.brake = byte;
+        return DRV2605_SetBrakeLevel(byte);
+    case HAPTIC_TUNE_BURST_MS:
+    case HAPTIC_TUNE_PAUSE_MS:
+        if(field == HAPTIC_TUNE_BURST_MS) {
+            s_params.burstMs = value;
+        } else {
+            s_params.pauseMs = value;
+        }
+        timing.burstDurationMs = s_params.burstMs;
+        timing.pauseDurationMs = s_params.pauseMs;
+        DRV2605_SetFreqAmpTiming(&timing);
+        return READY;
+    default:
+        return NoREADY;
+    }
+}
+
+ErrorStatus HapticTune_Apply(void) {
+    DRV2605_FreqAmpTiming timing;
+
+    timing.burstDurationMs = s_params.burstMs;
+    timing.pauseDurationMs = s_params.pauseMs;
+    DRV2605_SetFreqAmpTiming(&timing);
+
+    if(DRV2605_SetOverdriveClamp(s_params.overdrive) == NoREADY ||
+       DRV2605_SetSustainLevel(s_params.sustainPos, s_params.sustainNeg) == NoREADY ||
+       DRV2605_SetBrakeLevel(s_params.brake) == NoREADY) {
+        return NoREADY;
+    }
+    return READY;
+}
+
+void HapticTune_Continuous(const DRV2605_ContinuousConfig *base, DRV2605_ContinuousConfig *cfg) {
+    if(base == NULL || cfg == NULL) {
+        return;
+    }
+    *cfg = *base;
+    cfg->driveTime = s_params.driveTime;
+    cfg->strength = s_params.strength;
+}
+
+/******************************************************************************
+ * @brief  组装整页映像后擦写，完成后按记录格式回读校验。
+ ******************************************************************************/
+ErrorStatus HapticTune_Save(void) {
+    u32 page[TUNE_PAGE_BYTES / 4];
+    Tune_Record *record = (Tune_Record *)page;
+    const Tune_Record *stored = Tune_Stored();
+    u32 address = FLASH_BASE | (u32)_tune_start;
+
+    if(stored != NULL && Tune_Same(&stored->params, &s_params)) {
+        return READY;
+    }
+
+    for(u8 i = 0; i < TUNE_PAGE_BYTES / 4; i++) {
+        page[i] = 0xFFFFFFFFUL;
+    }
+    record->magic = TUNE_MAGIC;
+    record->version = TUNE_VERSION;
+    record->size = sizeof(HapticTune_Params);
+    record->params = s_params;
+    record->crc = Tune_Crc(&s_params);
+
+    if(FLASH_ROM_ERASE(address, TUNE_PAGE_BYTES) != FLASH_COMPLETE ||
+       FLASH_ROM_WRITE(address, page, TUNE_PAGE_BYTES) != FLASH_COMPLETE) {
+        return NoREADY;
+    }
+    stored = Tune_Stored();
+    return (stored != NULL && Tune_Same(&stored->params, &s_params)) ? READY : NoREADY;
+}
+
+#endif /* HAPTIC_USE_TUNE */
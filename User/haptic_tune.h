@@ -0,0 +1,80 @@
+/******************************************************************************
+ * 文件名   : haptic_tune.h
+ * 描述     : 可在线调校的执行器参数（驱动周期、强度、过驱/维持/制动、
+ *            频率直驱 burst 时序），保存在 Link.ld 预留的 TUNE flash 页。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_TUNE_H
+#define __HAPTIC_TUNE_H
+
+#include "drv2605.h"
+
+/* 参数编号，主机协议按此读写 */
+typedef enum {
+	HAPTIC_TUNE_DRIVE_TIME  = 0,  /* CONTROL2 驱动周期 0~63 */
+	HAPTIC_TUNE_STRENGTH    = 1,  /* 持续震动强度 0~0x7F */
+	HAPTIC_TUNE_OVERDRIVE   = 2,  /* 寄存器 0x0D */
+	HAPTIC_TUNE_SUSTAIN_POS = 3,  /* 寄存器 0x0E */
+	HAPTIC_TUNE_SUSTAIN_NEG = 4,  /* 寄存器 0x0F */
+	HAPTIC_TUNE_BRAKE       = 5,  /* 寄存器 0x10 */
+	HAPTIC_TUNE_BURST_MS    = 6,  /* 频率直驱 burst 时长 */
+	HAPTIC_TUNE_PAUSE_MS    = 7,  /* 频率直驱 burst 间隔 */
+	HAPTIC_TUNE_COUNT
+} HapticTune_Field;
+
+typedef struct {
+	u8 driveTime;
+	u8 strength;
+	u8 overdrive;
+	u8 sustainPos;
+	u8 sustainNeg;
+	u8 brake;
+	u16 burstMs;
+	u16 pauseMs;
+} HapticTune_Params;
+
+/**
+ * @brief  flash 中有有效记录（魔数、版本、CRC 均通过）时载入，否则使用默认值。
+ * @param  defaults 固件内置默认值。
+ * @return READY 已从 flash 载入，NoREADY 使用默认值。
+ */
+ErrorStatus HapticTune_Init(const HapticTune_Params *defaults);
+
+/**
+ * @brief  当前参数（只读）。
+ */
+const HapticTune_Params *HapticTune_Get(void);
+
+/**
+ * @brief  读取单个参数。
+ * @return READY 成功，NoREADY 编号非法。
+ */
+ErrorStatus HapticTune_GetField(u8 field, u16 *value);
+
+/**
+ * @brief  修改单个参数（越界值被截断到寄存器位宽）；寄存器类参数与 burst 时序
+ *         立即生效，驱动周期/强度在下一次配置持续震动时生效。
+ * @return READY 成功，NoREADY 编号非法或写寄存器失败。
+ */
+ErrorStatus HapticTune_SetField(u8 field, u16 value);
+
+/**
+ * @brief  下发全部参数：过驱/维持/制动寄存器与 burst 时序。
+ * @note   驱动周期在下一次 DRV2605_ConfigureContinuous 时生效，
+ *         调用方用 HapticTune_Continuous 生成配置。
+ */
+ErrorStatus HapticTune_Apply(void);
+
+/**
+ * @brief  以 base 为模板，填入调校后的驱动周期与强度。
+ */
+void HapticTune_Continuous(const DRV2605_ContinuousConfig *base, DRV2605_ContinuousConfig *cfg);
+
+/**
+ * @brief  写入 flash（64 字节页擦除 + 快速页编程，期间 CPU 停顿数毫秒）；内容未变时跳过。
+ * @note   不可在播放过程中调用。
+ * @return READY 成功或无需写入，NoREADY 编程失败或回读校验失败。
+ */
+ErrorStatus HapticTune_Save(void);
+
+#endif /* __HAPTIC_TUNE_H */
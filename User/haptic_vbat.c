@@ -0,0 +1,139 @@
+/******************************************************************************
+ * 文件名   : haptic_vbat.c
+ * 描述     : VBAT 采样与补偿。VDD = VBAT × 5.6V / 255；读数以 Q8 做一阶低通
+ *            （α = 1/16），增益 = 标定电压 / 当前电压，除法只在采样时发生。
+ ******************************************************************************/
+#include "haptic_vbat.h"
+#include "haptic_instr.h"
+
+#define VBAT_FULL_SCALE_MV   5600UL
+#define VBAT_FILTER_SHIFT    4
+#define VBAT_RAW_MIN         64       /* 约 1.4V 以下视为无效读数 */
+
+static HapticVbat_Config s_cfg = { 0, 3000, 2800, 1, 500 };
+static u16 s_rawQ8;                   /* 滤波后的原始值，Q8 */
+static u16 s_millivolts;
+static u16 s_nominalMv;
+static HapticVbat_Level s_level = HAPTIC_VBAT_NORMAL;
+static u8 s_clampSaved;               /* LOW 期间保存的原 CLAMPV */
+static u8 s_clampCapped;
+static u32 s_intervalCycles;
+static u32 s_lastPoll;
+
+/* 过驱钳位降到额定电压，恢复时写回原值 */
+static void Vbat_CapOverdrive(u8 enable) {
+    u8 rated;
+    u8 clamp;
+
+    if(enable && !s_clampCapped) {
+        if(DRV2605_GetShadowRegister(DRV2605_REG_RATEDV, &rated) == READY &&
+           DRV2605_GetShadowRegister(DRV2605_REG_CLAMPV, &clamp) == READY) {
+            s_clampSaved = clamp;
+            s_clampCapped = 1;
+            if(clamp > rated) {
+                DRV2605_WriteRegister(DRV2605_REG_CLAMPV, rated);
+            }
+        }
+    } else if(!enable && s_clampCapped) {
+        s_clampCapped = 0;
+        DRV2605_WriteRegister(DRV2605_REG_CLAMPV, s_clampSaved);
+    }
+}
+
+/* 按滤波电压确定等级（带回差），并计算增益 */
+static void Vbat_Update(void) {
+    HapticVbat_Level level = s_level;
+    u16 mv = s_millivolts;
+    u32 gain;
+
+    if(mv < s_cfg.criticalMv) {
+        level = HAPTIC_VBAT_CRITICAL;
+    } else if(mv < s_cfg.lowMv) {
+        if(level == HAPTIC_VBAT_NORMAL || mv >= s_cfg.criticalMv + HAPTIC_VBAT_HYSTERESIS_MV) {
+            level = HAPTIC_VBAT_LOW;
+        }
+    } else if(mv >= s_cfg.lowMv + HAPTIC_VBAT_HYSTERESIS_MV) {
+        level = HAPTIC_VBAT_NORMAL;
+    } else if(level == HAPTIC_VBAT_CRITICAL) {
+        level = HAPTIC_VBAT_LOW;
+    }
+    s_level = level;
+
+    if(s_nominalMv == 0) {
+        s_nominalMv = (s_cfg.nominalMv != 0) ? s_cfg.nominalMv : mv;
+    }
+    gain = ((u32)s_nominalMv * 128UL + mv / 2U) / mv;
+    if(gain > 255) {
+        gain = 255;
+    }
+    if(level != HAPTIC_VBAT_NORMAL && gain > 128) {
+        gain = 128;
+    }
+    DRV2605_SetSupplyGain((u8)gain);
+    Vbat_CapOverdrive(level != HAPTIC_VBAT_NORMAL);
+}
+
+/******************************************************************************
+ * @brief  初始化采样器。
+ ******************************************************************************/
+void HapticVbat_Init(const HapticVbat_Config *cfg) {
+    if(cfg != NULL) {
+        s_cfg = *cfg;
+    }
+    if(s_cfg.intervalMs == 0) {
+        s_cfg.intervalMs = 1;
+    }
+    Vbat_CapOverdrive(0);
+    s_rawQ8 = 0;
+    s_millivolts = 0;
+    s_nominalMv = 0;
+    s_level = HAPTIC_VBAT_NORMAL;
+    s_intervalCycles = (u32)s_cfg.intervalMs * 1000UL * HapticInstr_CyclesPerUs();
+    s_lastPoll = HapticInstr_Cycles();
+    DRV2605_SetSupplyGain(128);
+}
+
+/******************************************************************************
+ * @brief  读取 VBAT 并滤波。
+ ******************************************************************************/
+ErrorStatus HapticVbat_Sample(void) {
+    u8 raw;
+
+    if(DRV2605_ReadVbatRaw(&raw) == NoREADY) {
+        return NoREADY;
+    }
+    if(raw < VBAT_RAW_MIN) {
+        return NoREADY;
+    }
+
+    if(s_rawQ8 == 0) {
+        s_rawQ8 = (u16)raw << 8;
+    } else {
+        s_rawQ8 = (u16)((s32)s_rawQ8 + ((((s32)raw << 8) - (s32)s_rawQ8) >> VBAT_FILTER_SHIFT));
+    }
+    s_millivolts = (u16)((s_rawQ8 * VBAT_FULL_SCALE_MV) / (255UL * 256UL));
+    Vbat_Update();
+    return READY;
+}
+
+void HapticVbat_Poll(void) {
+    u32 now = HapticInstr_Cycles();
+
+    if(now - s_lastPoll < s_intervalCycles) {
+        return;
+    }
+    s_lastPoll = now;
+    HapticVbat_Sample();
+}
+
+u16 HapticVbat_Millivolts(void) {
+    return s_millivolts;
+}
+
+HapticVbat_Level HapticVbat_GetLevel(void) {
+    return s_level;
+}
+
+u8 HapticVbat_Allow(u8 priority) {
+    return (u8)(s_level != HAPTIC_VBAT_CRITICAL || priority >= s_cfg.minPriority);
+}
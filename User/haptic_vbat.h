@@ -0,0 +1,60 @@
+/******************************************************************************
+ * 文件名   : haptic_vbat.h
+ * 描述     : VBAT 电源补偿：低频采样 REG_VBAT 并滤波，换算为驱动层幅值增益，
+ *            低电量时限制过驱、跳过低优先级效果。
+ * 版权说明 : 仅供 CH32 项目内部使用。
+ ******************************************************************************/
+#ifndef __HAPTIC_VBAT_H
+#define __HAPTIC_VBAT_H
+
+#include "drv2605.h"
+
+#define HAPTIC_VBAT_HYSTERESIS_MV   100   /* 电量等级回升所需的额外裕量 */
+
+/* 电源等级 */
+typedef enum {
+	HAPTIC_VBAT_NORMAL   = 0,  /* 正常补偿 */
+	HAPTIC_VBAT_LOW      = 1,  /* 增益不超过 1.0，过驱钳位降到额定电压 */
+	HAPTIC_VBAT_CRITICAL = 2   /* 另外跳过低优先级效果 */
+} HapticVbat_Level;
+
+typedef struct {
+	u16 nominalMv;    /* 效果标定时的电源电压（增益 1.0），0 表示取首次滤波读数 */
+	u16 lowMv;        /* 低于此值进入 LOW */
+	u16 criticalMv;   /* 低于此值进入 CRITICAL */
+	u8 minPriority;   /* CRITICAL 时允许播放的最低优先级 */
+	u16 intervalMs;   /* 采样间隔 */
+} HapticVbat_Config;
+
+/**
+ * @brief  初始化采样器；cfg 为 NULL 时使用默认值（3.0V/2.8V，500ms）。
+ */
+void HapticVbat_Init(const HapticVbat_Config *cfg);
+
+/**
+ * @brief  到达采样间隔时读取一次；VBAT 只在器件播放期间更新，需在播放循环中调用。
+ */
+void HapticVbat_Poll(void);
+
+/**
+ * @brief  立即读取一次并更新增益与等级。
+ * @return READY 成功，NoREADY 读失败或读数无效。
+ */
+ErrorStatus HapticVbat_Sample(void);
+
+/**
+ * @brief  滤波后的电源电压（mV），未知时为 0。
+ */
+u16 HapticVbat_Millivolts(void);
+
+/**
+ * @brief  当前电源等级。
+ */
+HapticVbat_Level HapticVbat_GetLevel(void);
+
+/**
+ * @brief  当前电源等级下是否允许播放该优先级的效果。
+ */
+u8 HapticVbat_Allow(u8 priority);
+
+#endif /* __HAPTIC_VBAT_H */
@@ -11,16 +11,44 @@
  *******************************************************************************/
 
 #include "debug.h"
+#include "haptic_config.h"
 #include "drv2605.h"
+#include "haptic_instr.h"
+#include "haptic_synth.h"
+#include "haptic_patterns.h"
+#include "haptic_keyframe.h"
+#include "haptic_mixer.h"
+#include "haptic_dither.h"
+#include "haptic_resonance.h"
+#include "haptic_vbat.h"
+#include "haptic_thermal.h"
+#include "haptic_kick.h"
+#include "haptic_swar.h"
+#include "haptic_host.h"
+#include "haptic_log.h"
+#include "haptic_trace.h"
+#include "haptic_tune.h"
+#include "haptic_bank.h"
+#include "haptic_power.h"
+#include "haptic_clock.h"
+#include "haptic_button.h"
+#include "haptic_sensor.h"
 
 #define I2C_BUS_SPEED         100000
+#define USART_BAUD            460800
 #define VIBE_FREQ_FAST_HZ     150
 #define VIBE_FREQ_SLOW_HZ     200
 #define VIBE_VOLTAGE_MAX_MV   5000
 #define CONT_PULSE_COUNT      4
 #define CONT_ON_TIME_MS       400
 #define CONT_OFF_TIME_MS      300
+#define CONT_TRACK_STEP_MS    10
+#define CONT_DRIVE_TIME       0x20
+#define CONT_STRENGTH         0x50
+#define REMINDER_COUNT        3
+#define REMINDER_INTERVAL_MS  2000
 
+#if HAPTIC_DEMO == HAPTIC_DEMO_DRIVER
 typedef struct {
     u16 frequencyHz;
     u16 voltageMv;
@@ -28,18 +56,14 @@ typedef struct {
 
 static const DRV2605_FreqVoltageTone toneSequence[] = {
     { VIBE_FREQ_FAST_HZ, VIBE_VOLTAGE_MAX_MV },
-    { VIBE_FREQ_SLOW_HZ, VIBE_VOLTAGE_MAX_MV }
-};
-
-static const DRV2605_FreqAmpTiming freqAmpTiming = {
-    .burstDurationMs = 500,
-    .pauseDurationMs = 0
+    { VIBE_FREQ_SLOW_HZ, VIBE_VOLTAGE_MAX_MV },
+    { DRV2605_FREQ_RESONANCE, VIBE_VOLTAGE_MAX_MV }   /* 跟随实测共振 */
 };
 
 static const DRV2605_ContinuousConfig continuousConfig = {
     .useLRA = ENABLE,
-    .driveTime = 0x20,
-    .strength = 0x50,
+    .driveTime = CONT_DRIVE_TIME,
+    .strength = CONT_STRENGTH,
     .libraryId = DRV2605_LIBRARY_LRA
 };
 
@@ -55,6 +79,191 @@ static const DRV2605_Effect romEffects[] = {
 static void Demo_FreqVoltage(void);
 static void Demo_ContinuousPulses(void);
 static void Demo_RomWaveforms(void);
+#endif
+
+#if HAPTIC_USE_TUNE
+/* 调校参数出厂值；flash 中有保存的调校结果时以其为准 */
+static const HapticTune_Params tuneDefaults = {
+    .driveTime = CONT_DRIVE_TIME,
+    .strength = CONT_STRENGTH,
+    .overdrive = 0x00,
+    .sustainPos = 0x00,
+    .sustainNeg = 0x00,
+    .brake = 0x00,
+    .burstMs = 500,
+    .pauseMs = 0
+};
+#endif
+
+/* 待机门限长于最长的 ROM 效果，避免截断仍在播放的效果；断电门限落在主机等待窗口内 */
+static const HapticPower_Config powerConfig = {
+    .standbyMs = 1000,
+    .offMs = 3000
+};
+
+/* 外设参数须与 IIC_Init/USART_Printf_Init 一致，切换时钟后按此重算 */
+static const HapticClock_Config clockConfig = {
+    .i2cSpeed = I2C_BUS_SPEED,
+    .baud = USART_BAUD
+};
+
+#if HAPTIC_USE_BUTTON
+/* PC4 按下/松开各一个 ROM 效果（按下为预写效果），PD3 按下播放心跳图案 */
+static const HapticButton_Map buttonMap[] = {
+    { GPIO_PortSourceGPIOC, 4, HAPTIC_BUTTON_FALLING, DRV2605_EFFECT_STRONG_CLICK_100, NULL },
+    { GPIO_PortSourceGPIOC, 4, HAPTIC_BUTTON_RISING,  DRV2605_EFFECT_SHARP_TICK_2_80,  NULL },
+    { GPIO_PortSourceGPIOD, 3, HAPTIC_BUTTON_FALLING, DRV2605_EFFECT_STRONG_CLICK_100, &heartbeatPattern }
+};
+
+/* 本板 IN/TRIG 未连线，只用 I2C 突发写 GO；接到 PC0 时填 { GPIOC, GPIO_Pin_0 } */
+static const HapticButton_Config buttonConfig = {
+    .trigPort = NULL,
+    .trigPin = 0
+};
+#endif
+
+#if HAPTIC_USE_SENSOR
+/* 力敏电阻分压接 A7（PD4），按下电压升高；门限差即迟滞 */
+static const HapticSensor_Config sensorConfig = {
+    .channel = ADC_Channel_7,
+    .pressLevel = 600,
+    .releaseLevel = 450,
+    .pressEffect = DRV2605_EFFECT_STRONG_CLICK_100,
+    .releaseEffect = DRV2605_EFFECT_SHARP_TICK_2_80
+};
+#endif
+
+/* 热预算：可长期持续 0x50，冷态允许满幅 1.5s */
+static const HapticThermal_Config thermalConfig = {
+    .continuousLevel = 0x50,
+    .burstMs = 1500
+};
+
+static HapticThermal actuatorThermal;
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_POWER
+/* 数据手册典型值：CH32V003 48MHz 运行 / Standby+AWU，DRV2605 就绪 / 待机 / EN 拉低 */
+static const HapticPower_CurrentModel currentModel = {
+    .mcuRunUa = 4600,
+    .mcuDeepUa = 10,
+    .drvActiveUa = 500,
+    .drvStandbyUa = 6,
+    .drvOffUa = 4
+};
+
+static const DRV2605_Effect reminderEffect = DRV2605_EFFECT_STRONG_CLICK_100;
+
+static const HapticSynth_Config thermalBurst = {
+    .wave = HAPTIC_WAVE_SINE,
+    .startHz = HAPTIC_SYNTH_RESONANCE,
+    .endHz = HAPTIC_SYNTH_RESONANCE,
+    .amplitude = 0x7F,
+    .env = { .attackMs = 5, .decayMs = 0, .sustainLevel = 0x7F, .sustainMs = 1200, .releaseMs = 20 }
+};
+
+/* 20ms 方波点击：无过驱时起振慢、停振拖尾 */
+#define CLICK_LEVEL          0x60
+#define CLICK_MS             20
+
+/* 两个半周期过驱 + 两个半周期反相刹车 */
+static const HapticKick_Config clickKick = {
+    .kickLevel = 128,
+    .kickHalfCycles = 2,
+    .brakeLevel = 128,
+    .brakeHalfCycles = 2,
+    .edgeThreshold = 0x10,
+    .brakeMode = HAPTIC_KICK_BRAKE_REVERSE
+};
+
+#define THERMAL_BURST_COUNT  3
+#define KICK_CLICK_COUNT     3
+
+static void Demo_Thermal(void);
+static void Demo_Kick(void);
+static void Demo_Reminder(void);
+#endif
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_RENDER
+/* 扫频 + 幅度调制的合成示例 */
+static const HapticSynth_Config synthChirp = {
+    .wave = HAPTIC_WAVE_SINE,
+    .startHz = 60,
+    .endHz = 240,
+    .amplitude = 0x7F,
+    .amHz = 8,
+    .amDepth = 96,
+    .env = { .attackMs = 40, .decayMs = 60, .sustainLevel = 0x60, .sustainMs = 300, .releaseMs = 100 }
+};
+
+#define SYNTH_BENCH_BLOCKS   32
+
+/* 呼吸式起伏：7 个关键帧 14 字节，展开约 1.1 s */
+static const HapticKeyframe breatheKeys[] = {
+    { 0, 0x00 }, { 30, 0x50 }, { 20, 0x7F }, { 15, 0x30 },
+    { 25, 0x70 }, { 40, 0x20 }, { 90, 0x00 }
+};
+
+static const HapticKeyframePattern breatheLinear = {
+    breatheKeys, sizeof(breatheKeys) / sizeof(breatheKeys[0]), 5, HAPTIC_KEYFRAME_LINEAR
+};
+
+static const HapticKeyframePattern breatheCubic = {
+    breatheKeys, sizeof(breatheKeys) / sizeof(breatheKeys[0]), 5, HAPTIC_KEYFRAME_CUBIC
+};
+
+/* 低强度慢斜坡：7 位量化下只有 0~8 共 9 级台阶 */
+static const HapticKeyframe faintKeys[] = {
+    { 0, 0x00 }, { 150, 0x08 }, { 50, 0x08 }, { 150, 0x00 }
+};
+
+static const HapticKeyframePattern faintRamp = {
+    faintKeys, sizeof(faintKeys) / sizeof(faintKeys[0]), 10, HAPTIC_KEYFRAME_LINEAR
+};
+
+/* 混音示例：低幅滚动纹理 + 中途到达的通知震动 */
+static const HapticSynth_Config mixTexture = {
+    .wave = HAPTIC_WAVE_TRIANGLE,
+    .startHz = 40,
+    .endHz = 40,
+    .amplitude = 0x40,
+    .env = { .attackMs = 20, .decayMs = 0, .sustainLevel = 0x7F, .sustainMs = 1200, .releaseMs = 50 }
+};
+
+static const HapticSynth_Config mixNotify = {
+    .wave = HAPTIC_WAVE_SINE,
+    .startHz = HAPTIC_SYNTH_RESONANCE,
+    .endHz = HAPTIC_SYNTH_RESONANCE,
+    .amplitude = 0x7F,
+    .env = { .attackMs = 5, .decayMs = 30, .sustainLevel = 0x60, .sustainMs = 250, .releaseMs = 40 }
+};
+
+#define MIX_NOTIFY_DELAY_MS  400
+#define MIX_BENCH_BLOCKS     32
+#define SWAR_BENCH_ROUNDS    64
+
+static void Demo_Synth(void);
+static void Demo_Keyframes(void);
+static void Demo_Mixer(void);
+#if HAPTIC_USE_PROBE
+static void Demo_Swar(void);
+#endif
+static void Demo_Dither(void);
+#endif
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_HOST
+#define HOST_LINK_WINDOW_MS  5000   /* 无命令时的等待窗口，收到帧后重新计时 */
+
+static void Demo_HostLink(void);
+#endif
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_INPUT
+#define BUTTON_WINDOW_MS     5000
+#define SENSOR_WINDOW_MS     5000
+
+static void Demo_Patterns(void);
+static void Demo_Buttons(void);
+static void Demo_Sensor(void);
+#endif
 
 /*********************************************************************
  * @fn      IIC_Init
@@ -106,97 +315,678 @@ void IIC_Init (u32 bound, u16 address) {
 int main (void) {
     SystemCoreClockUpdate();
     Delay_Init();
-    USART_Printf_Init (460800);
-    printf ("SystemClk:%d\r\n", SystemCoreClock);
-    printf ("ChipID:%08x\r\n", DBGMCU_GetCHIPID());
-    printf ("DRV2605 low-level freq/amplitude demo\r\n");
+    USART_Printf_Init (USART_BAUD);
+    HapticInstr_Init();
+    HapticLog_Init();
+    HapticTrace_Boot();
+    HAPTIC_TRACE0 (HAPTIC_EV_BANNER);
 
     IIC_Init (I2C_BUS_SPEED, 0x00);
+    /* FEEDBACK 上电为 ERM：任何预写或播放之前先选 LRA 闭环、LRA 库与 MODE */
+    if (DRV2605_InitDefaults() != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_INIT_FAIL);
+    }
+#if HAPTIC_USE_TUNE
+    HAPTIC_TRACE1 (HAPTIC_EV_TUNE_SOURCE, HapticTune_Init (&tuneDefaults) == READY);
+    HapticTune_Apply();
+#endif
+#if HAPTIC_USE_BANK
+    HapticBank_Init();
+    HAPTIC_TRACE4 (HAPTIC_EV_BANK_INFO, HapticBank_GetInfo()->slot, HapticBank_GetInfo()->generation,
+            HapticBank_GetInfo()->count, HapticBank_GetInfo()->size);
+#endif
+#if HAPTIC_USE_SUPPLY
+    HapticResonance_Init (0);
+    HapticVbat_Init (NULL);
+#endif
+    HapticThermal_Init (&actuatorThermal, &thermalConfig);
+    HapticRtp_SetThermal (&actuatorThermal);
+#if HAPTIC_USE_HOST
+    HapticHost_Init();
+#endif
+    HapticPower_Init (&powerConfig);
+    HapticClock_Init (&clockConfig);
+#if HAPTIC_USE_BUTTON
+    HapticButton_Init (buttonMap, sizeof(buttonMap) / sizeof(buttonMap[0]), &buttonConfig);
+#endif
+#if HAPTIC_USE_SENSOR
+    HapticSensor_Init (&sensorConfig);
+#endif
 
+#if HAPTIC_DEMO
+#if HAPTIC_USE_SENSOR
+    HapticSensor_Cmd (DISABLE);
+#endif
     while (1) {
+#if HAPTIC_DEMO == HAPTIC_DEMO_DRIVER
         Demo_FreqVoltage();
         Demo_ContinuousPulses();
         Demo_RomWaveforms();
+#elif HAPTIC_DEMO == HAPTIC_DEMO_POWER
+        Demo_Thermal();
+#if HAPTIC_USE_KICK
+        Demo_Kick();
+#endif
+        Demo_Reminder();
+#elif HAPTIC_DEMO == HAPTIC_DEMO_RENDER
+        Demo_Synth();
+        Demo_Keyframes();
+        Demo_Mixer();
+#if HAPTIC_USE_PROBE
+        Demo_Swar();
+#endif
+        Demo_Dither();
+#elif HAPTIC_DEMO == HAPTIC_DEMO_HOST
+#if HAPTIC_USE_HOST
+        Demo_HostLink();
+#endif
+#elif HAPTIC_DEMO == HAPTIC_DEMO_INPUT
+        Demo_Patterns();
+#if HAPTIC_USE_BUTTON
+        Demo_Buttons();
+#endif
+#if HAPTIC_USE_SENSOR
+        Demo_Sensor();
+#endif
+#endif
+    }
+#else
+    /* 产品固件：编入按键/传感器时，器件就绪则在中断里直接 GO，待机/断电时转交
+     * 主循环唤醒后播放；主机命令、转交项都为空时按空闲时长降级电源后 WFI */
+#if HAPTIC_USE_BUTTON
+    if (HapticButton_Arm() != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_STAGE_FAIL);
+    }
+#endif
+#if HAPTIC_USE_SENSOR
+    HapticSensor_Cmd (ENABLE);
+#endif
+    while (1) {
+        u8 busy = 0;
+
+#if HAPTIC_USE_HOST
+        busy |= HapticHost_Poll();
+#endif
+#if HAPTIC_USE_BUTTON
+        busy |= HapticButton_Poll();
+#endif
+#if HAPTIC_USE_SENSOR
+        busy |= HapticSensor_Poll();
+#endif
+        if (busy == 0) {
+            HapticPower_Idle();
+        }
     }
+#endif
 }
 
+#if HAPTIC_DEMO == HAPTIC_DEMO_DRIVER
+
 static void Demo_FreqVoltage(void) {
-    printf ("\r\n[Demo] Frequency + Voltage sweep\r\n");
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_FREQ);
     DRV2605_SetFreqAmpVoltageRange (VIBE_VOLTAGE_MAX_MV);
-    DRV2605_SetFreqAmpTiming (&freqAmpTiming);
 
     if (DRV2605_PrepareFreqAmpRealtime() != READY) {
-        printf ("Realtime prepare failed\r\n");
+        HAPTIC_TRACE0 (HAPTIC_EV_REALTIME_FAIL);
         return;
     }
 
     for (u8 i = 0; i < TONE_COUNT; i++) {
         const DRV2605_FreqVoltageTone *tone = &toneSequence[i];
-        printf ("Tone %u -> %u Hz / %u mV\r\n", i, tone->frequencyHz, tone->voltageMv);
+        u16 frequencyHz = (tone->frequencyHz == DRV2605_FREQ_RESONANCE) ?
+                          DRV2605_GetResonanceHz() : tone->frequencyHz;
+        if (frequencyHz == 0) {
+            HAPTIC_TRACE1 (HAPTIC_EV_TONE_UNTRACKED, i);
+            continue;
+        }
+        HAPTIC_TRACE3 (HAPTIC_EV_TONE, i, frequencyHz, tone->voltageMv);
         if (DRV2605_PlayFreqVoltage (tone->frequencyHz, tone->voltageMv) != READY) {
-            printf ("Freq/Voltage drive failed\r\n");
+            HAPTIC_TRACE0 (HAPTIC_EV_FREQ_FAIL);
         }
         Delay_Ms (200);
     }
 }
 
 static void Demo_ContinuousPulses(void) {
-    printf ("\r\n[Demo] Continuous pulses\r\n");
+    DRV2605_ContinuousConfig tuned;
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_CONT);
 
-    if (DRV2605_ConfigureContinuous (&continuousConfig) != READY) {
-        printf ("Continuous config failed\r\n");
+#if HAPTIC_USE_TUNE
+    /* 驱动周期与强度取调校值，shell 修改后下一轮即生效 */
+    HapticTune_Continuous (&continuousConfig, &tuned);
+#else
+    tuned = continuousConfig;
+#endif
+    if (DRV2605_ConfigureContinuous (&tuned) != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_CONT_CONFIG_FAIL);
         return;
     }
 
     for (u8 pulse = 0; pulse < CONT_PULSE_COUNT; pulse++) {
         if (DRV2605_StartContinuous() != READY) {
-            printf ("Start continuous failed\r\n");
+            HAPTIC_TRACE0 (HAPTIC_EV_CONT_START_FAIL);
             return;
         }
-        Delay_Ms (CONT_ON_TIME_MS);
+        /* 闭环持续驱动期间跟踪共振 */
+        for (u16 t = 0; t < CONT_ON_TIME_MS; t += CONT_TRACK_STEP_MS) {
+            Delay_Ms (CONT_TRACK_STEP_MS);
+#if HAPTIC_USE_SUPPLY
+            HapticResonance_Poll();
+            HapticVbat_Poll();
+#endif
+        }
+        HapticThermal_AccountDrive (&actuatorThermal, tuned.strength, CONT_ON_TIME_MS);
         if (DRV2605_StopContinuous() != READY) {
-            printf ("Stop continuous failed\r\n");
+            HAPTIC_TRACE0 (HAPTIC_EV_CONT_STOP_FAIL);
             return;
         }
         Delay_Ms (CONT_OFF_TIME_MS);
     }
+#if HAPTIC_USE_SUPPLY
+    HAPTIC_TRACE4 (HAPTIC_EV_RESONANCE, HapticResonance_Hz(), HapticResonance_GetStats()->lastRaw,
+            HapticResonance_GetStats()->samples, HapticResonance_GetStats()->rejected);
+    HAPTIC_TRACE3 (HAPTIC_EV_VBAT, HapticVbat_Millivolts(), HapticVbat_GetLevel(),
+            DRV2605_GetSupplyGain());
+#endif
 }
 
 static void Demo_RomWaveforms(void) {
-    printf ("\r\n[Demo] ROM sequence playback\r\n");
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_ROM);
+
+    /* 反馈在启动时已由 DRV2605_InitDefaults 选为 LRA，这里只需预写序列后直接切换 */
+    for (u8 idx = 0; idx < ROM_EFFECT_COUNT; idx++) {
+        if (DRV2605_StageRomSequence (DRV2605_LIBRARY_LRA, &romEffects[idx], 1) != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_STAGE_FAIL);
+            return;
+        }
+        if (DRV2605_CommitRomTransition() != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_START_FAIL);
+            return;
+        }
+        /* ROM 效果无法逐样本降额，只按元数据计入预算 */
+        HapticThermal_Update (&actuatorThermal);
+        HapticThermal_AccountRom (&actuatorThermal, romEffects[idx]);
+        Delay_Ms (600);
+        if (DRV2605_Stop() != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_STOP_FAIL);
+            return;
+        }
+        Delay_Ms (300);
+    }
+    HapticThermal_Update (&actuatorThermal);
+    HAPTIC_TRACE1 (HAPTIC_EV_THERMAL_HEADROOM, HapticThermal_Headroom (&actuatorThermal));
+}
+#endif
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_POWER
+
+static void Demo_Thermal(void) {
+    static HapticSynth synth;
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_THERMAL);
+
+    /* 连续满幅长脉冲：前段全幅过驱，预算过半后逐块降额 */
+    for (u8 burst = 0; burst < THERMAL_BURST_COUNT; burst++) {
+        HapticSynth_Start (&synth, &thermalBurst);
+        if (HapticRtp_Play (HapticSynth_Source, &synth) != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_BURST_FAIL);
+            return;
+        }
+        HapticThermal_Update (&actuatorThermal);
+        HAPTIC_TRACE3 (HAPTIC_EV_BURST, burst, HapticThermal_Headroom (&actuatorThermal),
+                HapticThermal_Gain (&actuatorThermal));
+    }
+    DRV2605_Stop();
+
+    /* 静置散热 */
+    Delay_Ms (2000);
+    HapticThermal_Update (&actuatorThermal);
+    HAPTIC_TRACE2 (HAPTIC_EV_AFTER_REST, HapticThermal_Headroom (&actuatorThermal),
+            HapticThermal_Gain (&actuatorThermal));
+}
+
+#if HAPTIC_USE_KICK
+/* 方波点击的样本源：ctx 为剩余样本数（1kHz 下即毫秒），放完即结束 */
+static u16 Demo_ClickSource (void *ctx, u8 *samples, u16 count) {
+    u16 *remain = (u16 *)ctx;
+
+    if (count > *remain) {
+        count = *remain;
+    }
+    HapticSwar_Fill (samples, CLICK_LEVEL, count);
+    *remain = (u16)(*remain - count);
+    return count;
+}
+
+static void Demo_Kick(void) {
+    static HapticKick kick;
+    u16 remain;
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_KICK);
+
+    for (u8 pass = 0; pass < 2; pass++) {
+        if (pass == 0) {
+            HapticRtp_SetKick (NULL);
+        } else {
+            /* 按当前共振频率换算脉冲长度 */
+            HapticKick_Init (&kick, &clickKick);
+            HapticRtp_SetKick (&kick);
+            HAPTIC_TRACE2 (HAPTIC_EV_KICK_PULSES, kick.kickSamples, kick.brakeSamples);
+        }
+        HAPTIC_TRACE0 (pass ? HAPTIC_EV_KICK_SHAPED : HAPTIC_EV_KICK_PLAIN);
+        for (u8 i = 0; i < KICK_CLICK_COUNT; i++) {
+            remain = CLICK_MS;
+            if (HapticRtp_Play (Demo_ClickSource, &remain) != READY) {
+                HAPTIC_TRACE0 (HAPTIC_EV_CLICK_FAIL);
+                HapticRtp_SetKick (NULL);
+                return;
+            }
+            Delay_Ms (250);
+        }
+    }
+    HapticRtp_SetKick (NULL);
+    DRV2605_Stop();
+}
+#endif
 
-    if (DRV2605_SetMode (DRV2605_MODE_INT_TRIG) != READY) {
-        printf ("Set mode failed\r\n");
+static void Demo_Reminder (void) {
+    HAPTIC_TRACE2 (HAPTIC_EV_DEMO_REMINDER, REMINDER_COUNT, REMINDER_INTERVAL_MS);
+    HapticClock_Set (HAPTIC_CLOCK_8MHZ);
+    HAPTIC_TRACE1 (HAPTIC_EV_CLOCK, SystemCoreClock);
+
+    /* 每次提醒：Standby 等待 → 首次总线事务一次突发写恢复器件 → 播放 → 再次休眠 */
+    for (u8 n = 0; n < REMINDER_COUNT; n++) {
+        if (HapticPower_Standby (REMINDER_INTERVAL_MS) != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_STANDBY_FAIL);
+            break;
+        }
+        if (DRV2605_StageRomSequence (DRV2605_LIBRARY_LRA, &reminderEffect, 1) != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_STAGE_FAIL);
+            break;
+        }
+        if (DRV2605_CommitRomTransition() != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_START_FAIL);
+            break;
+        }
+        HapticPower_NoteOnset();
+        HapticThermal_AccountRom (&actuatorThermal, reminderEffect);
+        Delay_Ms (300);
+        DRV2605_Stop();
+    }
+    HapticClock_Set (HAPTIC_CLOCK_48MHZ);
+
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_WAKE_ONSET, HapticPower_GetOnsetLatency());
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_WAKE_OFF, HapticPower_GetWakeLatency (HAPTIC_POWER_OFF));
+    HAPTIC_TRACE3 (HAPTIC_EV_POWER_CURRENT, HapticPower_GetStats()->deepMs, HapticPower_GetStats()->deepWakes,
+            HapticPower_EstimateCurrentUa (&currentModel));
+}
+#endif
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_RENDER
+
+static void Demo_Synth(void) {
+    static HapticSynth synth;
+    HapticInstr_Probe probe;
+    HapticRtp_Block block;
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_SYNTH);
+
+    /* 逐块计时，统计每块 HAPTIC_RTP_BLOCK 个样本的合成开销 */
+    HapticInstr_ProbeReset (&probe);
+    HapticSynth_Start (&synth, &synthChirp);
+    for (u8 i = 0; i < SYNTH_BENCH_BLOCKS; i++) {
+        u32 start = HapticInstr_Cycles();
+        HapticSynth_Render (&synth, block.samples, HAPTIC_RTP_BLOCK);
+        HapticInstr_ProbeAdd (&probe, HapticInstr_Cycles() - start);
+    }
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_SYNTH, &probe);
+
+    HapticRtp_ResetStats();
+    HapticSynth_Start (&synth, &synthChirp);
+    if (HapticRtp_Play (HapticSynth_Source, &synth) != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_SYNTH_FAIL);
         return;
     }
-    Delay_Ms (5);
-    if (DRV2605_SelectLRA() != READY) {
-        printf ("Select LRA failed\r\n");
+    HAPTIC_TRACE3 (HAPTIC_EV_RTP_STATS, HapticRtp_GetStats()->samples,
+            HapticRtp_GetStats()->late, HapticRtp_GetStats()->errors);
+    DRV2605_Stop();
+}
+
+static void Demo_Keyframes(void) {
+    static HapticKeyframePlayer player;
+    const HapticKeyframePattern *patterns[] = { &breatheLinear, &breatheCubic };
+    const u8 probeEvents[] = { HAPTIC_EV_PROBE_KF_LINEAR, HAPTIC_EV_PROBE_KF_CUBIC };
+    HapticInstr_Probe probe;
+    HapticRtp_Block block;
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_KEYFRAME);
+
+    for (u8 i = 0; i < sizeof(patterns) / sizeof(patterns[0]); i++) {
+        /* 整个图案逐块计时，最大值包含换段时的系数计算 */
+        HapticInstr_ProbeReset (&probe);
+        HapticKeyframe_Start (&player, patterns[i]);
+        for (;;) {
+            u32 start = HapticInstr_Cycles();
+            u16 produced = HapticKeyframe_Render (&player, block.samples, HAPTIC_RTP_BLOCK);
+            if (produced == 0) {
+                break;
+            }
+            HapticInstr_ProbeAdd (&probe, HapticInstr_Cycles() - start);
+        }
+        HapticInstr_ProbeTrace (probeEvents[i], &probe);
+
+        HapticKeyframe_Start (&player, patterns[i]);
+        if (HapticRtp_Play (HapticKeyframe_Source, &player) != READY) {
+            HAPTIC_TRACE0 (HAPTIC_EV_KEYFRAME_FAIL);
+            return;
+        }
+        Delay_Ms (200);
+    }
+    DRV2605_Stop();
+}
+
+static void Demo_Mixer(void) {
+    static HapticSynth voices[HAPTIC_MIXER_VOICES];
+    HapticInstr_Probe probe;
+    HapticRtp_Block block;
+    u32 budget = HapticInstr_CyclesPerUs() * 1000000UL / HAPTIC_RTP_SAMPLE_HZ;
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_MIXER);
+
+    /* 1~N 个合成声部的每样本开销（含样本源），对照 1kHz 的周期预算 */
+    for (u8 n = 1; n <= HAPTIC_MIXER_VOICES; n++) {
+        HapticMixer_Init();
+        for (u8 v = 0; v < n; v++) {
+            HapticSynth_Start (&voices[v], &mixNotify);
+            HapticMixer_Add (HapticSynth_Source, &voices[v], HAPTIC_MIXER_UNITY, v, 0);
+        }
+        HapticInstr_ProbeReset (&probe);
+        for (u8 i = 0; i < MIX_BENCH_BLOCKS; i++) {
+            u32 start = HapticInstr_Cycles();
+            HapticMixer_Render (block.samples, HAPTIC_RTP_BLOCK);
+            HapticInstr_ProbeAdd (&probe, HapticInstr_Cycles() - start);
+        }
+        HAPTIC_TRACE3 (HAPTIC_EV_MIXER_COST, n, probe.total / probe.count / HAPTIC_RTP_BLOCK, budget);
+    }
+
+    /* 纹理播放中到达高优先级通知：纹理被闪避，通知结束后恢复 */
+    HapticMixer_Init();
+    HapticSynth_Start (&voices[0], &mixTexture);
+    HapticSynth_Start (&voices[1], &mixNotify);
+    HapticMixer_Add (HapticSynth_Source, &voices[0], HAPTIC_MIXER_UNITY, 0, 0);
+    HapticMixer_Add (HapticSynth_Source, &voices[1], HAPTIC_MIXER_UNITY, 1,
+                     MIX_NOTIFY_DELAY_MS * HAPTIC_RTP_SAMPLE_HZ / 1000);
+    if (HapticRtp_Play (HapticMixer_Source, NULL) != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_MIXER_FAIL);
         return;
     }
-    if (DRV2605_SetLibrary (DRV2605_LIBRARY_LRA) != READY) {
-        printf ("Set library failed\r\n");
+    HAPTIC_TRACE2 (HAPTIC_EV_MIXER_STATS, HapticMixer_GetStats()->blocks,
+            HapticMixer_GetStats()->clipped);
+    DRV2605_Stop();
+}
+
+#if HAPTIC_USE_PROBE
+/* 逐样本标量参考实现，仅用于与 SWAR 核对比 */
+static void Scalar_Gain(u8 *samples, u16 count, u8 gain) {
+    for (u16 i = 0; i < count; i++) {
+        u16 v = (u16)((samples[i] * gain) >> 7);
+        samples[i] = (u8)((v > 0x7F) ? 0x7F : v);
+    }
+}
+
+static void Scalar_SatAdd(u8 *dst, const u8 *src, u16 count) {
+    for (u16 i = 0; i < count; i++) {
+        u16 v = (u16)(dst[i] + src[i]);
+        dst[i] = (u8)((v > 0x7F) ? 0x7F : v);
+    }
+}
+
+static void Scalar_Clamp7(u8 *samples, u16 count) {
+    for (u16 i = 0; i < count; i++) {
+        if (samples[i] > 0x7F) {
+            samples[i] = 0x7F;
+        }
+    }
+}
+
+static u32 Scalar_ChangedMask(const u8 *samples, u16 count, u8 previous, u8 threshold) {
+    u32 mask = 0;
+    for (u16 i = 0; i < count; i++) {
+        u8 d = (u8)((samples[i] > previous) ? samples[i] - previous : previous - samples[i]);
+        if (d > threshold) {
+            mask |= 1UL << i;
+        }
+        previous = samples[i];
+    }
+    return mask;
+}
+
+/* 基准数据放在静态区，两组核经同形的适配函数交给同一个计时循环 */
+static HapticRtp_Block swarA;
+static HapticRtp_Block swarB;
+static volatile u32 swarSink;
+
+static void Bench_GainScalar(void)   { Scalar_Gain (swarA.samples, HAPTIC_RTP_BLOCK, 100); }
+static void Bench_GainSwar(void)     { HapticSwar_Gain (swarA.samples, HAPTIC_RTP_BLOCK, 100); }
+static void Bench_SatAddScalar(void) { Scalar_SatAdd (swarA.samples, swarB.samples, HAPTIC_RTP_BLOCK); }
+static void Bench_SatAddSwar(void)   { swarSink += HapticSwar_SatAdd (swarA.samples, swarB.samples, HAPTIC_RTP_BLOCK); }
+static void Bench_ClampScalar(void)  { Scalar_Clamp7 (swarB.samples, HAPTIC_RTP_BLOCK); }
+static void Bench_ClampSwar(void)    { HapticSwar_Clamp7 (swarB.samples, HAPTIC_RTP_BLOCK); }
+static void Bench_DeltaScalar(void)  { swarSink += Scalar_ChangedMask (swarB.samples, HAPTIC_RTP_BLOCK, 0x20, 2); }
+static void Bench_DeltaSwar(void)    { swarSink += HapticSwar_ChangedMask (swarB.samples, HAPTIC_RTP_BLOCK, 0x20, 2); }
+
+/* 同一轮内先标量后 SWAR，两者的 TIM2 周期数分别累计后取平均 */
+static void Swar_Bench(u8 event, void (*scalarRun)(void), void (*swarRun)(void)) {
+    HapticInstr_Probe scalar;
+    HapticInstr_Probe swar;
+
+    HapticInstr_ProbeReset (&scalar);
+    HapticInstr_ProbeReset (&swar);
+    for (u8 r = 0; r < SWAR_BENCH_ROUNDS; r++) {
+        u32 t0 = HapticInstr_Cycles();
+        scalarRun();
+        u32 t1 = HapticInstr_Cycles();
+        swarRun();
+        u32 t2 = HapticInstr_Cycles();
+        HapticInstr_ProbeAdd (&scalar, t1 - t0);
+        HapticInstr_ProbeAdd (&swar, t2 - t1);
+    }
+    HAPTIC_TRACE2 (event, scalar.total / scalar.count, swar.total / swar.count);
+}
+
+static void Demo_Swar(void) {
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_SWAR);
+
+    for (u8 i = 0; i < HAPTIC_RTP_BLOCK; i++) {
+        swarA.samples[i] = (u8)((i * 37) & 0x7F);
+        swarB.samples[i] = (u8)((i * 11 + 5) & 0x7F);
+    }
+
+    Swar_Bench (HAPTIC_EV_SWAR_GAIN, Bench_GainScalar, Bench_GainSwar);
+    Swar_Bench (HAPTIC_EV_SWAR_SATADD, Bench_SatAddScalar, Bench_SatAddSwar);
+    Swar_Bench (HAPTIC_EV_SWAR_CLAMP, Bench_ClampScalar, Bench_ClampSwar);
+    Swar_Bench (HAPTIC_EV_SWAR_DELTA, Bench_DeltaScalar, Bench_DeltaSwar);
+}
+#endif
+
+static void Demo_Dither(void) {
+    static HapticKeyframePlayer player;
+    static HapticDither_Stage stage;
+    HapticInstr_Probe probe;
+    HapticRtp_Block block;
+    u16 levels[HAPTIC_RTP_BLOCK];
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_DITHER);
+
+    /* 量化开销：每块 HAPTIC_RTP_BLOCK 个样本 */
+    HapticInstr_ProbeReset (&probe);
+    HapticKeyframe_Start (&player, &faintRamp);
+    HapticDither_Init (&stage.dither);
+    while (HapticKeyframe_RenderWide (&player, levels, HAPTIC_RTP_BLOCK) == HAPTIC_RTP_BLOCK) {
+        u32 start = HapticInstr_Cycles();
+        HapticDither_Block (&stage.dither, levels, block.samples, HAPTIC_RTP_BLOCK);
+        HapticInstr_ProbeAdd (&probe, HapticInstr_Cycles() - start);
+    }
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_DITHER, &probe);
+
+    /* 同一斜坡先取整播放，再抖动播放 */
+    HAPTIC_TRACE0 (HAPTIC_EV_RAMP_ROUNDED);
+    HapticKeyframe_Start (&player, &faintRamp);
+    if (HapticRtp_Play (HapticKeyframe_Source, &player) != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_RAMP_FAIL);
         return;
     }
+    Delay_Ms (300);
 
-    for (u8 idx = 0; idx < ROM_EFFECT_COUNT; idx++) {
-        if (DRV2605_SetWaveform (0, romEffects[idx]) != READY) {
-            printf ("Set waveform failed\r\n");
-            return;
+    HAPTIC_TRACE0 (HAPTIC_EV_RAMP_DITHERED);
+    HapticKeyframe_Start (&player, &faintRamp);
+    HapticDither_StageInit (&stage, HapticKeyframe_WideSource, &player);
+    if (HapticRtp_Play (HapticDither_Source, &stage) != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_RAMP_FAIL);
+        return;
+    }
+    DRV2605_Stop();
+}
+#endif
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_HOST
+
+#if HAPTIC_USE_HOST
+static void Demo_HostLink(void) {
+    u32 cyclesPerMs = HapticInstr_CyclesPerUs() * 1000UL;
+    u32 idleStart = HapticInstr_Cycles();
+    u32 windowStart = idleStart;
+    u32 bytesStart = HapticLink_GetStats()->bytes;
+    u32 elapsedMs;
+
+    HAPTIC_TRACE1 (HAPTIC_EV_DEMO_HOST, HOST_LINK_WINDOW_MS);
+
+    /* 等待窗口内只有链路解析与 I2C 事务，降到 24MHz（8MHz 下串口误差偏大） */
+    HapticClock_Set (HAPTIC_CLOCK_24MHZ);
+    HAPTIC_TRACE1 (HAPTIC_EV_CLOCK, SystemCoreClock);
+
+    while ((HapticInstr_Cycles() - idleStart) / cyclesPerMs < HOST_LINK_WINDOW_MS) {
+        if (HapticHost_Poll() != 0) {
+            idleStart = HapticInstr_Cycles();
+        } else {
+            HapticPower_Idle();
         }
-        if (DRV2605_ClearWaveforms() != READY) {
-            printf ("Clear waveform failed\r\n");
+    }
+
+    HapticClock_Set (HAPTIC_CLOCK_48MHZ);
+    elapsedMs = (HapticInstr_Cycles() - windowStart) / cyclesPerMs;
+    HAPTIC_TRACE4 (HAPTIC_EV_LINK_STATS, HapticLink_GetStats()->frames,
+            HapticLink_GetStats()->crcErrors, HapticLink_GetStats()->overruns,
+            (HapticLink_GetStats()->bytes - bytesStart) * 1000UL / elapsedMs);
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_HOST_PARSE, HapticHost_GetParseCost());
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_HOST_GO, HapticHost_GetLatency());
+    HAPTIC_TRACE2 (HAPTIC_EV_STREAM_STATS, HapticHost_GetUnderruns(), HapticRtp_GetStats()->late);
+    HAPTIC_TRACE4 (HAPTIC_EV_LOG_STATS, HapticLog_GetStats()->bytes, HapticLog_GetStats()->dropped,
+            HapticLog_GetStats()->highWater, HAPTIC_LOG_RING);
+    /* 唤醒延迟在下一轮第一次访问器件时记录，这里报告的是截至上一轮的累计 */
+    HAPTIC_TRACE4 (HAPTIC_EV_POWER_STATS, HapticPower_GetStats()->residencyMs[HAPTIC_POWER_ACTIVE],
+            HapticPower_GetStats()->residencyMs[HAPTIC_POWER_STANDBY],
+            HapticPower_GetStats()->residencyMs[HAPTIC_POWER_OFF], HapticPower_GetStats()->sleeps);
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_WAKE_STANDBY, HapticPower_GetWakeLatency (HAPTIC_POWER_STANDBY));
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_WAKE_OFF, HapticPower_GetWakeLatency (HAPTIC_POWER_OFF));
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_CLOCK_SWITCH, HapticClock_GetSwitchCost());
+}
+#endif
+#endif
+
+#if HAPTIC_DEMO == HAPTIC_DEMO_INPUT
+
+static ErrorStatus Demo_PlayPattern (u8 index, const HapticPattern *pattern) {
+    static HapticPatternDecoder decoder;
+
+    HAPTIC_TRACE2 (HAPTIC_EV_PATTERN, index, pattern->size);
+    HapticPattern_Start (&decoder, pattern);
+    if (HapticRtp_Play (HapticPattern_Source, &decoder) != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_PATTERN_FAIL);
+        return NoREADY;
+    }
+    Delay_Ms (200);
+    return READY;
+}
+
+static void Demo_Patterns(void) {
+    const HapticPattern *patterns[] = { &heartbeatPattern, &swellPattern };
+    const u8 builtin = sizeof(patterns) / sizeof(patterns[0]);
+#if HAPTIC_USE_BANK
+    HapticPattern banked;
+#endif
+
+    HAPTIC_TRACE0 (HAPTIC_EV_DEMO_PATTERN);
+
+    HapticRtp_ResetStats();
+    for (u8 i = 0; i < builtin; i++) {
+        if (Demo_PlayPattern (i, patterns[i]) != READY) {
             return;
         }
-        if (DRV2605_Start() != READY) {
-            printf ("Start playback failed\r\n");
+    }
+#if HAPTIC_USE_BANK
+    /* 经主机链路更新的图案库，编号接在内置图案之后 */
+    for (u8 i = 0; i < HapticBank_GetInfo()->count; i++) {
+        if (HapticBank_Get (i, &banked) != READY || Demo_PlayPattern ((u8)(builtin + i), &banked) != READY) {
             return;
         }
-        Delay_Ms (600);
-        if (DRV2605_Stop() != READY) {
-            printf ("Stop playback failed\r\n");
-            return;
+    }
+#endif
+    /* 保持段不重复写 RTPIN：统计省下的 I2C 写与字节 */
+    HAPTIC_TRACE4 (HAPTIC_EV_RTP_SAVED, HapticRtp_GetStats()->samples,
+            HapticRtp_GetStats()->suppressed, HapticRtp_GetStats()->refreshes,
+            HapticRtp_GetStats()->busBytesSaved);
+    DRV2605_Stop();
+}
+
+#if HAPTIC_USE_BUTTON
+static void Demo_Buttons (void) {
+    u32 cyclesPerMs = HapticInstr_CyclesPerUs() * 1000UL;
+    u32 start;
+
+    HAPTIC_TRACE1 (HAPTIC_EV_DEMO_BUTTONS, BUTTON_WINDOW_MS);
+    if (HapticButton_Arm() != READY) {
+        HAPTIC_TRACE0 (HAPTIC_EV_STAGE_FAIL);
+    }
+
+    /* ROM 效果在中断里直接触发；主循环只处理转交项，其余时间 WFI */
+    start = HapticInstr_Cycles();
+    while ((HapticInstr_Cycles() - start) / cyclesPerMs < BUTTON_WINDOW_MS) {
+        if (HapticButton_Poll() == 0) {
+            HapticPower_Idle();
         }
-        Delay_Ms (300);
     }
-}
\ No newline at end of file
+
+    HAPTIC_TRACE4 (HAPTIC_EV_BUTTON_STATS, HapticButton_GetStats()->fast, HapticButton_GetStats()->deferred,
+            HapticButton_GetStats()->bounced, HapticButton_GetStats()->dropped);
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_BUTTON_FAST, HapticButton_GetFastLatency());
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_BUTTON_DEFER, HapticButton_GetDeferredLatency());
+}
+#endif
+
+#if HAPTIC_USE_SENSOR
+static void Demo_Sensor (void) {
+    u32 cyclesPerMs = HapticInstr_CyclesPerUs() * 1000UL;
+    u32 start;
+
+    HapticSensor_Cmd (ENABLE);
+    Delay_Ms (1);
+    HAPTIC_TRACE2 (HAPTIC_EV_DEMO_SENSOR, SENSOR_WINDOW_MS, HapticSensor_Read());
+
+    /* 直接 WFI 而不经 HapticPower_Idle，器件保持就绪，看门狗中断可立即 GO */
+    start = HapticInstr_Cycles();
+    while ((HapticInstr_Cycles() - start) / cyclesPerMs < SENSOR_WINDOW_MS) {
+        if (HapticSensor_Poll() == 0) {
+            __WFI();
+        }
+    }
+    HapticSensor_Cmd (DISABLE);
+
+    HAPTIC_TRACE4 (HAPTIC_EV_SENSOR_STATS, HapticSensor_GetStats()->presses, HapticSensor_GetStats()->releases,
+            HapticSensor_GetStats()->fast, HapticSensor_GetStats()->deferred);
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_SENSOR_FAST, HapticSensor_GetFastLatency());
+    HapticInstr_ProbeTrace (HAPTIC_EV_PROBE_SENSOR_DEFER, HapticSensor_GetDeferredLatency());
+}
+#endif
+#endif
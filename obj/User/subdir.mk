@@ -7,18 +7,93 @@
 C_SRCS += \
 ../User/ch32v00x_it.c \
 ../User/drv2605.c \
+../User/drv2605_profile.c \
+../User/drv2605_script.c \
+../User/haptic_bank.c \
+../User/haptic_button.c \
+../User/haptic_clock.c \
+../User/haptic_dither.c \
+../User/haptic_host.c \
+../User/haptic_instr.c \
+../User/haptic_keyframe.c \
+../User/haptic_kick.c \
+../User/haptic_link.c \
+../User/haptic_log.c \
+../User/haptic_mixer.c \
+../User/haptic_pattern.c \
+../User/haptic_patterns.c \
+../User/haptic_power.c \
+../User/haptic_resonance.c \
+../User/haptic_rtp.c \
+../User/haptic_sensor.c \
+../User/haptic_swar.c \
+../User/haptic_synth.c \
+../User/haptic_thermal.c \
+../User/haptic_trace.c \
+../User/haptic_tune.c \
+../User/haptic_vbat.c \
 ../User/main.c \
 ../User/system_ch32v00x.c 
 
 C_DEPS += \
 ./User/ch32v00x_it.d \
 ./User/drv2605.d \
+./User/drv2605_profile.d \
+./User/drv2605_script.d \
+./User/haptic_bank.d \
+./User/haptic_button.d \
+./User/haptic_clock.d \
+./User/haptic_dither.d \
+./User/haptic_host.d \
+./User/haptic_instr.d \
+./User/haptic_keyframe.d \
+./User/haptic_kick.d \
+./User/haptic_link.d \
+./User/haptic_log.d \
+./User/haptic_mixer.d \
+./User/haptic_pattern.d \
+./User/haptic_patterns.d \
+./User/haptic_power.d \
+./User/haptic_resonance.d \
+./User/haptic_rtp.d \
+./User/haptic_sensor.d \
+./User/haptic_swar.d \
+./User/haptic_synth.d \
+./User/haptic_thermal.d \
+./User/haptic_trace.d \
+./User/haptic_tune.d \
+./User/haptic_vbat.d \
 ./User/main.d \
 ./User/system_ch32v00x.d 
 
 OBJS += \
 ./User/ch32v00x_it.o \
 ./User/drv2605.o \
+./User/drv2605_profile.o \
+./User/drv2605_script.o \
+./User/haptic_bank.o \
+./User/haptic_button.o \
+./User/haptic_clock.o \
+./User/haptic_dither.o \
+./User/haptic_host.o \
+./User/haptic_instr.o \
+./User/haptic_keyframe.o \
+./User/haptic_kick.o \
+./User/haptic_link.o \
+./User/haptic_log.o \
+./User/haptic_mixer.o \
+./User/haptic_pattern.o \
+./User/haptic_patterns.o \
+./User/haptic_power.o \
+./User/haptic_resonance.o \
+./User/haptic_rtp.o \
+./User/haptic_sensor.o \
+./User/haptic_swar.o \
+./User/haptic_synth.o \
+./User/haptic_thermal.o \
+./User/haptic_trace.o \
+./User/haptic_tune.o \
+./User/haptic_vbat.o \
 ./User/main.o \
 ./User/system_ch32v00x.o 
 